@@ -0,0 +1,96 @@
+#include <adcDecimator.h>
+
+AdcDecimator::AdcDecimator(uint16_t oversamplingFactor) {
+    this->oversamplingFactor = oversamplingFactor > 0 ? oversamplingFactor : 1;
+    this->channelsCount = 0;
+
+    memset(this->sums, 0, sizeof(this->sums));
+    memset(this->samplesCounts, 0, sizeof(this->samplesCounts));
+    memset(this->outputs, 0, sizeof(this->outputs));
+    memset(this->outputsCounts, 0, sizeof(this->outputsCounts));
+}
+
+int8_t AdcDecimator::addChannel(uint8_t adcChannel) {
+    int8_t index = this->findChannel(adcChannel);
+
+    if (index >= 0) {
+        return index;
+    }
+
+    if (this->channelsCount >= ADC_DECIMATOR_MAX_CHANNELS) {
+        return -1;
+    }
+
+    this->adcChannels[this->channelsCount] = adcChannel;
+    this->channelsCount++;
+
+    return this->channelsCount - 1;
+}
+
+int8_t AdcDecimator::findChannel(uint8_t adcChannel) {
+    for (uint8_t i = 0; i < this->channelsCount; i++) {
+        if (this->adcChannels[i] == adcChannel) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+uint8_t AdcDecimator::getChannelsCount() {
+    return this->channelsCount;
+}
+
+uint8_t AdcDecimator::getAdcChannel(uint8_t index) {
+    return this->adcChannels[index];
+}
+
+void AdcDecimator::addSample(uint8_t adcChannel, uint16_t rawValue) {
+    int8_t index = this->findChannel(adcChannel);
+
+    if (index < 0) {
+        return;
+    }
+
+    this->sums[index] += rawValue;
+    this->samplesCounts[index]++;
+
+    if (this->samplesCounts[index] >= this->oversamplingFactor) {
+        // Rounded mean
+        this->outputs[index] = (this->sums[index] + this->oversamplingFactor / 2) / this->oversamplingFactor;
+        this->outputsCounts[index]++;
+
+        this->sums[index] = 0;
+        this->samplesCounts[index] = 0;
+    }
+}
+
+void AdcDecimator::addFrame(const uint8_t* buffer, uint32_t length) {
+    for (uint32_t i = 0; i + 1 < length; i += 2) {
+        uint16_t word = buffer[i] | (buffer[i + 1] << 8);
+
+        this->addSample((word >> 12) & 0x0F, word & 0x0FFF);
+    }
+}
+
+uint16_t AdcDecimator::getOutput(uint8_t index) {
+    return this->outputs[index];
+}
+
+uint32_t AdcDecimator::getOutputsCount(uint8_t index) {
+    return this->outputsCounts[index];
+}
+
+int8_t getAdc1Channel(byte gpio) {
+    switch (gpio) {
+        case 36: return 0;
+        case 37: return 1;
+        case 38: return 2;
+        case 39: return 3;
+        case 32: return 4;
+        case 33: return 5;
+        case 34: return 6;
+        case 35: return 7;
+        default: return -1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef ADC_DECIMATOR_H
+#define ADC_DECIMATOR_H
+
+#include <Arduino.h>
+
+const uint8_t ADC_DECIMATOR_MAX_CHANNELS = 8;
+const uint16_t ADC_RAW_MAX_VALUE = 4095; // 12-bit
+
+/**
+ * Averages every oversamplingFactor samples of each channel into one output (boxcar decimation)
+ * Input are DMA frames in ESP32 TYPE1 format (16-bit words, 12-bit data + 4-bit channel)
+ * No hardware access
+ */
+class AdcDecimator {
+    private:
+        uint16_t oversamplingFactor;
+        uint8_t adcChannels[ADC_DECIMATOR_MAX_CHANNELS];
+        uint8_t channelsCount;
+        uint32_t sums[ADC_DECIMATOR_MAX_CHANNELS];
+        uint16_t samplesCounts[ADC_DECIMATOR_MAX_CHANNELS];
+        uint16_t outputs[ADC_DECIMATOR_MAX_CHANNELS];
+        uint32_t outputsCounts[ADC_DECIMATOR_MAX_CHANNELS];
+
+    public:
+        AdcDecimator(uint16_t oversamplingFactor);
+        int8_t addChannel(uint8_t adcChannel); // Returns index, -1 when full
+        int8_t findChannel(uint8_t adcChannel);
+        uint8_t getChannelsCount();
+        uint8_t getAdcChannel(uint8_t index);
+
+        void addSample(uint8_t adcChannel, uint16_t rawValue);
+        void addFrame(const uint8_t* buffer, uint32_t length);
+
+        uint16_t getOutput(uint8_t index);
+        uint32_t getOutputsCount(uint8_t index); // 0 - nothing decimated yet
+};
+
+int8_t getAdc1Channel(byte gpio); // -1 for pins without ADC1
+
+#endif
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include <adcSampler.h>
+#include <driver/adc.h>
+
+AdcSampler::AdcSampler(): decimator(ADC_SAMPLER_OVERSAMPLING_FACTOR) {
+    this->isRunning = false;
+    this->taskHandle = nullptr;
+
+    for (uint8_t i = 0; i < ADC_DECIMATOR_MAX_CHANNELS; i++) {
+        this->values[i] = 0;
+        this->hasValue[i] = false;
+        this->gpios[i] = 0;
+    }
+}
+
+bool AdcSampler::addPin(byte gpio) {
+    int8_t adcChannel = getAdc1Channel(gpio);
+
+    if (adcChannel < 0) {
+        Serial.print("Pin is not ADC1 channel: ");
+        Serial.println(gpio);
+        return false;
+    }
+
+    int8_t index = this->decimator.addChannel(adcChannel);
+
+    if (index < 0) {
+        return false;
+    }
+
+    this->gpios[index] = gpio;
+
+    return true;
+}
+
+void AdcSampler::initialize(uint32_t stackSize) {
+    this->seedValues();
+
+    if (!this->startConversions()) {
+        Serial.println("ADC DMA not started, falling back to analogRead");
+        return;
+    }
+
+    this->isRunning = true;
+
+    xTaskCreate(AdcSampler::taskFunction, "AdcSamplerTask", stackSize, this, 1, &this->taskHandle);
+}
+
+/**
+ * First decimated output comes after whole oversampling window
+ */
+void AdcSampler::seedValues() {
+    for (uint8_t i = 0; i < this->decimator.getChannelsCount(); i++) {
+        this->values[i].store(analogRead(this->gpios[i]), std::memory_order_relaxed);
+        this->hasValue[i].store(true, std::memory_order_release);
+    }
+}
+
+bool AdcSampler::startConversions() {
+    uint8_t channelsCount = this->decimator.getChannelsCount();
+    uint32_t channelsMask = 0;
+    adc_digi_pattern_config_t patterns[ADC_DECIMATOR_MAX_CHANNELS];
+
+    if (channelsCount == 0) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < channelsCount; i++) {
+        uint8_t adcChannel = this->decimator.getAdcChannel(i);
+
+        channelsMask |= 1 << adcChannel;
+
+        // Same attenuation as analogRead
+        patterns[i].atten = ADC_ATTEN_DB_11;
+        patterns[i].channel = adcChannel;
+        patterns[i].unit = 0; // ADC1
+        patterns[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_digi_init_config_t initConfig = {
+        max_store_buf_size: ADC_SAMPLER_FRAME_BYTES * 2,
+        conv_num_each_intr: ADC_SAMPLER_FRAME_BYTES,
+        adc1_chan_mask: channelsMask,
+        adc2_chan_mask: 0
+    };
+
+    if (adc_digi_initialize(&initConfig) != ESP_OK) {
+        return false;
+    }
+
+    adc_digi_configuration_t configuration = {
+        conv_limit_en: true, // Required on ESP32
+        conv_limit_num: 250,
+        pattern_num: channelsCount,
+        adc_pattern: patterns,
+        sample_freq_hz: ADC_SAMPLER_SAMPLE_FREQUENCY_HZ,
+        conv_mode: ADC_CONV_SINGLE_UNIT_1,
+        format: ADC_DIGI_OUTPUT_FORMAT_TYPE1
+    };
+
+    if (adc_digi_controller_configure(&configuration) != ESP_OK || adc_digi_start() != ESP_OK) {
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    return true;
+}
+
+void AdcSampler::taskFunction(void* param) {
+    static_cast<AdcSampler*>(param)->run();
+}
+
+void AdcSampler::run() {
+    uint32_t length = 0;
+
+    while (true) {
+        // Blocks until DMA fills a frame
+        esp_err_t result = adc_digi_read_bytes(this->frame, ADC_SAMPLER_FRAME_BYTES, &length, ADC_MAX_DELAY);
+
+        // ESP_ERR_INVALID_STATE - task was late and driver dropped older data, returned frame is still valid
+        if (result != ESP_OK && result != ESP_ERR_INVALID_STATE) {
+            continue;
+        }
+
+        this->decimator.addFrame(this->frame, length);
+
+        for (uint8_t i = 0; i < this->decimator.getChannelsCount(); i++) {
+            if (this->decimator.getOutputsCount(i) > 0) {
+                this->values[i].store(this->decimator.getOutput(i), std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+/**
+ * DMA keeps clocks running, so conversions are stopped while the box sleeps
+ */
+void AdcSampler::suspend() {
+    if (this->taskHandle == nullptr || !this->isRunning) {
+        return;
+    }
+
+    this->isRunning = false;
+    adc_digi_stop();
+}
+
+void AdcSampler::resume() {
+    if (this->taskHandle == nullptr || this->isRunning) {
+        return;
+    }
+
+    if (adc_digi_start() != ESP_OK) {
+        Serial.println("ADC DMA not resumed, staying on analogRead");
+        return;
+    }
+
+    this->isRunning = true;
+}
+
+int8_t AdcSampler::findGpio(byte gpio) {
+    int8_t adcChannel = getAdc1Channel(gpio);
+
+    return adcChannel < 0 ? -1 : this->decimator.findChannel(adcChannel);
+}
+
+uint16_t AdcSampler::getValue(byte gpio) {
+    int8_t index = this->findGpio(gpio);
+
+    if (!this->isRunning || index < 0 || !this->hasValue[index].load(std::memory_order_acquire)) {
+        return analogRead(gpio);
+    }
+
+    return this->values[index].load(std::memory_order_relaxed);
+}
+
+TaskHandle_t AdcSampler::getTaskHandle() {
+    return this->taskHandle;
+}
\ No newline at end of file
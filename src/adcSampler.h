@@ -0,0 +1,47 @@
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <adcDecimator.h>
+
+const uint32_t ADC_SAMPLER_SAMPLE_FREQUENCY_HZ = 20000; // All channels together, lowest rate of ESP32 DMA (I2S) mode
+const uint16_t ADC_SAMPLER_OVERSAMPLING_FACTOR = 256; // Per channel, ~26 outputs per second for 3 channels
+const uint16_t ADC_SAMPLER_FRAME_BYTES = 1024; // Task wakes up once per frame (512 samples)
+
+/**
+ * Only user of ADC1, converts all registered pins continuously by DMA
+ * Task decimates frames and publishes latest value of each pin as single atomic word, readers never block
+ * When DMA cannot be started (or is suspended), values are read by analogRead instead
+ * Each pin is seeded by analogRead before DMA starts (DMA driver holds ADC1 while running), readers never see 0 before first output
+ */
+class AdcSampler {
+    private:
+        AdcDecimator decimator;
+        std::atomic<uint16_t> values[ADC_DECIMATOR_MAX_CHANNELS];
+        std::atomic<bool> hasValue[ADC_DECIMATOR_MAX_CHANNELS];
+        byte gpios[ADC_DECIMATOR_MAX_CHANNELS];
+        std::atomic<bool> isRunning;
+        TaskHandle_t taskHandle;
+        uint8_t frame[ADC_SAMPLER_FRAME_BYTES];
+
+        static void taskFunction(void* param);
+        void run();
+        bool startConversions();
+        void seedValues();
+        int8_t findGpio(byte gpio);
+
+    public:
+        AdcSampler();
+        bool addPin(byte gpio); // Before initialize
+        void initialize(uint32_t stackSize);
+        void suspend();
+        void resume();
+        uint16_t getValue(byte gpio); // 12-bit raw, oversampled
+        TaskHandle_t getTaskHandle();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <allocationTracker.h>
+
+/**
+ * ALLOCATION_TRACKING builds only
+ * ESP32: malloc family is wrapped by linker (-Wl,--wrap=malloc ...), see env:denky32_allocations
+ * Host (glibc): malloc family is interposed and forwarded to glibc internals
+ * new / delete are replaced on both, so call site is the code using new, not operator new itself
+ */
+#ifdef ALLOCATION_TRACKING
+
+#include <new>
+
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+
+extern "C" {
+    void* __real_malloc(size_t size);
+    void* __real_calloc(size_t count, size_t size);
+    void* __real_realloc(void* pointer, size_t size);
+    void __real_free(void* pointer);
+}
+
+#define untrackedMalloc __real_malloc
+#define untrackedCalloc __real_calloc
+#define untrackedRealloc __real_realloc
+#define untrackedFree __real_free
+
+static portMUX_TYPE allocationTrackerMux = portMUX_INITIALIZER_UNLOCKED;
+
+#define lockAllocationTracker() portENTER_CRITICAL(&allocationTrackerMux)
+#define unlockAllocationTracker() portEXIT_CRITICAL(&allocationTrackerMux)
+
+#elif defined(__GLIBC__)
+#include <pthread.h>
+
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void __libc_free(void* pointer);
+}
+
+#define untrackedMalloc __libc_malloc
+#define untrackedCalloc __libc_calloc
+#define untrackedRealloc __libc_realloc
+#define untrackedFree __libc_free
+
+static pthread_mutex_t allocationTrackerMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define lockAllocationTracker() pthread_mutex_lock(&allocationTrackerMutex)
+#define unlockAllocationTracker() pthread_mutex_unlock(&allocationTrackerMutex)
+
+#else
+#error "ALLOCATION_TRACKING needs ESP32 or glibc"
+#endif
+
+static void* trackedMalloc(size_t size, const void* callSite) {
+    void* pointer = untrackedMalloc(size);
+
+    lockAllocationTracker();
+    allocationTracker.recordAllocation(pointer, size, callSite);
+    unlockAllocationTracker();
+
+    return pointer;
+}
+
+static void trackedFree(void* pointer) {
+    lockAllocationTracker();
+    allocationTracker.recordFree(pointer);
+    unlockAllocationTracker();
+
+    untrackedFree(pointer);
+}
+
+#ifdef ESP_PLATFORM
+#define MALLOC_HOOK(name) __wrap_##name
+#else
+#define MALLOC_HOOK(name) name
+#endif
+
+extern "C" {
+    void* MALLOC_HOOK(malloc)(size_t size) {
+        return trackedMalloc(size, __builtin_return_address(0));
+    }
+
+    void* MALLOC_HOOK(calloc)(size_t count, size_t size) {
+        void* pointer = untrackedCalloc(count, size);
+
+        lockAllocationTracker();
+        allocationTracker.recordAllocation(pointer, count * size, __builtin_return_address(0));
+        unlockAllocationTracker();
+
+        return pointer;
+    }
+
+    void* MALLOC_HOOK(realloc)(void* oldPointer, size_t size) {
+        // Lock is held over realloc, freed block could be reused by other task before it is recorded
+        lockAllocationTracker();
+        void* newPointer = untrackedRealloc(oldPointer, size);
+        allocationTracker.recordReallocation(oldPointer, newPointer, size, __builtin_return_address(0));
+        unlockAllocationTracker();
+
+        return newPointer;
+    }
+
+    void MALLOC_HOOK(free)(void* pointer) {
+        trackedFree(pointer);
+    }
+}
+
+void* operator new(size_t size) {
+    void* pointer = trackedMalloc(size, __builtin_return_address(0));
+
+    if (pointer == nullptr) {
+        abort();
+    }
+
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = trackedMalloc(size, __builtin_return_address(0));
+
+    if (pointer == nullptr) {
+        abort();
+    }
+
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedMalloc(size, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedMalloc(size, __builtin_return_address(0));
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+AllocationTotals getAllocationTotals() {
+    lockAllocationTracker();
+    AllocationTotals totals = allocationTracker.getTotals();
+    unlockAllocationTracker();
+
+    return totals;
+}
+
+uint16_t getTopAllocationSites(AllocationSite* topSites, uint16_t maxCount) {
+    lockAllocationTracker();
+    uint16_t count = allocationTracker.getTopSites(topSites, maxCount);
+    unlockAllocationTracker();
+
+    return count;
+}
+
+void resetAllocationTracking() {
+    lockAllocationTracker();
+    allocationTracker.reset();
+    unlockAllocationTracker();
+}
+
+#else
+
+AllocationTotals getAllocationTotals() {
+    return AllocationTotals{};
+}
+
+uint16_t getTopAllocationSites(AllocationSite* topSites, uint16_t maxCount) {
+    return 0;
+}
+
+void resetAllocationTracking() {}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <allocationTracker.h>
+
+#ifdef ALLOCATION_TRACKING
+AllocationTracker allocationTracker;
+#endif
+
+uint32_t hashAddress(uintptr_t address) {
+    return (uint32_t) (address >> 2) * 2654435761u; // Allocations and return addresses are at least 4 bytes aligned
+}
+
+void AllocationTracker::reset() {
+    memset(this->sites, 0, sizeof(this->sites));
+    memset(this->liveAllocations, 0, sizeof(this->liveAllocations));
+    memset(&this->totals, 0, sizeof(this->totals));
+    this->sitesCount = 0;
+    this->liveAllocationsCount = 0;
+    this->hasOverflowSite = false;
+}
+
+bool isSiteEmpty(const AllocationSite& site) {
+    return site.callSite == 0 && site.allocationsCount == 0;
+}
+
+/**
+ * Open addressing, sites are never removed
+ * One slot always stays free for sites which do not fit
+ */
+uint16_t AllocationTracker::findSite(uintptr_t callSite) {
+    uint16_t slot = hashAddress(callSite) & (ALLOCATION_TRACKER_MAX_SITES - 1);
+
+    for (uint16_t i = 0; i < ALLOCATION_TRACKER_MAX_SITES; i++) {
+        if (isSiteEmpty(this->sites[slot])) {
+            if (this->sitesCount >= ALLOCATION_TRACKER_MAX_SITES - 1) {
+                break;
+            }
+
+            this->sites[slot].callSite = callSite;
+            this->sitesCount++;
+
+            return slot;
+        }
+
+        if (this->sites[slot].callSite == callSite && !(this->hasOverflowSite && slot == this->overflowSite)) {
+            return slot;
+        }
+
+        slot = (slot + 1) & (ALLOCATION_TRACKER_MAX_SITES - 1);
+    }
+
+    if (!this->hasOverflowSite) {
+        for (uint16_t i = 0; i < ALLOCATION_TRACKER_MAX_SITES; i++) {
+            if (isSiteEmpty(this->sites[i])) {
+                this->overflowSite = i;
+                this->hasOverflowSite = true;
+                break;
+            }
+        }
+    }
+
+    return this->hasOverflowSite ? this->overflowSite : ALLOCATION_TRACKER_NO_SITE;
+}
+
+uint16_t AllocationTracker::findLiveAllocation(uintptr_t pointer) {
+    uint16_t slot = hashAddress(pointer) & (ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS - 1);
+
+    for (uint16_t i = 0; i < ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS; i++) {
+        if (this->liveAllocations[slot].pointer == pointer || this->liveAllocations[slot].pointer == 0) {
+            return slot;
+        }
+
+        slot = (slot + 1) & (ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS - 1);
+    }
+
+    return ALLOCATION_TRACKER_NO_SITE;
+}
+
+/**
+ * Backward shift deletion, probe sequences stay unbroken without tombstones
+ */
+void AllocationTracker::removeLiveAllocation(uint16_t slot) {
+    const uint16_t mask = ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS - 1;
+    uint16_t next = (slot + 1) & mask;
+
+    while (this->liveAllocations[next].pointer != 0) {
+        uint16_t home = hashAddress(this->liveAllocations[next].pointer) & mask;
+
+        // Entry can move to the hole only if the hole is between its home and its current slot
+        bool canMove = ((next - home) & mask) >= ((next - slot) & mask);
+
+        if (canMove) {
+            this->liveAllocations[slot] = this->liveAllocations[next];
+            slot = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    this->liveAllocations[slot].pointer = 0;
+}
+
+void AllocationTracker::recordAllocation(const void* pointer, size_t size, const void* callSite) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    uint16_t site = this->findSite((uintptr_t) callSite);
+
+    this->totals.allocationsCount++;
+    this->totals.allocatedBytes += size;
+
+    if (site != ALLOCATION_TRACKER_NO_SITE) {
+        this->sites[site].allocationsCount++;
+        this->sites[site].allocatedBytes += size;
+    }
+
+    // Table never fills up, probes of lookup and removal stop at first empty slot
+    if (this->liveAllocationsCount >= ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS - 1) {
+        this->totals.untrackedCount++;
+        return;
+    }
+
+    uint16_t slot = this->findLiveAllocation((uintptr_t) pointer);
+
+    if (slot == ALLOCATION_TRACKER_NO_SITE || this->liveAllocations[slot].pointer != 0) {
+        this->totals.untrackedCount++;
+        return;
+    }
+
+    this->liveAllocations[slot] = LiveAllocation{
+        pointer: (uintptr_t) pointer,
+        size: (uint32_t) size,
+        site: site
+    };
+
+    this->liveAllocationsCount++;
+    this->totals.bytesInFlight += size;
+    this->totals.peakBytesInFlight = std::max(this->totals.peakBytesInFlight, this->totals.bytesInFlight);
+
+    if (site != ALLOCATION_TRACKER_NO_SITE) {
+        this->sites[site].liveCount++;
+        this->sites[site].bytesInFlight += size;
+    }
+}
+
+void AllocationTracker::recordFree(const void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    uint16_t slot = this->findLiveAllocation((uintptr_t) pointer);
+
+    if (slot == ALLOCATION_TRACKER_NO_SITE || this->liveAllocations[slot].pointer == 0) {
+        return;
+    }
+
+    LiveAllocation& allocation = this->liveAllocations[slot];
+
+    this->totals.freesCount++;
+    this->totals.bytesInFlight -= allocation.size;
+
+    if (allocation.site != ALLOCATION_TRACKER_NO_SITE) {
+        this->sites[allocation.site].liveCount--;
+        this->sites[allocation.site].bytesInFlight -= allocation.size;
+    }
+
+    this->removeLiveAllocation(slot);
+    this->liveAllocationsCount--;
+}
+
+/**
+ * realloc(nullptr, size) is malloc, realloc(pointer, 0) may be free
+ */
+void AllocationTracker::recordReallocation(const void* oldPointer, const void* newPointer, size_t size, const void* callSite) {
+    if (newPointer == nullptr && size > 0) {
+        return; // Failed, old block is untouched
+    }
+
+    this->recordFree(oldPointer);
+    this->recordAllocation(newPointer, size, callSite);
+}
+
+AllocationTotals AllocationTracker::getTotals() {
+    return this->totals;
+}
+
+uint16_t AllocationTracker::getTopSites(AllocationSite* topSites, uint16_t maxCount) {
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; i < ALLOCATION_TRACKER_MAX_SITES && maxCount > 0; i++) {
+        const AllocationSite& site = this->sites[i];
+
+        if (site.allocationsCount == 0 || (count == maxCount && topSites[count - 1].bytesInFlight >= site.bytesInFlight)) {
+            continue;
+        }
+
+        // Insertion into sorted list, last one drops out when it is full
+        uint16_t position = count < maxCount ? count : maxCount - 1;
+
+        while (position > 0 && topSites[position - 1].bytesInFlight < site.bytesInFlight) {
+            topSites[position] = topSites[position - 1];
+            position--;
+        }
+
+        topSites[position] = site;
+
+        if (count < maxCount) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+float calculateFragmentationRatio(uint32_t freeBytes, uint32_t largestFreeBlock) {
+    if (freeBytes == 0) {
+        return 0;
+    }
+
+    return 1 - (float) largestFreeBlock / freeBytes;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <Arduino.h>
+
+const uint16_t ALLOCATION_TRACKER_MAX_SITES = 64; // Power of two
+const uint16_t ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS = 1024; // Power of two
+const uint16_t ALLOCATION_TRACKER_NO_SITE = 0xFFFF;
+
+// Call site is return address of malloc / new caller (addr2line -e firmware.elf ADDRESS)
+struct AllocationSite {
+    uintptr_t callSite; // 0 - sites which did not fit into the table
+    uint32_t allocationsCount;
+    uint32_t allocatedBytes;
+    uint32_t liveCount;
+    uint32_t bytesInFlight;
+};
+
+struct AllocationTotals {
+    uint32_t allocationsCount;
+    uint32_t freesCount;
+    uint32_t allocatedBytes;
+    uint32_t bytesInFlight;
+    uint32_t peakBytesInFlight;
+    uint32_t untrackedCount; // Live allocations table was full, their frees are not matched either
+};
+
+struct LiveAllocation {
+    uintptr_t pointer; // 0 - empty slot
+    uint32_t size;
+    uint16_t site;
+};
+
+/**
+ * Counts allocations per call site in fixed tables, nothing is allocated here (it is called from malloc itself)
+ * Zeroed instance is ready to use (allocations come before static constructors), not thread safe - allocation hooks serialize calls
+ * Frees of pointers which were not recorded (allocated before tracking or by other allocator) are ignored
+ */
+class AllocationTracker {
+    private:
+        AllocationSite sites[ALLOCATION_TRACKER_MAX_SITES];
+        LiveAllocation liveAllocations[ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS];
+        AllocationTotals totals;
+        uint16_t sitesCount;
+        uint16_t liveAllocationsCount; // At most MAX_LIVE_ALLOCATIONS - 1, empty slot ends every probe
+        uint16_t overflowSite; // Shared by sites which did not fit
+        bool hasOverflowSite;
+
+        uint16_t findSite(uintptr_t callSite);
+        uint16_t findLiveAllocation(uintptr_t pointer);
+        void removeLiveAllocation(uint16_t slot);
+
+    public:
+        void reset();
+        void recordAllocation(const void* pointer, size_t size, const void* callSite);
+        void recordFree(const void* pointer);
+        void recordReallocation(const void* oldPointer, const void* newPointer, size_t size, const void* callSite);
+
+        AllocationTotals getTotals();
+        uint16_t getTopSites(AllocationSite* topSites, uint16_t maxCount); // Most bytes in flight first
+};
+
+/**
+ * 0 - all free memory is one block, close to 1 - only small blocks are left
+ */
+float calculateFragmentationRatio(uint32_t freeBytes, uint32_t largestFreeBlock);
+
+// Fed by allocation hooks in ALLOCATION_TRACKING builds
+extern AllocationTracker allocationTracker;
+
+// Callers take snapshots through these, tracker must not be read while another task allocates
+AllocationTotals getAllocationTotals();
+uint16_t getTopAllocationSites(AllocationSite* topSites, uint16_t maxCount);
+void resetAllocationTracking();
+
+#endif
\ No newline at end of file
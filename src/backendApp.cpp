@@ -5,8 +5,9 @@
 #include <secrets.h>
 #include <config.h>
 #include <timeHelpers.h>
+#include <chunkedPrint.h>
 
-BackendApp::BackendApp(HTTPClient* httpClient, BackgroundApp* backgroundApp): httpClient(httpClient), backgroundApp(backgroundApp) {}
+BackendApp::BackendApp(HTTPClient* httpClient, WiFiClient* logClient, BackgroundApp* backgroundApp): httpClient(httpClient), logClient(logClient), backgroundApp(backgroundApp) {}
 
 void BackendApp::addHeaders() {
   httpClient->addHeader("Content-Type", "application/json");
@@ -18,109 +19,149 @@ void BackendApp::setClientProperties() {
   httpClient->setTimeout(10000);
 }
 
-void BackendApp::saveLogToApp(BackendAppLog* logData) {
-  Serial.println("Saving log to Backend: Trying to query Adding Log");
+/**
+ * Splits http://host[:port][/path], path points into url
+ */
+bool BackendApp::parseUrl(const char* url, char* host, size_t hostSize, uint16_t& port, const char*& path) {
+  const char* scheme = "http://";
 
-  this->setClientProperties();
+  if (strncmp(url, scheme, strlen(scheme)) != 0) {
+    return false;
+  }
 
-  try {
-    if (!httpClient->begin(BACKEND_APP_URL)) {
-      httpClient->end();
+  const char* hostStart = url + strlen(scheme);
+  const char* hostEnd = hostStart;
 
-      Serial.println("Failed to connect to BackendApp");
-      backgroundApp->addWarning(BACKEND_HTTP_REQUEST_FAILED);
+  while (*hostEnd != '\0' && *hostEnd != ':' && *hostEnd != '/') {
+    hostEnd++;
+  }
 
-      return;
-    }
+  size_t hostLength = hostEnd - hostStart;
 
-    backgroundApp->removeWarning(BACKEND_HTTP_REQUEST_FAILED);
+  if (hostLength == 0 || hostLength >= hostSize) {
+    return false;
+  }
 
-    this->addHeaders();
+  memcpy(host, hostStart, hostLength);
+  host[hostLength] = '\0';
 
-    JsonDocument doc; // Should be better adjusted
+  port = 80;
+  path = hostEnd;
 
-    // Main data
-    doc["insideTemperature"] = logData->insideTemperature;
-    doc["windowOpening"] = logData->windowOpening;
-    doc["deltaTemporaryWindowOpening"] = logData->deltaTemporaryWindowOpening;
-    doc["deltaFinalWindowOpening"] = logData->deltaFinalWindowOpening;
+  if (*hostEnd == ':') {
+    port = atoi(hostEnd + 1);
+    path = strchr(hostEnd, '/');
 
-    if (logData->outsideTemperature != nullptr) {
-      doc["outsideTemperature"] = *logData->outsideTemperature;
+    if (path == nullptr) {
+      path = "";
     }
+  }
 
-    if (logData->pm25 != nullptr) {
-      doc["pm25"] = *logData->pm25;
-    }
+  if (*path == '\0') {
+    path = "/";
+  }
 
-    if (logData->pm10 != nullptr) {
-      doc["pm10"] = *logData->pm10;
-    }
+  return true;
+}
 
-    // Config
-    doc["config"]["weatherLogNotOlderThanHours"] = logData->config.weatherLogNotOlderThanHours;
-    doc["config"]["pm25Norm"] = logData->config.pm25Norm;
-    doc["config"]["pm10Norm"] = logData->config.pm10Norm;
-    doc["config"]["pm25Weight"] = logData->config.pm25Weight;
-    doc["config"]["pm10Weight"] = logData->config.pm10Weight;
-    doc["config"]["maxOutsideTemperatureDiffFromOptimal"] = logData->config.maxOutsideTemperatureDiffFromOptimal;
-    doc["config"]["outsideTemperatureClosingThreshold"] = logData->config.outsideTemperatureClosingThreshold;
-    doc["config"]["optimalTemperature"] = logData->config.optimalTemperature;
-    doc["config"]["pTermPositive"] = logData->config.pTermPositive;
-    doc["config"]["pTermNegative"] = logData->config.pTermNegative;
-    doc["config"]["dTermPositive"] = logData->config.dTermPositive;
-    doc["config"]["dTermNegative"] = logData->config.dTermNegative;
-    doc["config"]["oTermPositive"] = logData->config.oTermPositive;
-    doc["config"]["oTermNegative"] = logData->config.oTermNegative;
-    doc["config"]["iTerm"] = logData->config.iTerm;
-    doc["config"]["openingTermPositiveTemperatureIncrease"] = logData->config.openingTermPositiveTemperatureIncrease;
-    doc["config"]["changeDiffThreshold"] = logData->config.changeDiffThreshold;
-
-    // Partial Data
-    doc["partialData"]["proportionalTermValue"] = logData->partialData.proportionalTermValue;
-    doc["partialData"]["integralTermValue"] = logData->partialData.integralTermValue;
-    doc["partialData"]["derivativeTermValue"] = logData->partialData.derivativeTermValue;
-    doc["partialData"]["openingTermValue"] = logData->partialData.openingTermValue;
-
-    if (logData->partialData.outsideTemperatureTermValue != nullptr) {
-      doc["partialData"]["outsideTemperatureTermValue"] = this->roundValue(*logData->partialData.outsideTemperatureTermValue);
-    }
-    
-    if (logData->partialData.airPollutionTermValue != nullptr) {
-      doc["partialData"]["airPollutionTermValue"] = this->roundValue(*logData->partialData.airPollutionTermValue) ;
+/**
+ * Returns status code of the response, 0 when it didn't come
+ */
+int BackendApp::readStatusCode() {
+  unsigned long requestSentMillis = millis();
+
+  while (logClient->connected() && logClient->available() == 0) {
+    if (millis() - requestSentMillis > BACKEND_APP_RESPONSE_TIMEOUT) {
+      return 0;
     }
-    
-    Serial.println("Saving log to Backend: Serialize JSON");
 
-    String payload;
-    serializeJson(doc, payload);
+    delay(10);
+  }
 
-    int httpCode = httpClient->POST(payload);
+  char statusLine[BACKEND_APP_STATUS_LINE_MAX_LENGTH];
+  size_t statusLineLength = logClient->readBytesUntil('\n', statusLine, sizeof(statusLine) - 1);
+  statusLine[statusLineLength] = '\0';
 
-    if (httpCode <= 0) {
-      Serial.println("BackendApp Request failed");
-      backgroundApp->addWarning(BACKEND_HTTP_REQUEST_FAILED);
-    }
+  int httpCode = 0;
 
-    if (httpCode != 201) {
-      Serial.println("BackendApp didn't respond with 201");
-      backgroundApp->addWarning(BACKEND_HTTP_REQUEST_FAILED);
-    } else {
-      Serial.println("BackendApp retrieved log data");
-      backgroundApp->removeWarning(BACKEND_HTTP_REQUEST_FAILED);
-    }
+  if (sscanf(statusLine, "HTTP/%*s %d", &httpCode) != 1) {
+    return 0;
+  }
 
-    Serial.println("Saving log to Backend: Query finished");
-  } catch (const std::exception& e) {
-    httpClient->end();
+  return httpCode;
+}
 
+/**
+ * Headers and body go through one chunk buffer, body length is measured up front (no chunked encoding needed)
+ */
+int BackendApp::postLog(const BackendAppLog& logData) {
+  char host[BACKEND_APP_HOST_MAX_LENGTH];
+  uint16_t port;
+  const char* path;
+
+  if (!this->parseUrl(BACKEND_APP_URL, host, sizeof(host), port, path)) {
+    Serial.println("Saving log to Backend: Unsupported BackendApp URL");
+    return 0;
+  }
+
+  if (!logClient->connect(host, port)) {
+    Serial.println("Failed to connect to BackendApp");
+    return 0;
+  }
+
+  size_t contentLength = measureBackendAppLogJson(logData);
+
+  ChunkedPrint<BACKEND_APP_REQUEST_CHUNK_SIZE> request(*logClient);
+
+  request.print("POST ");
+  request.print(path);
+  request.print(" HTTP/1.1\r\nHost: ");
+  request.print(host);
+  request.print("\r\nContent-Type: application/json\r\nApp-Secret: ");
+  request.print(BACKEND_APP_SECRET);
+  request.print("\r\nContent-Length: ");
+  request.print(contentLength);
+  request.print("\r\nConnection: close\r\n\r\n");
+
+  Serial.println("Saving log to Backend: Stream JSON");
+
+  writeBackendAppLogJson(request, logData);
+  request.flush();
+
+  if (request.isFailed()) {
+    Serial.println("Saving log to Backend: Connection dropped while sending");
+    return 0;
+  }
+
+  return this->readStatusCode();
+}
+
+void BackendApp::saveLogToApp(BackendAppLog* logData) {
+  Serial.println("Saving log to Backend: Trying to query Adding Log");
+
+  int httpCode = 0;
+
+  try {
+    httpCode = this->postLog(*logData);
+  } catch (const std::exception& e) {
     Serial.println("Error during log saving");
     Serial.println(e.what());
+  }
+
+  logClient->stop();
+
+  if (httpCode <= 0) {
+    Serial.println("BackendApp Request failed");
+    backgroundApp->addWarning(BACKEND_HTTP_REQUEST_FAILED);
+  } else if (httpCode != 201) {
+    Serial.println("BackendApp didn't respond with 201");
     backgroundApp->addWarning(BACKEND_HTTP_REQUEST_FAILED);
-    return;
+  } else {
+    Serial.println("BackendApp retrieved log data");
+    backgroundApp->removeWarning(BACKEND_HTTP_REQUEST_FAILED);
   }
 
-  httpClient->end();
+  Serial.println("Saving log to Backend: Query finished");
 }
 
 vector<WeatherItem> BackendApp::fetchWeatherForecast() {
@@ -262,8 +303,4 @@ AirPollutionItem BackendApp::fetchAirPollution() {
   }
 
   httpClient->end();
-}
-
-double BackendApp::roundValue(double value) {
-  return round(value * 100.0) / 100.0;
 }
\ No newline at end of file
@@ -3,52 +3,17 @@
 
 #include <vector>
 #include <HTTPClient.h>
+#include <WiFi.h>
+#include <backendAppLogJson.h>
 
 class BackgroundApp;
 
-using namespace std;
-
-struct BackendAppLogConfig {
-    double weatherLogNotOlderThanHours;
-    double pm25Norm;
-    double pm10Norm;
-    double pm25Weight;
-    double pm10Weight;
-    double maxOutsideTemperatureDiffFromOptimal;
-    double outsideTemperatureClosingThreshold;
-    double optimalTemperature;
-    double pTermPositive;
-    double pTermNegative;
-    double dTermPositive;
-    double dTermNegative;
-    double oTermPositive;
-    double oTermNegative;
-    double iTerm;
-    double openingTermPositiveTemperatureIncrease;
-    double changeDiffThreshold;
-};
-
+const size_t BACKEND_APP_REQUEST_CHUNK_SIZE = 256; // Log request is streamed in chunks of this size, there is no body buffer
+const uint8_t BACKEND_APP_HOST_MAX_LENGTH = 64;
+const uint8_t BACKEND_APP_STATUS_LINE_MAX_LENGTH = 64;
+const uint16_t BACKEND_APP_RESPONSE_TIMEOUT = 10000;
 
-struct BackendAppLogPartialData {
-    double proportionalTermValue;
-    double integralTermValue;
-    double derivativeTermValue;
-    double openingTermValue;
-    double* outsideTemperatureTermValue; // Optional
-    double* airPollutionTermValue; // Optional
-};
-
-struct BackendAppLog {
-    int windowOpening;
-    int deltaTemporaryWindowOpening; // Before taking into account change threshold
-    int deltaFinalWindowOpening;
-    double insideTemperature;
-    double* outsideTemperature; // Optional
-    double* pm25; // Optional
-    double* pm10; // Optional
-    BackendAppLogConfig config;
-    BackendAppLogPartialData partialData;
-};
+using namespace std;
 
 struct WeatherItem {
     float temperature;
@@ -77,13 +42,16 @@ struct SensorResponseItem {
 class BackendApp {
   private:
       HTTPClient* httpClient;
+      WiFiClient* logClient; // Raw connection, HTTPClient can't stream request body without buffering it
       BackgroundApp* backgroundApp;
 
       void addHeaders();
       void setClientProperties();
-      double roundValue(double value);
+      bool parseUrl(const char* url, char* host, size_t hostSize, uint16_t& port, const char*& path);
+      int postLog(const BackendAppLog& logData);
+      int readStatusCode();
   public:
-      BackendApp(HTTPClient* httpClient, BackgroundApp* backgroundApp);
+      BackendApp(HTTPClient* httpClient, WiFiClient* logClient, BackgroundApp* backgroundApp);
 
       void saveLogToApp(BackendAppLog* logData);
       vector<WeatherItem> fetchWeatherForecast();
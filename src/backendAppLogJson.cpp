@@ -0,0 +1,142 @@
+#include <backendAppLogJson.h>
+#include <chunkedPrint.h>
+#include <math.h>
+
+/**
+ * Writes object members, separators are added before every member but the first one
+ */
+class JsonObjectWriter {
+    private:
+        Print& output;
+        size_t length;
+        bool isFirstMember;
+
+        void writeRaw(const char* text) {
+            this->length += this->output.write((const uint8_t*) text, strlen(text));
+        }
+
+        void writeKey(const char* key) {
+            this->writeRaw(this->isFirstMember ? "\"" : ",\"");
+            this->writeRaw(key);
+            this->writeRaw("\":");
+            this->isFirstMember = false;
+        }
+
+    public:
+        JsonObjectWriter(Print& output): output(output), length(0), isFirstMember(true) {}
+
+        void begin() {
+            this->writeRaw("{");
+            this->isFirstMember = true;
+        }
+
+        void beginObject(const char* key) {
+            this->writeKey(key);
+            this->begin();
+        }
+
+        void end() {
+            this->writeRaw("}");
+            this->isFirstMember = false;
+        }
+
+        void add(const char* key, int value) {
+            char number[BACKEND_APP_LOG_JSON_NUMBER_MAX_LENGTH];
+            snprintf(number, sizeof(number), "%d", value);
+
+            this->writeKey(key);
+            this->writeRaw(number);
+        }
+
+        void add(const char* key, double value) {
+            this->writeKey(key);
+
+            // JSON has no NaN nor infinity, ArduinoJson writes them as null too
+            if (isnan(value) || isinf(value)) {
+                this->writeRaw("null");
+                return;
+            }
+
+            char number[BACKEND_APP_LOG_JSON_NUMBER_MAX_LENGTH];
+            snprintf(number, sizeof(number), "%.9g", value);
+
+            this->writeRaw(number);
+        }
+
+        void addOptional(const char* key, const double* value) {
+            if (value != nullptr) {
+                this->add(key, *value);
+            }
+        }
+
+        size_t getLength() {
+            return this->length;
+        }
+};
+
+static double roundLogValue(double value) {
+    return round(value * 100.0) / 100.0;
+}
+
+size_t writeBackendAppLogJson(Print& output, const BackendAppLog& log) {
+    JsonObjectWriter writer(output);
+
+    writer.begin();
+
+    // Main data
+    writer.add("insideTemperature", log.insideTemperature);
+    writer.add("windowOpening", log.windowOpening);
+    writer.add("deltaTemporaryWindowOpening", log.deltaTemporaryWindowOpening);
+    writer.add("deltaFinalWindowOpening", log.deltaFinalWindowOpening);
+    writer.addOptional("outsideTemperature", log.outsideTemperature);
+    writer.addOptional("pm25", log.pm25);
+    writer.addOptional("pm10", log.pm10);
+
+    // Config
+    writer.beginObject("config");
+    writer.add("weatherLogNotOlderThanHours", log.config.weatherLogNotOlderThanHours);
+    writer.add("pm25Norm", log.config.pm25Norm);
+    writer.add("pm10Norm", log.config.pm10Norm);
+    writer.add("pm25Weight", log.config.pm25Weight);
+    writer.add("pm10Weight", log.config.pm10Weight);
+    writer.add("maxOutsideTemperatureDiffFromOptimal", log.config.maxOutsideTemperatureDiffFromOptimal);
+    writer.add("outsideTemperatureClosingThreshold", log.config.outsideTemperatureClosingThreshold);
+    writer.add("optimalTemperature", log.config.optimalTemperature);
+    writer.add("pTermPositive", log.config.pTermPositive);
+    writer.add("pTermNegative", log.config.pTermNegative);
+    writer.add("dTermPositive", log.config.dTermPositive);
+    writer.add("dTermNegative", log.config.dTermNegative);
+    writer.add("oTermPositive", log.config.oTermPositive);
+    writer.add("oTermNegative", log.config.oTermNegative);
+    writer.add("iTerm", log.config.iTerm);
+    writer.add("openingTermPositiveTemperatureIncrease", log.config.openingTermPositiveTemperatureIncrease);
+    writer.add("changeDiffThreshold", log.config.changeDiffThreshold);
+    writer.end();
+
+    // Partial Data
+    writer.beginObject("partialData");
+    writer.add("proportionalTermValue", log.partialData.proportionalTermValue);
+    writer.add("integralTermValue", log.partialData.integralTermValue);
+    writer.add("derivativeTermValue", log.partialData.derivativeTermValue);
+    writer.add("openingTermValue", log.partialData.openingTermValue);
+
+    if (log.partialData.outsideTemperatureTermValue != nullptr) {
+        writer.add("outsideTemperatureTermValue", roundLogValue(*log.partialData.outsideTemperatureTermValue));
+    }
+
+    if (log.partialData.airPollutionTermValue != nullptr) {
+        writer.add("airPollutionTermValue", roundLogValue(*log.partialData.airPollutionTermValue));
+    }
+
+    writer.end();
+
+    writer.end();
+
+    return writer.getLength();
+}
+
+size_t measureBackendAppLogJson(const BackendAppLog& log) {
+    LengthCountingPrint counter;
+
+    return writeBackendAppLogJson(counter, log);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef BACKEND_APP_LOG_JSON_H
+#define BACKEND_APP_LOG_JSON_H
+
+#include <Arduino.h>
+
+struct BackendAppLogConfig {
+    double weatherLogNotOlderThanHours;
+    double pm25Norm;
+    double pm10Norm;
+    double pm25Weight;
+    double pm10Weight;
+    double maxOutsideTemperatureDiffFromOptimal;
+    double outsideTemperatureClosingThreshold;
+    double optimalTemperature;
+    double pTermPositive;
+    double pTermNegative;
+    double dTermPositive;
+    double dTermNegative;
+    double oTermPositive;
+    double oTermNegative;
+    double iTerm;
+    double openingTermPositiveTemperatureIncrease;
+    double changeDiffThreshold;
+};
+
+struct BackendAppLogPartialData {
+    double proportionalTermValue;
+    double integralTermValue;
+    double derivativeTermValue;
+    double openingTermValue;
+    double* outsideTemperatureTermValue; // Optional
+    double* airPollutionTermValue; // Optional
+};
+
+struct BackendAppLog {
+    int windowOpening;
+    int deltaTemporaryWindowOpening; // Before taking into account change threshold
+    int deltaFinalWindowOpening;
+    double insideTemperature;
+    double* outsideTemperature; // Optional
+    double* pm25; // Optional
+    double* pm10; // Optional
+    BackendAppLogConfig config;
+    BackendAppLogPartialData partialData;
+};
+
+const uint8_t BACKEND_APP_LOG_JSON_NUMBER_MAX_LENGTH = 32;
+
+/**
+ * Log schema is fixed, so it is written field by field without JSON document (no pool, no body buffer)
+ * Output is the same as serializeJson of the document saveLogToApp used to build
+ */
+size_t writeBackendAppLogJson(Print& output, const BackendAppLog& log);
+size_t measureBackendAppLogJson(const BackendAppLog& log); // Content-Length
+
+#endif
\ No newline at end of file
@@ -4,7 +4,9 @@
 BackgroundApp::BackgroundApp(LedWrapper& led, LcdWrapper& lcd, MemoryValue* warningsAreActiveMemory): led(led), lcd(lcd), warningsAreActiveMemory(warningsAreActiveMemory) {
     this->lastWarningChangeTimer = millis();
     this->currentWarningDisplayedIndex = this->warnings.begin();
-    this->isLedActive = false;
+    this->isWarningShown = false;
+    this->playedWarningsMask = 0;
+    this->playedPatternsCount = 0;
 }
 
 void BackgroundApp::addWarning(WarningEnum warning) {
@@ -26,30 +28,58 @@ void BackgroundApp::removeWarning(WarningEnum warning) {
     }
 }
 
-void BackgroundApp::displayLedColorByWarning(WarningEnum warning) {
+LedColor BackgroundApp::getWarningColor(WarningEnum warning) {
     switch (warning) {
         case LOW_BATTERY:
-            led.setColorPurple();
-            break;
+            return LedColor{ red: 255, green: 0, blue: 255 }; // Purple
 
         case WEATHER_DANGEROUS:
-            led.setColorRed();
-            break;
+            return LedColor{ red: 255, green: 0, blue: 0 }; // Red
 
         case WIFI_FAILED:
-            led.setColorYellow(); // Same
-            break;
-
         case BACKEND_HTTP_REQUEST_FAILED:
         case WEATHER_FORECAST_HTTP_REQUEST_FAILED:
         case AIR_POLLUTION_HTTP_REQUEST_FAILED:
-            led.setColorYellow(); // Same
-            break;
+            return LedColor{ red: 255, green: 255, blue: 0 }; // Yellow
 
         case NONE_WARNING:
         default:
-            led.setNoColor();
+            return LED_COLOR_OFF;
+    }
+}
+
+/**
+ * LED cycles through colors of all active warnings on its own, pattern is submitted only when warnings change
+ * or when LED has been taken by something else (menu) in the meantime
+ */
+void BackgroundApp::playWarningsPattern() {
+    uint8_t warningsMask = 0;
+
+    for (WarningEnum warning : warnings) {
+        warningsMask |= 1 << warning;
+    }
+
+    if (warningsMask == this->playedWarningsMask && this->led.getPatternsCount() == this->playedPatternsCount) {
+        return;
+    }
+
+    if (warnings.empty()) {
+        this->led.setNoColor();
+    } else {
+        LedColor colors[LED_PATTERN_MAX_KEYFRAMES / 2];
+        uint8_t colorsCount = 0;
+
+        for (WarningEnum warning : warnings) {
+            if (colorsCount < LED_PATTERN_MAX_KEYFRAMES / 2) {
+                colors[colorsCount++] = this->getWarningColor(warning);
+            }
+        }
+
+        this->led.play(LedPatterns::colorCycle(colors, colorsCount, timerDelay * 2));
     }
+
+    this->playedWarningsMask = warningsMask;
+    this->playedPatternsCount = this->led.getPatternsCount();
 }
 
 void BackgroundApp::handleWarningsDisplay() {
@@ -63,16 +93,17 @@ void BackgroundApp::handleWarningsDisplay() {
 
     lastWarningChangeTimer = currentMillis;
 
+    this->playWarningsPattern();
+
     if (warnings.empty()) {
         this->lcd.clear();
         this->lcd.noBacklight();
-        displayLedColorByWarning(NONE_WARNING);
         return;
     }
 
-    isLedActive = !isLedActive;
+    isWarningShown = !isWarningShown;
 
-    if (isLedActive) {
+    if (isWarningShown) {
          if (warnings.find(*currentWarningDisplayedIndex) == warnings.end()) {
             currentWarningDisplayedIndex = warnings.begin();
         } else {
@@ -82,11 +113,9 @@ void BackgroundApp::handleWarningsDisplay() {
             }
         }
 
-        displayLedColorByWarning(*currentWarningDisplayedIndex);
         this->lcd.backlight();
         this->lcd.print(translateWarningEnumToString(*currentWarningDisplayedIndex));
     } else {
-        displayLedColorByWarning(NONE_WARNING);
         this->lcd.clear();
         this->lcd.noBacklight();
     }
@@ -13,7 +13,7 @@ struct WeatherItem;
 
 using namespace std;
 
-const int timerDelay = 500; // For switching LED Color
+const int timerDelay = 500; // For switching warning text, also LED color on / off time
 const int WARNING_WEATHER_MAX_HOURS_AHEAD = 9; // How many hours ahead are we going to check weather
 const int WARNING_WIND_SPEED = 8; // m/s
 
@@ -25,10 +25,13 @@ class BackgroundApp {
         LedWrapper& led;
         LcdWrapper& lcd;
         long lastWarningChangeTimer;
-        boolean isLedActive;
+        boolean isWarningShown; // LCD blinks warning texts
+        uint8_t playedWarningsMask;
+        uint32_t playedPatternsCount;
         set<WarningEnum>::iterator currentWarningDisplayedIndex;
         MemoryValue* warningsAreActiveMemory;
-        void displayLedColorByWarning(WarningEnum warning);
+        LedColor getWarningColor(WarningEnum warning);
+        void playWarningsPattern();
         String translateWarningEnumToString(WarningEnum warning);
 
     public:
@@ -0,0 +1,87 @@
+#include <batchedLcd.h>
+
+BatchedLcd::BatchedLcd(uint8_t address, uint8_t columns, uint8_t rows): LiquidCrystal_I2C(address, columns, rows) {
+  this->address = address;
+  this->rows = rows;
+  this->backlightValue = LCD_NOBACKLIGHT;
+  this->isBatching = false;
+  this->bufferLength = 0;
+}
+
+void BatchedLcd::beginBatch() {
+  this->isBatching = true;
+}
+
+void BatchedLcd::endBatch() {
+  this->sendBuffer();
+  this->isBatching = false;
+}
+
+void BatchedLcd::setCursor(uint8_t column, uint8_t row) {
+  if (!this->isBatching) {
+    LiquidCrystal_I2C::setCursor(column, row);
+    return;
+  }
+
+  const uint8_t rowOffsets[] = { 0x00, 0x40, 0x14, 0x54 };
+
+  if (row >= this->rows) {
+    row = this->rows - 1;
+  }
+
+  this->queueByte(LCD_SETDDRAMADDR | (column + rowOffsets[row]), 0);
+}
+
+size_t BatchedLcd::write(uint8_t value) {
+  if (!this->isBatching) {
+    return LiquidCrystal_I2C::write(value);
+  }
+
+  this->queueByte(value, Rs);
+
+  return 1;
+}
+
+void BatchedLcd::backlight() {
+  this->backlightValue = LCD_BACKLIGHT;
+  LiquidCrystal_I2C::backlight();
+}
+
+void BatchedLcd::noBacklight() {
+  this->backlightValue = LCD_NOBACKLIGHT;
+  LiquidCrystal_I2C::noBacklight();
+}
+
+/**
+ * Same edges as LiquidCrystal_I2C::send, high nibble first
+ */
+void BatchedLcd::queueByte(uint8_t value, uint8_t mode) {
+  if (this->bufferLength + LCD_BYTES_PER_CHARACTER > LCD_BATCH_BUFFER_SIZE) {
+    this->sendBuffer();
+  }
+
+  this->queueNibble((value & 0xf0) | mode);
+  this->queueNibble(((value << 4) & 0xf0) | mode);
+}
+
+void BatchedLcd::queueNibble(uint8_t nibble) {
+  uint8_t data = nibble | this->backlightValue;
+
+  this->buffer[this->bufferLength++] = data;
+  this->buffer[this->bufferLength++] = data | En; // Enable high
+  this->buffer[this->bufferLength++] = data & ~En; // Enable low, LCD latches nibble
+}
+
+void BatchedLcd::sendBuffer() {
+  if (this->bufferLength == 0) {
+    return;
+  }
+
+  Wire.beginTransmission(this->address);
+  Wire.write(this->buffer, this->bufferLength);
+  Wire.endTransmission();
+
+  this->bufferLength = 0;
+
+  delayMicroseconds(50); // Last command needs > 37us to settle
+}
\ No newline at end of file
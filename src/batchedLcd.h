@@ -0,0 +1,41 @@
+#ifndef BATCHED_LCD_H
+#define BATCHED_LCD_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <LiquidCrystal_I2C.h>
+
+// Whole characters only (6 expander bytes each), below 128 bytes of Wire buffer
+const uint8_t LCD_BATCH_BUFFER_SIZE = 120;
+const uint8_t LCD_BYTES_PER_CHARACTER = 6;
+
+/**
+ * LiquidCrystal_I2C opens separate I2C transaction for every nibble and every enable edge (6 per character)
+ * Between beginBatch() and endBatch() characters and cursor moves are only packed into buffer
+ * and sent as few transactions (PCF8574 takes stream of bytes, I2C byte time keeps enable pulse and settle timings)
+ */
+class BatchedLcd : public LiquidCrystal_I2C {
+  private:
+    uint8_t address;
+    uint8_t rows;
+    uint8_t backlightValue;
+    bool isBatching;
+    uint8_t buffer[LCD_BATCH_BUFFER_SIZE];
+    uint8_t bufferLength;
+
+    void queueByte(uint8_t value, uint8_t mode);
+    void queueNibble(uint8_t nibble);
+    void sendBuffer();
+
+  public:
+    BatchedLcd(uint8_t address, uint8_t columns, uint8_t rows);
+    void beginBatch();
+    void endBatch();
+
+    void setCursor(uint8_t column, uint8_t row);
+    size_t write(uint8_t value) override;
+    void backlight();
+    void noBacklight();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <batteryStateOfCharge.h>
+
+/**
+ * Linear interpolation between neighbouring curve points, clamped to 0 - 100
+ */
+float lookupDischargeCurve(float voltage) {
+    if (voltage >= BATTERY_DISCHARGE_CURVE[0].voltage) {
+        return BATTERY_DISCHARGE_CURVE[0].percentage;
+    }
+
+    for (uint8_t i = 1; i < BATTERY_DISCHARGE_CURVE_POINTS_COUNT; i++) {
+        const DischargeCurvePoint& upper = BATTERY_DISCHARGE_CURVE[i - 1];
+        const DischargeCurvePoint& lower = BATTERY_DISCHARGE_CURVE[i];
+
+        if (voltage >= lower.voltage) {
+            return lower.percentage + (voltage - lower.voltage) * (upper.percentage - lower.percentage) / (upper.voltage - lower.voltage);
+        }
+    }
+
+    return BATTERY_DISCHARGE_CURVE[BATTERY_DISCHARGE_CURVE_POINTS_COUNT - 1].percentage;
+}
+
+BatteryStateOfCharge::BatteryStateOfCharge() {
+    this->history = BatteryHistory{};
+    this->percentage = 0;
+    this->hasSample = false;
+}
+
+/**
+ * Every sample updates percentage, history keeps one point per BATTERY_HISTORY_INTERVAL_SECONDS
+ */
+void BatteryStateOfCharge::addSample(float voltage, uint32_t timestampSeconds) {
+    this->percentage = lookupDischargeCurve(voltage);
+    this->hasSample = true;
+
+    if (this->history.count > 0) {
+        uint8_t lastIndex = (this->history.nextIndex + BATTERY_HISTORY_SIZE - 1) % BATTERY_HISTORY_SIZE;
+        uint32_t lastTimestamp = this->history.points[lastIndex].timestampSeconds;
+
+        if (timestampSeconds < lastTimestamp || timestampSeconds - lastTimestamp > BATTERY_HISTORY_SIZE * BATTERY_HISTORY_INTERVAL_SECONDS) {
+            this->history = BatteryHistory{};
+        } else if (timestampSeconds - lastTimestamp < BATTERY_HISTORY_INTERVAL_SECONDS) {
+            return;
+        }
+    }
+
+    this->history.points[this->history.nextIndex] = BatteryHistoryPoint{
+        timestampSeconds: timestampSeconds,
+        percentage: this->percentage
+    };
+    this->history.nextIndex = (this->history.nextIndex + 1) % BATTERY_HISTORY_SIZE;
+
+    if (this->history.count < BATTERY_HISTORY_SIZE) {
+        this->history.count++;
+    }
+}
+
+bool BatteryStateOfCharge::isKnown() {
+    return this->hasSample;
+}
+
+float BatteryStateOfCharge::getPercentage() {
+    return this->percentage;
+}
+
+uint8_t BatteryStateOfCharge::getHistoryCount() {
+    return this->history.count;
+}
+
+/**
+ * Slope of least squares line, times are relative to the oldest point (keeps float precision)
+ */
+float BatteryStateOfCharge::getDischargeRatePerHour() {
+    uint8_t count = this->history.count;
+
+    if (count < BATTERY_HISTORY_MIN_POINTS) {
+        return 0;
+    }
+
+    uint8_t oldestIndex = (this->history.nextIndex + BATTERY_HISTORY_SIZE - count) % BATTERY_HISTORY_SIZE;
+    uint32_t oldestTimestamp = this->history.points[oldestIndex].timestampSeconds;
+
+    float sumTime = 0;
+    float sumPercentage = 0;
+    float sumTimeSquared = 0;
+    float sumTimePercentage = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        const BatteryHistoryPoint& point = this->history.points[(oldestIndex + i) % BATTERY_HISTORY_SIZE];
+        float hours = (point.timestampSeconds - oldestTimestamp) / 3600.0f;
+
+        sumTime += hours;
+        sumPercentage += point.percentage;
+        sumTimeSquared += hours * hours;
+        sumTimePercentage += hours * point.percentage;
+    }
+
+    float denominator = count * sumTimeSquared - sumTime * sumTime;
+
+    if (denominator <= 0) {
+        return 0;
+    }
+
+    float slope = (count * sumTimePercentage - sumTime * sumPercentage) / denominator;
+
+    return -slope;
+}
+
+int32_t BatteryStateOfCharge::getTimeToEmptyMinutes() {
+    float dischargeRate = this->getDischargeRatePerHour();
+
+    if (!this->hasSample || dischargeRate <= 0) {
+        return BATTERY_TIME_TO_EMPTY_UNKNOWN;
+    }
+
+    return round(this->percentage / dischargeRate * 60);
+}
+
+const BatteryHistory& BatteryStateOfCharge::getHistory() {
+    return this->history;
+}
+
+/**
+ * Percentage stays unknown until the first sample after wake up
+ */
+void BatteryStateOfCharge::restoreHistory(const BatteryHistory& history) {
+    if (history.count > BATTERY_HISTORY_SIZE || history.nextIndex >= BATTERY_HISTORY_SIZE) {
+        return;
+    }
+
+    this->history = history;
+}
\ No newline at end of file
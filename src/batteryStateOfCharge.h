@@ -0,0 +1,78 @@
+#ifndef BATTERY_STATE_OF_CHARGE_H
+#define BATTERY_STATE_OF_CHARGE_H
+
+#include <Arduino.h>
+
+struct DischargeCurvePoint {
+    float voltage;
+    float percentage;
+};
+
+// 2S Li-ion open circuit voltage (resting, no load), ordered from full to empty
+constexpr DischargeCurvePoint BATTERY_DISCHARGE_CURVE[] = {
+    { voltage: 8.40, percentage: 100 },
+    { voltage: 8.22, percentage: 90 },
+    { voltage: 8.04, percentage: 80 },
+    { voltage: 7.90, percentage: 70 },
+    { voltage: 7.74, percentage: 60 },
+    { voltage: 7.68, percentage: 50 },
+    { voltage: 7.60, percentage: 40 },
+    { voltage: 7.54, percentage: 30 },
+    { voltage: 7.46, percentage: 20 },
+    { voltage: 7.38, percentage: 10 },
+    { voltage: 7.22, percentage: 5 },
+    { voltage: 6.54, percentage: 0 }
+};
+
+constexpr uint8_t BATTERY_DISCHARGE_CURVE_POINTS_COUNT = sizeof(BATTERY_DISCHARGE_CURVE) / sizeof(DischargeCurvePoint);
+
+constexpr bool isDischargeCurveDescending(const DischargeCurvePoint* curve, uint8_t count) {
+    return count < 2 || (curve[0].voltage > curve[1].voltage && curve[0].percentage > curve[1].percentage && isDischargeCurveDescending(curve + 1, count - 1));
+}
+
+static_assert(isDischargeCurveDescending(BATTERY_DISCHARGE_CURVE, BATTERY_DISCHARGE_CURVE_POINTS_COUNT), "Discharge curve has to be ordered from full to empty");
+
+const uint8_t BATTERY_HISTORY_SIZE = 48;
+const uint32_t BATTERY_HISTORY_INTERVAL_SECONDS = 5 * 60; // 4 hours of history
+const uint8_t BATTERY_HISTORY_MIN_POINTS = 3; // For time to empty
+const int32_t BATTERY_TIME_TO_EMPTY_UNKNOWN = -1;
+
+struct BatteryHistoryPoint {
+    uint32_t timestampSeconds; // System time, keeps running through deep sleep (RTC timer)
+    float percentage;
+};
+
+// Plain data, kept in RTC memory through deep sleep
+struct BatteryHistory {
+    BatteryHistoryPoint points[BATTERY_HISTORY_SIZE];
+    uint8_t count;
+    uint8_t nextIndex;
+};
+
+float lookupDischargeCurve(float voltage);
+
+/**
+ * Percentage from discharge curve, time to empty from least squares line over percentage history
+ * Only resting (no load) voltages should be added
+ * History outlives deep sleep (getHistory() before sleep, restoreHistory() after wake up),
+ * it starts over when system time jumps (NTP sync) or the gap is longer than whole history
+ */
+class BatteryStateOfCharge {
+    private:
+        BatteryHistory history;
+        float percentage;
+        bool hasSample;
+
+    public:
+        BatteryStateOfCharge();
+        void addSample(float voltage, uint32_t timestampSeconds);
+        bool isKnown();
+        float getPercentage();
+        uint8_t getHistoryCount();
+        float getDischargeRatePerHour(); // Percents per hour, positive while discharging
+        int32_t getTimeToEmptyMinutes(); // BATTERY_TIME_TO_EMPTY_UNKNOWN when not discharging or not enough history
+        const BatteryHistory& getHistory();
+        void restoreHistory(const BatteryHistory& history);
+};
+
+#endif
\ No newline at end of file
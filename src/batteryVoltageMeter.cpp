@@ -2,7 +2,7 @@
 
 
 
-BatteryVoltageMeter::BatteryVoltageMeter(byte batteryVoltageMeterPin, float batteryVoltage0Reference, float batteryVoltage100Reference, float &lastReadBatteryVoltage) : batteryVoltageMeterPin(batteryVoltageMeterPin), batteryVoltage0Reference(batteryVoltage0Reference), batteryVoltage100Reference(batteryVoltage100Reference), lastReadBatteryVoltage(lastReadBatteryVoltage) {}
+BatteryVoltageMeter::BatteryVoltageMeter(AdcSampler* adcSampler, ServosPowerSupply* loadPowerSupply, byte batteryVoltageMeterPin, float &lastReadBatteryVoltage) : adcSampler(adcSampler), loadPowerSupply(loadPowerSupply), batteryVoltageMeterPin(batteryVoltageMeterPin), lastReadBatteryVoltage(lastReadBatteryVoltage), voltageFilter(MedianFilter<float, 3>(), KalmanFilter<float>(BATTERY_VOLTAGE_PROCESS_NOISE, BATTERY_VOLTAGE_MEASUREMENT_NOISE)) {}
 
 void BatteryVoltageMeter::initialize() {
     adc_chars = (esp_adc_cal_characteristics_t *)calloc(1, sizeof(esp_adc_cal_characteristics_t));
@@ -14,29 +14,57 @@ void BatteryVoltageMeter::initialize() {
     esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, VOLTAGE_REFERENCE, adc_chars);
 }
 
+bool BatteryVoltageMeter::isUnderLoad() {
+    if (this->loadPowerSupply == nullptr) {
+        return false;
+    }
+
+    return this->loadPowerSupply->isPoweredOn() || this->loadPowerSupply->getMilisecondsSincePowerOff() < BATTERY_LOAD_RECOVERY_MILISECONDS;
+}
+
+/**
+ * Sagging voltage under load would drag filter and state of charge history down, last resting value is returned instead
+ */
 float BatteryVoltageMeter::getVoltage() {
-    int rawVoltageValue = analogRead(this->batteryVoltageMeterPin);
+    if (this->isUnderLoad() && this->lastReadBatteryVoltage > 0) {
+        return this->lastReadBatteryVoltage;
+    }
+
+    int rawVoltageValue = this->adcSampler->getValue(this->batteryVoltageMeterPin);
     uint32_t voltage = esp_adc_cal_raw_to_voltage(rawVoltageValue, adc_chars);
     float batteryVoltageInmV = voltage * (RESISTOR_FIRST_VALUE + RESISTOR_SECOND_VALUE) / RESISTOR_SECOND_VALUE;
-    float batteryVoltageInV = batteryVoltageInmV / 1000; // mV to V
+    float batteryVoltageInV = this->voltageFilter.update(batteryVoltageInmV / 1000); // mV to V
 
     this->lastReadBatteryVoltage = batteryVoltageInV;
+    this->stateOfCharge.addSample(batteryVoltageInV, time(nullptr));
 
-    return batteryVoltageInV; // mV to V
+    return batteryVoltageInV;
 }
 
 float BatteryVoltageMeter::calculatePercentage(float batteryVoltage) {
-    float batteryPercentage = (batteryVoltage - batteryVoltage0Reference) / (batteryVoltage100Reference - batteryVoltage0Reference) * 100;
-
-    if (batteryPercentage < 0) {
-        batteryPercentage = 0;
-    } else if (batteryPercentage > 100) {
-        batteryPercentage = 100;
-    }
+    return lookupDischargeCurve(batteryVoltage);
+}
 
-    return batteryPercentage;
+BatteryStateOfCharge* BatteryVoltageMeter::getStateOfCharge() {
+    return &this->stateOfCharge;
 }
 
 String BatteryVoltageMeter::getBatteryVoltageMessage() {
-    return String(this->lastReadBatteryVoltage) + "V (" + String(calculatePercentage(this->lastReadBatteryVoltage)) + "%)";
+    char message[BATTERY_VOLTAGE_MESSAGE_LENGTH];
+    this->formatBatteryVoltageMessage(message, sizeof(message));
+
+    return String(message);
+}
+
+void BatteryVoltageMeter::formatBatteryVoltageMessage(char* message, size_t size) {
+    int32_t timeToEmptyMinutes = this->stateOfCharge.getTimeToEmptyMinutes();
+    int length = snprintf(message, size, "%.2fV (%.0f%%)", this->lastReadBatteryVoltage, this->calculatePercentage(this->lastReadBatteryVoltage));
+
+    if (timeToEmptyMinutes != BATTERY_TIME_TO_EMPTY_UNKNOWN && length < (int) size) {
+        snprintf(message + length, size - length, " %dh%02dm left", (int) (timeToEmptyMinutes / 60), (int) (timeToEmptyMinutes % 60));
+    }
+}
+
+ServosPowerSupply* BatteryVoltageMeter::getLoadPowerSupply() {
+    return this->loadPowerSupply;
 }
\ No newline at end of file
@@ -3,23 +3,47 @@
 
 #include <Arduino.h>
 #include <esp_adc_cal.h>
+#include <time.h>
+
+#include <adcSampler.h>
+#include <signalFilters.h>
+#include <batteryStateOfCharge.h>
+#include <servosPowerSupply.h>
 
 #include "config.h"
 
 extern float lastReadBatteryVoltage;
 
+// Variances [V^2], battery drifts slowly between reads while single read is noisy
+const float BATTERY_VOLTAGE_PROCESS_NOISE = 0.00001;
+const float BATTERY_VOLTAGE_MEASUREMENT_NOISE = 0.0004;
+
+const size_t BATTERY_VOLTAGE_MESSAGE_LENGTH = 40; // "4.12V (87%) 12h05m left" with terminator
+
+typedef FilterPipeline<float, MedianFilter<float, 3>, KalmanFilter<float>> BatteryVoltageFilter;
+
+const uint32_t BATTERY_LOAD_RECOVERY_MILISECONDS = 5000; // Voltage rebound after servos power is dropped
+
 class BatteryVoltageMeter {
     public:
-        BatteryVoltageMeter(byte batteryVoltageMeterPin, float batteryVoltage0Reference, float batteryVoltage100Reference, float &lastReadBatteryVoltage);
+        // Load power supply is optional, samples are skipped while it drains the battery
+        BatteryVoltageMeter(AdcSampler* adcSampler, ServosPowerSupply* loadPowerSupply, byte batteryVoltageMeterPin, float &lastReadBatteryVoltage);
         float getVoltage();
         float calculatePercentage(float batteryVoltage);
+        BatteryStateOfCharge* getStateOfCharge();
+        ServosPowerSupply* getLoadPowerSupply(); // nullptr when battery has no switched load
         String getBatteryVoltageMessage();
+        void formatBatteryVoltageMessage(char* message, size_t size);
         void initialize();
     private:
+        AdcSampler* adcSampler;
+        ServosPowerSupply* loadPowerSupply;
         byte batteryVoltageMeterPin;
-        float batteryVoltage0Reference;
-        float batteryVoltage100Reference;
         float &lastReadBatteryVoltage;
+        BatteryVoltageFilter voltageFilter;
+        BatteryStateOfCharge stateOfCharge;
+
+        bool isUnderLoad();
         esp_adc_cal_characteristics_t *adc_chars;
 };
 
@@ -0,0 +1,76 @@
+#include <bleDiagnostics.h>
+
+uint8_t getBootTraceMessagesCount(BootTracer& bootTracer) {
+    uint8_t stagesCount = bootTracer.getStagesCount();
+
+    if (stagesCount == 0) {
+        return 1; // Summary only
+    }
+
+    return (stagesCount + BOOT_TRACE_STAGES_PER_MESSAGE - 1) / BOOT_TRACE_STAGES_PER_MESSAGE;
+}
+
+void writeBootTraceMessage(BootTracer& bootTracer, uint8_t message, JsonDocument& jsonDoc) {
+    uint8_t stagesCount = bootTracer.getStagesCount();
+    uint8_t firstStage = message * BOOT_TRACE_STAGES_PER_MESSAGE;
+
+    jsonDoc["message"] = message;
+    jsonDoc["messagesCount"] = getBootTraceMessagesCount(bootTracer);
+    jsonDoc["bootMs"] = bootTracer.getBootMicroseconds() / 1000;
+    jsonDoc["isFinished"] = bootTracer.isFinished();
+
+    JsonArray jsonStages = jsonDoc["stages"].to<JsonArray>();
+
+    for (uint8_t i = firstStage; i < stagesCount && i < firstStage + BOOT_TRACE_STAGES_PER_MESSAGE; i++) {
+        BootStage stage = bootTracer.getStage(i);
+        JsonArray jsonStage = jsonStages.add<JsonArray>();
+
+        size_t nameLength = strlen(stage.name);
+
+        // Names are static strings, document only links them
+        jsonStage.add(JsonString(stage.name, nameLength < BOOT_TRACE_STAGE_NAME_MAX_LENGTH ? nameLength : BOOT_TRACE_STAGE_NAME_MAX_LENGTH));
+        jsonStage.add(stage.startMicroseconds / 1000);
+
+        if (stage.isFinished) {
+            jsonStage.add(stage.durationMicroseconds / 1000);
+        }
+    }
+}
+
+void writeAllocationsMessage(const HeapSnapshot& heap, const AllocationTotals* totals, const AllocationSite* sites, uint16_t sitesCount, JsonDocument& jsonDoc) {
+    jsonDoc["freeHeap"] = heap.freeHeap;
+    jsonDoc["minimumFreeHeap"] = heap.minimumFreeHeap;
+    jsonDoc["largestFreeBlock"] = heap.largestFreeBlock;
+    jsonDoc["fragmentation"] = roundf(calculateFragmentationRatio(heap.freeHeap, heap.largestFreeBlock) * 1000) / 1000;
+    jsonDoc["tracking"] = totals != nullptr;
+
+    if (totals == nullptr) {
+        return;
+    }
+
+    jsonDoc["allocations"] = totals->allocationsCount;
+    jsonDoc["frees"] = totals->freesCount;
+    jsonDoc["allocatedBytes"] = totals->allocatedBytes;
+    jsonDoc["bytesInFlight"] = totals->bytesInFlight;
+    jsonDoc["peakBytesInFlight"] = totals->peakBytesInFlight;
+    jsonDoc["untracked"] = totals->untrackedCount;
+
+    JsonArray jsonSites = jsonDoc["sites"].to<JsonArray>();
+
+    for (uint16_t i = 0; i < sitesCount && i < ALLOCATIONS_MESSAGE_MAX_SITES; i++) {
+        JsonArray jsonSite = jsonSites.add<JsonArray>();
+
+        if (sites[i].callSite == 0) {
+            jsonSite.add("other");
+        } else {
+            char callSite[2 + 2 * sizeof(uintptr_t) + 1];
+            snprintf(callSite, sizeof(callSite), "0x%lx", (unsigned long) sites[i].callSite);
+
+            jsonSite.add(callSite);
+        }
+
+        jsonSite.add(sites[i].allocationsCount);
+        jsonSite.add(sites[i].liveCount);
+        jsonSite.add(sites[i].bytesInFlight);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef BLE_DIAGNOSTICS_H
+#define BLE_DIAGNOSTICS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <bootTracer.h>
+#include <allocationTracker.h>
+
+/**
+ * Documents of diagnostic BLE commands, each has to fit into one BLE queue message (with envelope)
+ * Stages and sites are compact arrays instead of objects, longer lists are paged over several messages
+ */
+
+const uint8_t BOOT_TRACE_STAGES_PER_MESSAGE = 8;
+const uint8_t ALLOCATIONS_MESSAGE_MAX_SITES = 5; // Top sites by bytes in flight
+const uint8_t BOOT_TRACE_STAGE_NAME_MAX_LENGTH = 16; // Longer names are cut
+
+uint8_t getBootTraceMessagesCount(BootTracer& bootTracer);
+
+// Stages as [name, startMs, durationMs], running stage has no duration
+void writeBootTraceMessage(BootTracer& bootTracer, uint8_t message, JsonDocument& jsonDoc);
+
+struct HeapSnapshot {
+    uint32_t freeHeap;
+    uint32_t minimumFreeHeap;
+    uint32_t largestFreeBlock;
+};
+
+// Sites as [callSite, allocations, live, bytesInFlight], totals are nullptr when tracking is off
+void writeAllocationsMessage(const HeapSnapshot& heap, const AllocationTotals* totals, const AllocationSite* sites, uint16_t sitesCount, JsonDocument& jsonDoc);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <bleResponseQueue.h>
+
+BleResponseQueue::BleResponseQueue(JsonArena& jsonArena): jsonArena(jsonArena), droppedCount(0) {}
+
+bool BleResponseQueue::push(const char* commandType, const char* data) {
+    JsonDocument jsonDoc(&this->jsonArena);
+    JsonObject jsonObject = jsonDoc.add<JsonObject>();
+    jsonObject["commandType"] = commandType;
+    jsonObject["data"] = data;
+
+    if (jsonDoc.overflowed() || measureJson(jsonDoc) >= BLE_QUEUE_MESSAGE_MAX_LENGTH) {
+        this->droppedCount++;
+
+        Serial.print("BLE response is too long, dropped: ");
+        Serial.print(commandType);
+        Serial.print(", dropped so far: ");
+        Serial.println(this->droppedCount);
+
+        return false;
+    }
+
+    if (this->messages.full()) {
+        this->droppedCount++;
+
+        Serial.print("BLE queue is full, response dropped: ");
+        Serial.print(commandType);
+        Serial.print(", dropped so far: ");
+        Serial.println(this->droppedCount);
+
+        return false;
+    }
+
+    this->messages.push_back(BleQueueMessage{});
+    serializeJson(jsonDoc, this->messages.back().text, BLE_QUEUE_MESSAGE_MAX_LENGTH);
+
+    return true;
+}
+
+bool BleResponseQueue::isEmpty() {
+    return this->messages.empty();
+}
+
+const char* BleResponseQueue::front() {
+    return this->messages.front().text;
+}
+
+void BleResponseQueue::pop() {
+    this->messages.erase(0);
+}
+
+uint16_t BleResponseQueue::size() {
+    return this->messages.size();
+}
+
+uint32_t BleResponseQueue::getDroppedCount() {
+    return this->droppedCount;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef BLE_RESPONSE_QUEUE_H
+#define BLE_RESPONSE_QUEUE_H
+
+#include <Arduino.h>
+#include <fixedVector.h>
+#include <jsonArena.h>
+#include <logs.h>
+
+const uint16_t BLE_QUEUE_CAPACITY = MAX_LOGS + 4; // GET_LOGS pushes one response per log, others push one each
+const uint16_t BLE_QUEUE_MESSAGE_MAX_LENGTH = 600; // Characteristic value limit (ESP_GATT_MAX_ATTR_LEN), longer ones were never sent
+
+static_assert(BLE_QUEUE_CAPACITY > MAX_LOGS, "GET_LOGS responses have to fit into BLE queue at once");
+
+// Serialized response, queue keeps them inline
+struct BleQueueMessage {
+    char text[BLE_QUEUE_MESSAGE_MAX_LENGTH];
+};
+
+/**
+ * Responses waiting for notification, envelope is serialized straight into queue slot (no heap)
+ * Responses which are too long or don't fit into full queue are dropped and counted
+ */
+class BleResponseQueue {
+    private:
+        FixedVector<BleQueueMessage, BLE_QUEUE_CAPACITY> messages;
+        JsonArena& jsonArena; // Shared with command handlers, same task
+        uint32_t droppedCount;
+
+    public:
+        BleResponseQueue(JsonArena& jsonArena);
+        bool push(const char* commandType, const char* data);
+        bool isEmpty();
+        const char* front();
+        void pop();
+        uint16_t size();
+        uint32_t getDroppedCount();
+};
+
+#endif
\ No newline at end of file
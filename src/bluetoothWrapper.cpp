@@ -8,6 +8,8 @@
 #include <BLEUtils.h>
 #include <ArduinoJson.h>
 #include <BLE2902.h>
+#include <esp_bt.h>
+#include <esp_heap_caps.h>
 
 #include <bluetoothWrapper.h>
 #include <secrets.h>
@@ -15,15 +17,18 @@
 #include <logs.h>
 #include <memoryData.h>
 #include <helpers.h>
+#include <allocationTracker.h>
+#include <bleDiagnostics.h>
 
 using namespace std;
 
-vector<String> BLEQueue;
 unordered_map<string, MemoryValue*> settingsMemory;
 vector<string> commandTypes = {
   "GET", // GET PROPERTY_NAME
   "SET", // SET PROPERTY_NAME VALUE
   "GET_LOGS", 
+  "GET_LOGS_CHUNKED", // GET_LOGS_CHUNKED [OFFSET]
+  "ACK_LOGS", // ACK_LOGS NEXT_EXPECTED_OFFSET
   "GET_TEMPERATURE", 
   "SET_APP_MODE_AUTO", 
   "SET_APP_MODE_MANUAL", 
@@ -33,9 +38,18 @@ vector<string> commandTypes = {
   "MOVE_BOTH_SERVOS_SMOOTHLY_TO",
   "GET_BATTERY_VOLTAGE_BOX",
   "GET_BATTERY_VOLTAGE_SERVOS",
+  "GET_BATTERY_STATE",
+  "SET_SENSOR_PROFILE", // SET_SENSOR_PROFILE PROFILE (0 - low power forced, 1 - high precision, 2 - fast response)
+  "GET_SENSOR_PROFILES",
+  "CALIBRATE_SENSOR_PROFILES",
+  "GET_BOOT_TRACE",
+  "GET_ALLOCATIONS", // Per call site counters only in ALLOCATION_TRACKING builds
 };
 
-BluetoothWrapper::BluetoothWrapper(Adafruit_BME280* bme, BackgroundApp* backgroundApp, ServoWrapper* servoPullOpen, ServoWrapper* servoPullClose, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos): bme(bme), backgroundApp(backgroundApp), servoPullOpen(servoPullOpen), servoPullClose(servoPullClose), batteryVoltageMeterBox(batteryVoltageMeterBox), batteryVoltageMeterServos(batteryVoltageMeterServos) {}
+BluetoothWrapper::BluetoothWrapper(SensorSampler* sensorSampler, BackgroundApp* backgroundApp, ServoWrapper* servoPullOpen, ServoWrapper* servoPullClose, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos, MotionExecutor* motionExecutor, BootTracer* bootTracer): sensorSampler(sensorSampler), backgroundApp(backgroundApp), servoPullOpen(servoPullOpen), servoPullClose(servoPullClose), batteryVoltageMeterBox(batteryVoltageMeterBox), batteryVoltageMeterServos(batteryVoltageMeterServos), motionExecutor(motionExecutor), bootTracer(bootTracer), logsTransfer(getLogsHistoryFirstSequence, getLogsHistoryNextSequence, readLogRecord), responseQueue(jsonArena) {
+  this->isInitialized = false;
+  this->isLowPowerModeRequested = false;
+}
 
 class WindowOpeningBLEServerCallbacks : public BLEServerCallbacks {
   public:
@@ -77,17 +91,7 @@ class WindowOpeningBLECharacteristicCallbacks : public BLECharacteristicCallback
       auto [response, commandType] = bluetoothWrapper->handleCommand(&valueString);
 
       for (const auto& item : response) {
-        StaticJsonDocument<400> jsonDoc;
-        JsonObject jsonObject = jsonDoc.createNestedObject();
-        jsonObject["commandType"] = commandType;
-        jsonObject["data"] = item;
-
-        String jsonString;
-        serializeJson(jsonDoc, jsonString);
-
-        // noInterrupts();
-        BLEQueue.push_back(jsonString);
-        // interrupts();
+        bluetoothWrapper->queueResponse(commandType, item);
       }
     }
 };
@@ -120,22 +124,93 @@ void BluetoothWrapper::initialize() {
   settingsMemory["OPENING_TERM_POSITIVE_TEMPERATURE_INCREASE"] = &openingTermPositiveTemperatureIncreaseMemory;
   settingsMemory["WARNINGS_ARE_ACTIVE"] = &warningsAreActiveMemory;
   settingsMemory["BATTERY_VOLTAGE_METERS_ARE_ACTIVE"] = &batteryVoltageMetersAreActiveMemory;
+  settingsMemory["LCD_SCROLL_SPEED"] = &lcdScrollSpeedMemory;
+
+  this->isInitialized = true;
+
+  if (this->isLowPowerModeRequested) {
+    this->applyLowPowerMode();
+  }
 
   Serial.println("Bluetooth initialized. Ready for pairing");
 }
 
+/**
+ * Slow advertising and controller modem sleep, connection (if any) is kept
+ */
+void BluetoothWrapper::setLowPowerMode(bool isLowPower) {
+  this->isLowPowerModeRequested = isLowPower;
+
+  if (this->isInitialized) {
+    this->applyLowPowerMode();
+  }
+}
+
+void BluetoothWrapper::applyLowPowerMode() {
+  bool isLowPower = this->isLowPowerModeRequested;
+  BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
+
+  pAdvertising->setMinInterval(isLowPower ? BLE_ADVERTISING_LOW_POWER_MIN_INTERVAL : BLE_ADVERTISING_DEFAULT_MIN_INTERVAL);
+  pAdvertising->setMaxInterval(isLowPower ? BLE_ADVERTISING_LOW_POWER_MAX_INTERVAL : BLE_ADVERTISING_DEFAULT_MAX_INTERVAL);
+
+  // New intervals are applied on advertising restart
+  if (!isBLEClientConnected) {
+    pAdvertising->stop();
+    pAdvertising->start();
+  }
+
+  esp_err_t result = isLowPower ? esp_bt_sleep_enable() : esp_bt_sleep_disable();
+
+  if (result != ESP_OK) {
+    Serial.println("BLE modem sleep not supported");
+  }
+}
+
+void BluetoothWrapper::queueResponse(const String& commandType, const String& data) {
+  this->responseQueue.push(commandType.c_str(), data.c_str());
+}
+
+/**
+ * Document is built in JSON arena, only the result is copied to heap (command handlers return String)
+ */
+String BluetoothWrapper::serializeResponse(JsonDocument& jsonDoc) {
+  if (jsonDoc.overflowed()) {
+    Serial.println("BLE response does not fit into JSON arena, it is incomplete");
+  }
+
+  String jsonString;
+  serializeJson(jsonDoc, jsonString);
+
+  return jsonString;
+}
+
+/**
+ * Sends chunks until the window is full (client has to acknowledge) or everything is sent
+ */
+void BluetoothWrapper::sendLogsTransferMessages() {
+  uint16_t length;
+
+  while ((length = this->logsTransfer.buildNextMessage(millis())) > 0) {
+    this->pCharacteristic->setValue((uint8_t*) this->logsTransfer.getMessage(), length);
+    this->pCharacteristic->notify();
+  }
+}
+
 void BluetoothWrapper::checkQueue() {
-  if (BLEQueue.empty()) return;
+  if (this->responseQueue.isEmpty()) {
+    // Logs transfer only uses the link when there is nothing else to send
+    this->sendLogsTransferMessages();
+    return;
+  }
 
-  String firstMessage = BLEQueue.front();
-  const char* firstMessageChar = firstMessage.c_str();
+  const char* firstMessageChar = this->responseQueue.front();
 
   Serial.println("Notify BLE with: ");
   Serial.println(firstMessageChar);
 
   this->pCharacteristic->setValue(firstMessageChar);
   this->pCharacteristic->notify();
-  BLEQueue.erase(BLEQueue.begin());
+  this->responseQueue.pop();
 }
 
 tuple<vector<String>, String> BluetoothWrapper::handleCommand(String* message) {
@@ -159,6 +234,8 @@ tuple<vector<String>, String> BluetoothWrapper::handleCommand(String* message) {
 
   MemoryValue* memoryData = nullptr;
   uint8_t newServosPosition;
+  uint32_t logsOffset = 0;
+  int sensorProfile = 0;
 
   if (commandType == "SET" || commandType == "GET") {
     string property = trim(parts.at(1));
@@ -182,6 +259,24 @@ tuple<vector<String>, String> BluetoothWrapper::handleCommand(String* message) {
     }
   }
 
+  if ((commandType == "GET_LOGS_CHUNKED" && parts.size() == 2) || commandType == "ACK_LOGS") {
+    try {
+      logsOffset = stoul(trim(parts.at(1)));
+    } catch (std::exception& error) {
+      Serial.println(error.what());
+      response.push_back("Invalid Offset");
+    }
+  }
+
+  if (commandType == "SET_SENSOR_PROFILE") {
+    try {
+      sensorProfile = stoi(trim(parts.at(1)));
+    } catch (std::exception& error) {
+      Serial.println(error.what());
+      response.push_back("Invalid Sensor Profile");
+    }
+  }
+
   // If any error exit execution
   if (response.size() > 0) {
     return make_tuple(response, String('ERROR'));
@@ -196,6 +291,11 @@ tuple<vector<String>, String> BluetoothWrapper::handleCommand(String* message) {
     response = handleGetLogsCommand(); // Multiple
 
     return make_tuple(response, commandType.c_str());
+  } else if (commandType == "GET_LOGS_CHUNKED") {
+    response.push_back(handleGetLogsChunkedCommand(logsOffset));
+  } else if (commandType == "ACK_LOGS") {
+    // No response, chunks are the answer
+    handleAckLogsCommand(logsOffset);
   } else if (commandType == "GET_TEMPERATURE") {
     response.push_back(handleGetTemperatureCommand());
   } else if (commandType == "SET_APP_MODE_AUTO") {
@@ -214,6 +314,18 @@ tuple<vector<String>, String> BluetoothWrapper::handleCommand(String* message) {
     response.push_back(handleGetBatteryVoltageCommand(batteryVoltageMeterBox));
   } else if (commandType == "GET_BATTERY_VOLTAGE_SERVOS") {
     response.push_back(handleGetBatteryVoltageCommand(batteryVoltageMeterServos));
+  } else if (commandType == "GET_BATTERY_STATE") {
+    response.push_back(handleGetBatteryStateCommand());
+  } else if (commandType == "GET_BOOT_TRACE") {
+    response = handleGetBootTraceCommand(); // Multiple
+  } else if (commandType == "GET_ALLOCATIONS") {
+    response.push_back(handleGetAllocationsCommand());
+  } else if (commandType == "SET_SENSOR_PROFILE") {
+    response.push_back(handleSetSensorProfileCommand(sensorProfile));
+  } else if (commandType == "GET_SENSOR_PROFILES") {
+    response.push_back(handleGetSensorProfilesCommand());
+  } else if (commandType == "CALIBRATE_SENSOR_PROFILES") {
+    response.push_back(handleCalibrateSensorProfilesCommand());
   } else {
     response.push_back(handleInvalidCommand());
   }
@@ -261,6 +373,24 @@ vector<string> BluetoothWrapper::splitString(const String* command) {
     return vector<string>();
   }
 
+  if (commandType == "ACK_LOGS" && parts.size() != 2) {
+    Serial.println("Invalid command: ACK_LOGS parts different from 2");
+
+    return vector<string>();
+  }
+
+  if (commandType == "GET_LOGS_CHUNKED" && parts.size() > 2) {
+    Serial.println("Invalid command: GET_LOGS_CHUNKED parts more than 2");
+
+    return vector<string>();
+  }
+
+  if (commandType == "SET_SENSOR_PROFILE" && parts.size() != 2) {
+    Serial.println("Invalid command: SET_SENSOR_PROFILE parts different from 2");
+
+    return vector<string>();
+  }
+
   if (commandType == "GET" && parts.size() != 2) {
     Serial.println("Invalid command: GET parts different from 2");
 
@@ -295,11 +425,11 @@ String BluetoothWrapper::handleGetCommand(MemoryValue* memoryData) {
 }
 
 vector<String> BluetoothWrapper::handleGetLogsCommand() {
-  vector<Log> lastLogs = getLastLogs(10);
+  vector<Log> lastLogs = getLastLogs(MAX_LOGS);
   vector<String> response;
 
   for (const auto& log: lastLogs) {
-    StaticJsonDocument<300> jsonDoc;
+    JsonDocument jsonDoc(&this->jsonArena);
     JsonArray jsonLogs = jsonDoc.createNestedArray("logs");
 
     Serial.print("Date: ");
@@ -318,17 +448,25 @@ vector<String> BluetoothWrapper::handleGetLogsCommand() {
     jsonLogObject["windowOpening"] = log.windowOpening;
     jsonLogObject["deltaTemporaryWindowOpening"] = log.deltaTemporaryWindowOpening;
 
-    String jsonString;
-    serializeJson(jsonDoc, jsonString);
-
-    response.push_back(jsonString);
+    response.push_back(this->serializeResponse(jsonDoc));
   }
 
   return response;
 }
 
+String BluetoothWrapper::handleGetLogsChunkedCommand(uint32_t offset) {
+  uint32_t startOffset = this->logsTransfer.start(offset, millis());
+
+  return "Logs transfer started from offset: " + String(startOffset) + " to: " + String(this->logsTransfer.getEndOffset());
+}
+
+void BluetoothWrapper::handleAckLogsCommand(uint32_t offset) {
+  this->logsTransfer.acknowledge(offset, millis());
+}
+
 String BluetoothWrapper::handleGetTemperatureCommand() {
-  float temperature = bme->readTemperature();
+  // Cached by sampler, BLE callback never touches I2C
+  float temperature = sensorSampler->getSnapshot().reading.temperature;
 
   Serial.println(temperature);
   return String(temperature);
@@ -364,7 +502,7 @@ String BluetoothWrapper::handleGetLastWeatherLogCommand() {
     return "No weather logs available";
   }
 
-  StaticJsonDocument<200> jsonDoc;
+  JsonDocument jsonDoc(&this->jsonArena);
   JsonObject jsonLogObject = jsonDoc.createNestedObject();
 
   jsonLogObject["forecastDate"] = weatherLog->forecastDate;
@@ -390,10 +528,7 @@ String BluetoothWrapper::handleGetLastWeatherLogCommand() {
   Serial.print("pm10Date: ");
   Serial.println(weatherLog->pm10Date);
   
-  String jsonString;
-  serializeJson(jsonDoc, jsonString);
-
-  return jsonString;
+  return this->serializeResponse(jsonDoc);
 }
 
 String BluetoothWrapper::handleForceOpeningWindowCalculationCommand() {
@@ -404,8 +539,11 @@ String BluetoothWrapper::handleForceOpeningWindowCalculationCommand() {
 }
 
 String BluetoothWrapper::handleMoveBothServosSmoothlyTo(uint8_t newPosition) {
-  servoPullOpen->setMovingSmoothlyTarget(newPosition);
-  servoPullClose->setMovingSmoothlyTarget(newPosition);
+  MotionPlan plan;
+  plan.addAxis(servoPullOpen, newPosition);
+  plan.addAxis(servoPullClose, newPosition);
+
+  motionExecutor->submit(plan);
 
   Serial.print("New target set up: ");
   Serial.println(newPosition);
@@ -419,7 +557,136 @@ String BluetoothWrapper::handleGetBatteryVoltageCommand(BatteryVoltageMeter* bat
   return batteryVoltageMeter->getBatteryVoltageMessage();
 }
 
+/**
+ * Voltages are resting ones, time to empty is missing until there is enough discharge history
+ */
+String BluetoothWrapper::handleGetBatteryStateCommand() {
+  JsonDocument jsonDoc(&this->jsonArena);
+  BatteryVoltageMeter* batteryVoltageMeters[] = { batteryVoltageMeterBox, batteryVoltageMeterServos };
+  const char* names[] = { "box", "servos" };
+
+  for (uint8_t i = 0; i < 2; i++) {
+    float voltage = batteryVoltageMeters[i]->getVoltage();
+    BatteryStateOfCharge* stateOfCharge = batteryVoltageMeters[i]->getStateOfCharge();
+    JsonObject jsonBattery = jsonDoc[names[i]].to<JsonObject>();
+
+    jsonBattery["voltage"] = voltage;
+    jsonBattery["percentage"] = stateOfCharge->getPercentage();
+    jsonBattery["dischargeRatePerHour"] = stateOfCharge->getDischargeRatePerHour();
+    jsonBattery["historyPoints"] = stateOfCharge->getHistoryCount();
+
+    int32_t timeToEmptyMinutes = stateOfCharge->getTimeToEmptyMinutes();
+
+    if (timeToEmptyMinutes != BATTERY_TIME_TO_EMPTY_UNKNOWN) {
+      jsonBattery["timeToEmptyMinutes"] = timeToEmptyMinutes;
+    }
+
+    ServosPowerSupply* loadPowerSupply = batteryVoltageMeters[i]->getLoadPowerSupply();
+
+    if (loadPowerSupply != nullptr) {
+      ServosPowerStatistics statistics = loadPowerSupply->getStatistics();
+      JsonObject jsonLoad = jsonBattery["load"].to<JsonObject>();
+
+      jsonLoad["movesCount"] = statistics.movesCount;
+      jsonLoad["totalOnTimeMiliseconds"] = statistics.totalOnTimeMiliseconds;
+      jsonLoad["totalEnergyJoules"] = roundf(statistics.totalEnergyJoules * 10) / 10;
+      jsonLoad["lastMoveOnTimeMiliseconds"] = statistics.lastMoveOnTimeMiliseconds;
+      jsonLoad["lastMoveEnergyJoules"] = roundf(statistics.lastMoveEnergyJoules * 100) / 100;
+    }
+  }
+
+  return this->serializeResponse(jsonDoc);
+}
+
+String BluetoothWrapper::handleSetSensorProfileCommand(int profile) {
+  if (!sensorSampler->setProfile(profile)) {
+    Serial.println("Invalid sensor profile");
+    return "Invalid sensor profile";
+  }
+
+  Serial.print("Sensor profile changed to: ");
+  Serial.println(SENSOR_PROFILES[profile].name);
+  return "Sensor profile changed to: " + String(SENSOR_PROFILES[profile].name);
+}
+
+/**
+ * Current draw is estimated from datasheet, noise is known only after calibration
+ */
+String BluetoothWrapper::handleGetSensorProfilesCommand() {
+  JsonDocument jsonDoc(&this->jsonArena);
+  JsonArray jsonProfiles = jsonDoc.to<JsonArray>();
+  SensorProfile activeProfile = sensorSampler->getProfile();
+
+  for (uint8_t profile = 0; profile < SENSOR_PROFILES_COUNT; profile++) {
+    SensorProfileCalibration calibration = sensorSampler->getCalibration(profile);
+    JsonObject jsonProfile = jsonProfiles.add<JsonObject>();
+
+    jsonProfile["profile"] = profile;
+    jsonProfile["name"] = SENSOR_PROFILES[profile].name;
+    jsonProfile["active"] = profile == activeProfile;
+    jsonProfile["samplingIntervalMiliseconds"] = SENSOR_PROFILES[profile].samplingIntervalMiliseconds;
+    jsonProfile["estimatedCurrentMicroamperes"] = estimateSensorCurrentMicroamperes(SENSOR_PROFILES[profile]);
+
+    if (calibration.isCalibrated) {
+      jsonProfile["temperatureStddev"] = calibration.temperatureStddev;
+      jsonProfile["pressureStddev"] = calibration.pressureStddev;
+      jsonProfile["humidityStddev"] = calibration.humidityStddev;
+    }
+  }
+
+  return this->serializeResponse(jsonDoc);
+}
+
+String BluetoothWrapper::handleCalibrateSensorProfilesCommand() {
+  sensorSampler->requestCalibration();
+
+  Serial.println("Sensor profiles calibration requested");
+  return "Sensor profiles calibration requested";
+}
+
 String BluetoothWrapper::handleInvalidCommand() {
   Serial.println("Invalid command");
   return "Invalid command";
+}
+
+/**
+ * Stages still running (background init) have no duration yet
+ */
+vector<String> BluetoothWrapper::handleGetBootTraceCommand() {
+  vector<String> response;
+
+  for (uint8_t i = 0; i < getBootTraceMessagesCount(*bootTracer); i++) {
+    JsonDocument jsonDoc(&this->jsonArena);
+    writeBootTraceMessage(*bootTracer, i, jsonDoc);
+
+    response.push_back(this->serializeResponse(jsonDoc));
+  }
+
+  return response;
+}
+
+/**
+ * Call sites are return addresses, decode them with addr2line against firmware.elf of the same build
+ */
+String BluetoothWrapper::handleGetAllocationsCommand() {
+  JsonDocument jsonDoc(&this->jsonArena);
+
+  HeapSnapshot heap = HeapSnapshot{
+    freeHeap: heap_caps_get_free_size(MALLOC_CAP_8BIT),
+    minimumFreeHeap: heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+    largestFreeBlock: heap_caps_get_largest_free_block(MALLOC_CAP_8BIT)
+  };
+
+#ifdef ALLOCATION_TRACKING
+  // Snapshot first, JSON document allocates too
+  AllocationTotals totals = getAllocationTotals();
+  AllocationSite sites[ALLOCATIONS_MESSAGE_MAX_SITES];
+  uint16_t sitesCount = getTopAllocationSites(sites, ALLOCATIONS_MESSAGE_MAX_SITES);
+
+  writeAllocationsMessage(heap, &totals, sites, sitesCount, jsonDoc);
+#else
+  writeAllocationsMessage(heap, nullptr, nullptr, 0, jsonDoc);
+#endif
+
+  return this->serializeResponse(jsonDoc);
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 #include <vector>
 #include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
+#include <sensorSampler.h>
 #include <BluetoothSerial.h>
 #include <BLEServer.h>
 
@@ -12,17 +12,36 @@
 #include <weatherLogs.h>
 #include <servoWrapper.h>
 #include <batteryVoltageMeter.h>
+#include <logsTransfer.h>
+#include <motionExecutor.h>
+#include <bootTracer.h>
+#include <jsonArena.h>
+#include <bleResponseQueue.h>
 using namespace std;
 
+// Advertising interval units (0.625 ms)
+const uint16_t BLE_ADVERTISING_DEFAULT_MIN_INTERVAL = 0x20; // 20 ms
+const uint16_t BLE_ADVERTISING_DEFAULT_MAX_INTERVAL = 0x40; // 40 ms
+const uint16_t BLE_ADVERTISING_LOW_POWER_MIN_INTERVAL = 0x640; // 1 s
+const uint16_t BLE_ADVERTISING_LOW_POWER_MAX_INTERVAL = 0x800; // 1.28 s
+const size_t BLE_JSON_ARENA_SIZE = 4096; // Largest response takes two 1 kB pools
+
 class BluetoothWrapper {
   private:
     BLECharacteristic *pCharacteristic;
-    Adafruit_BME280* bme;
+    SensorSampler* sensorSampler;
     BackgroundApp* backgroundApp;
     ServoWrapper* servoPullOpen;
     ServoWrapper* servoPullClose;
     BatteryVoltageMeter* batteryVoltageMeterBox;
     BatteryVoltageMeter* batteryVoltageMeterServos;
+    MotionExecutor* motionExecutor;
+    BootTracer* bootTracer;
+    LogsTransfer logsTransfer;
+    volatile bool isInitialized;
+    volatile bool isLowPowerModeRequested; // Applied once initialized (initialization runs in its own task)
+
+    void applyLowPowerMode();
 
     vector<string> splitString(const String* command);
     string trim(const string& str);
@@ -30,6 +49,8 @@ class BluetoothWrapper {
     String handleSetCommand(MemoryValue* memoryData, int value);
     String handleGetCommand(MemoryValue* memoryData);
     vector<String> handleGetLogsCommand();
+    String handleGetLogsChunkedCommand(uint32_t offset);
+    void handleAckLogsCommand(uint32_t offset);
     String handleGetTemperatureCommand();
     String handleSetAppModeAutoCommand();
     String handleSetAppModeManualCommand();
@@ -38,13 +59,26 @@ class BluetoothWrapper {
     String handleForceOpeningWindowCalculationCommand();
     String handleMoveBothServosSmoothlyTo(uint8_t newPosition);
     String handleGetBatteryVoltageCommand(BatteryVoltageMeter* batteryVoltageMeter);
+    String handleGetBatteryStateCommand();
+    String handleSetSensorProfileCommand(int profile);
+    String handleGetSensorProfilesCommand();
+    String handleCalibrateSensorProfilesCommand();
+    vector<String> handleGetBootTraceCommand();
+    String handleGetAllocationsCommand();
 
     String handleInvalidCommand();
 
+    StaticJsonArena<BLE_JSON_ARENA_SIZE> jsonArena; // Used only from BLE callbacks task
+    BleResponseQueue responseQueue;
+    String serializeResponse(JsonDocument& jsonDoc);
+    void sendLogsTransferMessages();
+
   public:
-    BluetoothWrapper(Adafruit_BME280* bme, BackgroundApp* backgroundApp, ServoWrapper* servoPullOpen, ServoWrapper* servoPullClose, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos);
+    BluetoothWrapper(SensorSampler* sensorSampler, BackgroundApp* backgroundApp, ServoWrapper* servoPullOpen, ServoWrapper* servoPullClose, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos, MotionExecutor* motionExecutor, BootTracer* bootTracer);
     void initialize();
+    void setLowPowerMode(bool isLowPower);
     tuple<vector<String>, String> handleCommand(String* message);
+    void queueResponse(const String& commandType, const String& data);
     void checkQueue();
 };
 
@@ -0,0 +1,98 @@
+#include <bme280Compensation.h>
+
+Bme280Reading Bme280Compensation::compensate(const uint8_t* rawData, const Bme280Calibration& calibration, int32_t tFineAdjust, int32_t& tFine) {
+    int32_t adcP = uint32_t(rawData[0]) << 16 | uint32_t(rawData[1]) << 8 | uint32_t(rawData[2]);
+    int32_t adcT = uint32_t(rawData[3]) << 16 | uint32_t(rawData[4]) << 8 | uint32_t(rawData[5]);
+    int32_t adcH = uint16_t(rawData[6]) << 8 | uint16_t(rawData[7]);
+
+    float temperature = compensateTemperature(adcT, calibration, tFineAdjust, tFine);
+
+    // Pressure and humidity need t_fine
+    if (isnan(temperature)) {
+        return Bme280Reading{ temperature: NAN, pressure: NAN, humidity: NAN };
+    }
+
+    return Bme280Reading{
+        temperature: temperature,
+        pressure: compensatePressure(adcP, calibration, tFine),
+        humidity: compensateHumidity(adcH, calibration, tFine)
+    };
+}
+
+float Bme280Compensation::compensateTemperature(int32_t adcT, const Bme280Calibration& calibration, int32_t tFineAdjust, int32_t& tFine) {
+    int32_t var1, var2;
+
+    if (adcT == 0x800000) { // Temperature measurement disabled
+        return NAN;
+    }
+
+    adcT >>= 4;
+
+    var1 = (int32_t)((adcT / 8) - ((int32_t)calibration.digT1 * 2));
+    var1 = (var1 * ((int32_t)calibration.digT2)) / 2048;
+    var2 = (int32_t)((adcT / 16) - ((int32_t)calibration.digT1));
+    var2 = (((var2 * var2) / 4096) * ((int32_t)calibration.digT3)) / 16384;
+
+    tFine = var1 + var2 + tFineAdjust;
+
+    int32_t temperature = (tFine * 5 + 128) / 256;
+
+    return (float)temperature / 100;
+}
+
+float Bme280Compensation::compensatePressure(int32_t adcP, const Bme280Calibration& calibration, int32_t tFine) {
+    int64_t var1, var2, var3, var4;
+
+    if (adcP == 0x800000) { // Pressure measurement disabled
+        return NAN;
+    }
+
+    adcP >>= 4;
+
+    var1 = ((int64_t)tFine) - 128000;
+    var2 = var1 * var1 * (int64_t)calibration.digP6;
+    var2 = var2 + ((var1 * (int64_t)calibration.digP5) * 131072);
+    var2 = var2 + (((int64_t)calibration.digP4) * 34359738368);
+    var1 = ((var1 * var1 * (int64_t)calibration.digP3) / 256) + ((var1 * ((int64_t)calibration.digP2) * 4096));
+    var3 = ((int64_t)1) * 140737488355328;
+    var1 = (var3 + var1) * ((int64_t)calibration.digP1) / 8589934592;
+
+    if (var1 == 0) {
+        return 0; // Avoid division by zero
+    }
+
+    var4 = 1048576 - adcP;
+    var4 = (((var4 * 2147483648) - var2) * 3125) / var1;
+    var1 = (((int64_t)calibration.digP9) * (var4 / 8192) * (var4 / 8192)) / 33554432;
+    var2 = (((int64_t)calibration.digP8) * var4) / 524288;
+    var4 = ((var4 + var1 + var2) / 256) + (((int64_t)calibration.digP7) * 16);
+
+    return var4 / 256.0;
+}
+
+float Bme280Compensation::compensateHumidity(int32_t adcH, const Bme280Calibration& calibration, int32_t tFine) {
+    int32_t var1, var2, var3, var4, var5;
+
+    if (adcH == 0x8000) { // Humidity measurement disabled
+        return NAN;
+    }
+
+    var1 = tFine - ((int32_t)76800);
+    var2 = (int32_t)(adcH * 16384);
+    var3 = (int32_t)(((int32_t)calibration.digH4) * 1048576);
+    var4 = ((int32_t)calibration.digH5) * var1;
+    var5 = (((var2 - var3) - var4) + (int32_t)16384) / 32768;
+    var2 = (var1 * ((int32_t)calibration.digH6)) / 1024;
+    var3 = (var1 * ((int32_t)calibration.digH3)) / 2048;
+    var4 = ((var2 * (var3 + (int32_t)32768)) / 1024) + (int32_t)2097152;
+    var2 = ((var4 * ((int32_t)calibration.digH2)) + 8192) / 16384;
+    var3 = var5 * var2;
+    var4 = ((var3 / 32768) * (var3 / 32768)) / 128;
+    var5 = var3 - ((var4 * ((int32_t)calibration.digH1)) / 16);
+    var5 = (var5 < 0 ? 0 : var5);
+    var5 = (var5 > 419430400 ? 419430400 : var5);
+
+    uint32_t humidity = (uint32_t)(var5 / 4096);
+
+    return (float)humidity / 1024.0;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef BME280_COMPENSATION_H
+#define BME280_COMPENSATION_H
+
+#include <Arduino.h>
+
+// Burst of data registers 0xF7 - 0xFE (press_msb ... hum_lsb)
+const uint8_t BME280_DATA_BURST_LENGTH = 8;
+
+struct Bme280Calibration {
+    uint16_t digT1;
+    int16_t digT2;
+    int16_t digT3;
+
+    uint16_t digP1;
+    int16_t digP2;
+    int16_t digP3;
+    int16_t digP4;
+    int16_t digP5;
+    int16_t digP6;
+    int16_t digP7;
+    int16_t digP8;
+    int16_t digP9;
+
+    uint8_t digH1;
+    int16_t digH2;
+    uint8_t digH3;
+    int16_t digH4;
+    int16_t digH5;
+    int8_t digH6;
+};
+
+struct Bme280Reading {
+    float temperature; // *C
+    float pressure; // Pa
+    float humidity; // %
+};
+
+/**
+ * Same integer math as per-field reads of Adafruit_BME280, but all three values share one t_fine
+ * Disabled measurements are returned as NAN
+ */
+namespace Bme280Compensation {
+    Bme280Reading compensate(const uint8_t* rawData, const Bme280Calibration& calibration, int32_t tFineAdjust, int32_t& tFine);
+    float compensateTemperature(int32_t adcT, const Bme280Calibration& calibration, int32_t tFineAdjust, int32_t& tFine);
+    float compensatePressure(int32_t adcP, const Bme280Calibration& calibration, int32_t tFine);
+    float compensateHumidity(int32_t adcH, const Bme280Calibration& calibration, int32_t tFine);
+}
+
+#endif
\ No newline at end of file
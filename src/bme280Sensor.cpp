@@ -0,0 +1,210 @@
+#include <bme280Sensor.h>
+
+Bme280Sensor::Bme280Sensor(): Adafruit_BME280() {
+    this->measurementCallback = nullptr;
+    this->measurementCallbackContext = nullptr;
+    this->measurementStatus = Bme280MeasurementIdle;
+    this->measurementStartMillis = 0;
+
+#ifdef ESP_PLATFORM
+    this->measurementTimer = nullptr;
+#endif
+}
+
+bool Bme280Sensor::begin(uint8_t address, TwoWire* wire) {
+    if (!Adafruit_BME280::begin(address, wire)) {
+        return false;
+    }
+
+    this->copyCalibration();
+    this->createMeasurementTimer();
+
+    return true;
+}
+
+/**
+ * Sensor kept its registers through deep sleep of ESP, so soft reset, coefficients read and settle delays of begin() are skipped
+ */
+bool Bme280Sensor::resume(uint8_t address, TwoWire* wire, const Bme280Calibration& calibration) {
+    if (this->i2c_dev == nullptr) {
+        this->i2c_dev = new Adafruit_I2CDevice(address, wire);
+    }
+
+    if (!this->i2c_dev->begin()) {
+        return false;
+    }
+
+    this->_sensorID = this->read8(BME280_REGISTER_CHIPID);
+
+    if (this->_sensorID != 0x60) {
+        return false;
+    }
+
+    this->calibration = calibration;
+    this->restoreCalibration();
+    this->createMeasurementTimer();
+
+    return true;
+}
+
+void Bme280Sensor::restoreCalibration() {
+    this->_bme280_calib.dig_T1 = this->calibration.digT1;
+    this->_bme280_calib.dig_T2 = this->calibration.digT2;
+    this->_bme280_calib.dig_T3 = this->calibration.digT3;
+    this->_bme280_calib.dig_P1 = this->calibration.digP1;
+    this->_bme280_calib.dig_P2 = this->calibration.digP2;
+    this->_bme280_calib.dig_P3 = this->calibration.digP3;
+    this->_bme280_calib.dig_P4 = this->calibration.digP4;
+    this->_bme280_calib.dig_P5 = this->calibration.digP5;
+    this->_bme280_calib.dig_P6 = this->calibration.digP6;
+    this->_bme280_calib.dig_P7 = this->calibration.digP7;
+    this->_bme280_calib.dig_P8 = this->calibration.digP8;
+    this->_bme280_calib.dig_P9 = this->calibration.digP9;
+    this->_bme280_calib.dig_H1 = this->calibration.digH1;
+    this->_bme280_calib.dig_H2 = this->calibration.digH2;
+    this->_bme280_calib.dig_H3 = this->calibration.digH3;
+    this->_bme280_calib.dig_H4 = this->calibration.digH4;
+    this->_bme280_calib.dig_H5 = this->calibration.digH5;
+    this->_bme280_calib.dig_H6 = this->calibration.digH6;
+}
+
+void Bme280Sensor::copyCalibration() {
+    this->calibration = Bme280Calibration{
+        digT1: this->_bme280_calib.dig_T1,
+        digT2: this->_bme280_calib.dig_T2,
+        digT3: this->_bme280_calib.dig_T3,
+        digP1: this->_bme280_calib.dig_P1,
+        digP2: this->_bme280_calib.dig_P2,
+        digP3: this->_bme280_calib.dig_P3,
+        digP4: this->_bme280_calib.dig_P4,
+        digP5: this->_bme280_calib.dig_P5,
+        digP6: this->_bme280_calib.dig_P6,
+        digP7: this->_bme280_calib.dig_P7,
+        digP8: this->_bme280_calib.dig_P8,
+        digP9: this->_bme280_calib.dig_P9,
+        digH1: this->_bme280_calib.dig_H1,
+        digH2: this->_bme280_calib.dig_H2,
+        digH3: this->_bme280_calib.dig_H3,
+        digH4: this->_bme280_calib.dig_H4,
+        digH5: this->_bme280_calib.dig_H5,
+        digH6: this->_bme280_calib.dig_H6
+    };
+}
+
+/**
+ * Registers 0xF7 - 0xFE in one transaction, sensor keeps them consistent during burst read
+ */
+Bme280Reading Bme280Sensor::readAll() {
+    uint8_t buffer[BME280_DATA_BURST_LENGTH];
+
+    if (this->i2c_dev) {
+        buffer[0] = BME280_REGISTER_PRESSUREDATA;
+
+        if (!this->i2c_dev->write_then_read(buffer, 1, buffer, BME280_DATA_BURST_LENGTH)) {
+            return Bme280Reading{ temperature: NAN, pressure: NAN, humidity: NAN };
+        }
+    } else {
+        buffer[0] = BME280_REGISTER_PRESSUREDATA | 0x80;
+        this->spi_dev->write_then_read(buffer, 1, buffer, BME280_DATA_BURST_LENGTH);
+    }
+
+    return Bme280Compensation::compensate(buffer, this->calibration, this->t_fine_adjust, this->t_fine);
+}
+
+Bme280Calibration Bme280Sensor::getCalibration() {
+    return this->calibration;
+}
+
+/**
+ * Maximum conversion time for current oversampling settings
+ */
+uint32_t Bme280Sensor::getMeasurementTimeMicroseconds() {
+    return calculateMeasurementTimeMicroseconds(this->_measReg.osrs_t, this->_measReg.osrs_p, this->_humReg.osrs_h);
+}
+
+/**
+ * Triggers conversion and returns immediately, returns expected conversion time (0 if not in forced mode)
+ */
+uint32_t Bme280Sensor::startForcedMeasurement() {
+    if (this->_measReg.mode != MODE_FORCED) {
+        this->measurementStatus = Bme280MeasurementIdle;
+        return 0;
+    }
+
+    this->write8(BME280_REGISTER_CONTROL, this->_measReg.get());
+
+    this->measurementStatus = Bme280MeasurementPending;
+    this->measurementStartMillis = millis();
+
+    uint32_t expectedMiliseconds = (this->getMeasurementTimeMicroseconds() + 999) / 1000;
+    this->armMeasurementTimer(expectedMiliseconds);
+
+    return expectedMiliseconds;
+}
+
+/**
+ * Never blocks, status register is read only after expected conversion time
+ */
+Bme280MeasurementStatus Bme280Sensor::pollForcedMeasurement(Bme280Reading& reading) {
+    if (this->measurementStatus != Bme280MeasurementPending) {
+        return this->measurementStatus;
+    }
+
+    unsigned long elapsedMiliseconds = millis() - this->measurementStartMillis;
+
+    if (elapsedMiliseconds * 1000 < this->getMeasurementTimeMicroseconds()) {
+        return Bme280MeasurementPending;
+    }
+
+    if (this->read8(BME280_REGISTER_STATUS) & 0x08) { // Still measuring
+        if (elapsedMiliseconds > BME280_FORCED_MEASUREMENT_TIMEOUT_MILISECONDS) {
+            this->measurementStatus = Bme280MeasurementFailed;
+            return this->measurementStatus;
+        }
+
+        this->armMeasurementTimer(BME280_STATUS_RECHECK_MILISECONDS);
+        return Bme280MeasurementPending;
+    }
+
+    reading = this->readAll();
+    this->measurementStatus = Bme280MeasurementReady;
+
+    return this->measurementStatus;
+}
+
+/**
+ * Called from timer service task when measurement is expected to be ready, must not block
+ */
+void Bme280Sensor::attachMeasurementCallback(void (*callback)(void* context), void* context) {
+    this->measurementCallback = callback;
+    this->measurementCallbackContext = context;
+}
+
+void Bme280Sensor::createMeasurementTimer() {
+#ifdef ESP_PLATFORM
+    if (this->measurementTimer == nullptr) {
+        this->measurementTimer = xTimerCreate("Bme280MeasurementTimer", 1, pdFALSE, this, Bme280Sensor::measurementTimerCallback);
+    }
+#endif
+}
+
+void Bme280Sensor::armMeasurementTimer(uint32_t miliseconds) {
+#ifdef ESP_PLATFORM
+    if (this->measurementTimer == nullptr) {
+        return;
+    }
+
+    TickType_t ticks = miliseconds / portTICK_PERIOD_MS;
+    xTimerChangePeriod(this->measurementTimer, ticks > 0 ? ticks : 1, 0); // Also starts timer
+#endif
+}
+
+#ifdef ESP_PLATFORM
+void Bme280Sensor::measurementTimerCallback(TimerHandle_t timer) {
+    Bme280Sensor* sensor = static_cast<Bme280Sensor*>(pvTimerGetTimerID(timer));
+
+    if (sensor->measurementCallback != nullptr) {
+        sensor->measurementCallback(sensor->measurementCallbackContext);
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef BME280_SENSOR_H
+#define BME280_SENSOR_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_BME280.h>
+
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+#endif
+
+#include <bme280Compensation.h>
+#include <sensorProfiles.h>
+
+const uint32_t BME280_FORCED_MEASUREMENT_TIMEOUT_MILISECONDS = 2000; // Same as blocking takeForcedMeasurement()
+const uint32_t BME280_STATUS_RECHECK_MILISECONDS = 2;
+
+enum Bme280MeasurementStatus {
+    Bme280MeasurementIdle,
+    Bme280MeasurementPending,
+    Bme280MeasurementReady,
+    Bme280MeasurementFailed
+};
+
+/**
+ * Adafruit_BME280 with burst read of all data registers
+ * readPressure() / readHumidity() read temperature again on their own, readAll() takes single I2C transaction
+ *
+ * Forced measurement can be also taken without busy-polling the status register:
+ * startForcedMeasurement() triggers conversion and arms one-shot timer for expected conversion time,
+ * callback tells when pollForcedMeasurement() is worth calling
+ */
+class Bme280Sensor : public Adafruit_BME280 {
+    private:
+        Bme280Calibration calibration;
+        void copyCalibration();
+        void restoreCalibration();
+
+        void (*measurementCallback)(void* context);
+        void* measurementCallbackContext;
+        Bme280MeasurementStatus measurementStatus;
+        unsigned long measurementStartMillis;
+
+        void createMeasurementTimer();
+        void armMeasurementTimer(uint32_t miliseconds);
+
+#ifdef ESP_PLATFORM
+        TimerHandle_t measurementTimer;
+        static void measurementTimerCallback(TimerHandle_t timer);
+#endif
+
+    public:
+        Bme280Sensor();
+        bool begin(uint8_t address, TwoWire* wire);
+        bool resume(uint8_t address, TwoWire* wire, const Bme280Calibration& calibration); // Fast resume after deep sleep
+        Bme280Reading readAll();
+
+        uint32_t getMeasurementTimeMicroseconds();
+        uint32_t startForcedMeasurement();
+        Bme280MeasurementStatus pollForcedMeasurement(Bme280Reading& reading);
+        void attachMeasurementCallback(void (*callback)(void* context), void* context);
+        Bme280Calibration getCalibration();
+};
+
+#endif
\ No newline at end of file
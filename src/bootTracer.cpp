@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <bootTracer.h>
+
+BootTracer::BootTracer() {
+    this->stagesCount = 0;
+
+#ifdef ESP_PLATFORM
+    this->mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+void BootTracer::lock() {
+#ifdef ESP_PLATFORM
+    portENTER_CRITICAL(&this->mux);
+#endif
+}
+
+void BootTracer::unlock() {
+#ifdef ESP_PLATFORM
+    portEXIT_CRITICAL(&this->mux);
+#endif
+}
+
+uint8_t BootTracer::begin(const char* name) {
+    uint32_t startMicroseconds = micros();
+    uint8_t stage = BOOT_TRACER_NO_STAGE;
+
+    this->lock();
+    if (this->stagesCount < BOOT_TRACER_MAX_STAGES) {
+        stage = this->stagesCount;
+        this->stages[stage] = BootStage{
+            name: name,
+            startMicroseconds: startMicroseconds,
+            durationMicroseconds: 0,
+            isFinished: false
+        };
+        this->stagesCount++;
+    }
+    this->unlock();
+
+    return stage;
+}
+
+void BootTracer::end(uint8_t stage) {
+    uint32_t endMicroseconds = micros();
+
+    this->lock();
+    if (stage < this->stagesCount && !this->stages[stage].isFinished) {
+        this->stages[stage].durationMicroseconds = endMicroseconds - this->stages[stage].startMicroseconds;
+        this->stages[stage].isFinished = true;
+    }
+    this->unlock();
+}
+
+void BootTracer::record(const char* name, uint32_t startMicroseconds, uint32_t endMicroseconds) {
+    this->lock();
+    if (this->stagesCount < BOOT_TRACER_MAX_STAGES) {
+        this->stages[this->stagesCount] = BootStage{
+            name: name,
+            startMicroseconds: startMicroseconds,
+            durationMicroseconds: endMicroseconds - startMicroseconds,
+            isFinished: true
+        };
+        this->stagesCount++;
+    }
+    this->unlock();
+}
+
+uint8_t BootTracer::getStagesCount() {
+    this->lock();
+    uint8_t count = this->stagesCount;
+    this->unlock();
+
+    return count;
+}
+
+BootStage BootTracer::getStage(uint8_t stage) {
+    BootStage copy = BootStage{ name: "", startMicroseconds: 0, durationMicroseconds: 0, isFinished: false };
+
+    this->lock();
+    if (stage < this->stagesCount) {
+        copy = this->stages[stage];
+    }
+    this->unlock();
+
+    return copy;
+}
+
+bool BootTracer::isFinished() {
+    bool isFinished = true;
+
+    this->lock();
+    for (uint8_t i = 0; i < this->stagesCount; i++) {
+        isFinished = isFinished && this->stages[i].isFinished;
+    }
+    this->unlock();
+
+    return isFinished;
+}
+
+uint32_t BootTracer::getBootMicroseconds() {
+    uint32_t bootMicroseconds = 0;
+
+    this->lock();
+    for (uint8_t i = 0; i < this->stagesCount; i++) {
+        if (this->stages[i].isFinished) {
+            bootMicroseconds = std::max(bootMicroseconds, this->stages[i].startMicroseconds + this->stages[i].durationMicroseconds);
+        }
+    }
+    this->unlock();
+
+    return bootMicroseconds;
+}
+
+void BootTracer::printReport() {
+    char line[64];
+
+    Serial.println("Boot stages (start / duration [ms]):");
+
+    for (uint8_t i = 0; i < this->getStagesCount(); i++) {
+        BootStage stage = this->getStage(i);
+
+        snprintf(line, sizeof(line), "  %-14s %8.1f %8.1f%s", stage.name, stage.startMicroseconds / 1000.0, stage.durationMicroseconds / 1000.0, stage.isFinished ? "" : " (running)");
+        Serial.println(line);
+    }
+
+    snprintf(line, sizeof(line), "Boot finished after %.1f ms", this->getBootMicroseconds() / 1000.0);
+    Serial.println(line);
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef BOOT_TRACER_H
+#define BOOT_TRACER_H
+
+#include <Arduino.h>
+
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#endif
+
+const uint8_t BOOT_TRACER_MAX_STAGES = 24;
+const uint8_t BOOT_TRACER_NO_STAGE = 0xFF;
+
+struct BootStage {
+    const char* name; // Static string, not copied
+    uint32_t startMicroseconds; // Since boot
+    uint32_t durationMicroseconds;
+    bool isFinished;
+};
+
+/**
+ * Durations of boot stages in fixed buffer, nothing is allocated
+ * Stages can overlap (running in different tasks), begin() / end() can be called from any task
+ */
+class BootTracer {
+    private:
+        BootStage stages[BOOT_TRACER_MAX_STAGES];
+        uint8_t stagesCount;
+
+#ifdef ESP_PLATFORM
+        portMUX_TYPE mux;
+#endif
+
+        void lock();
+        void unlock();
+
+    public:
+        BootTracer();
+        uint8_t begin(const char* name); // Returns stage to be ended, BOOT_TRACER_NO_STAGE when buffer is full
+        void end(uint8_t stage);
+        void record(const char* name, uint32_t startMicroseconds, uint32_t endMicroseconds); // Stage which ended before tracer could be used
+
+        uint8_t getStagesCount();
+        BootStage getStage(uint8_t stage);
+        bool isFinished(); // All stages begun so far have ended
+        uint32_t getBootMicroseconds(); // End of the latest stage
+        void printReport();
+};
+
+#endif
\ No newline at end of file
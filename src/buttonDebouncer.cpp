@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <buttonDebouncer.h>
+
+ButtonDebouncer::ButtonDebouncer() {
+    this->isDoublePressEnabled = false;
+    this->isRawPressed = false;
+    this->isStablePressed = false;
+    this->lastEdgeMiliseconds = 0;
+    this->pressStartMiliseconds = 0;
+    this->releaseMiliseconds = 0;
+    this->isLongPressEmitted = false;
+    this->isSecondPress = false;
+    this->isWaitingForSecondPress = false;
+}
+
+void ButtonDebouncer::setDoublePressEnabled(bool isEnabled) {
+    this->isDoublePressEnabled = isEnabled;
+}
+
+bool ButtonDebouncer::hasElapsed(uint32_t sinceMiliseconds, uint16_t durationMiliseconds, uint32_t nowMiliseconds) {
+    return nowMiliseconds - sinceMiliseconds >= durationMiliseconds;
+}
+
+void ButtonDebouncer::handleEdge(bool isPressed, uint32_t timestampMiliseconds) {
+    this->isRawPressed = isPressed;
+    this->lastEdgeMiliseconds = timestampMiliseconds;
+}
+
+/**
+ * Stable level changed, times are taken from the edge (not from when bouncing settled)
+ */
+bool ButtonDebouncer::handleStableChange(ButtonEventType& event) {
+    this->isStablePressed = this->isRawPressed;
+
+    if (this->isStablePressed) {
+        this->pressStartMiliseconds = this->lastEdgeMiliseconds;
+        this->isLongPressEmitted = false;
+        this->isSecondPress = this->isWaitingForSecondPress;
+        this->isWaitingForSecondPress = false;
+
+        return false;
+    }
+
+    if (this->isLongPressEmitted) {
+        return false;
+    }
+
+    if (this->isSecondPress) {
+        this->isSecondPress = false;
+        event = ButtonDoublePress;
+
+        return true;
+    }
+
+    if (this->isDoublePressEnabled) {
+        this->isWaitingForSecondPress = true;
+        this->releaseMiliseconds = this->lastEdgeMiliseconds;
+
+        return false;
+    }
+
+    event = ButtonPress;
+
+    return true;
+}
+
+bool ButtonDebouncer::update(uint32_t nowMiliseconds, ButtonEventType& event) {
+    if (this->isRawPressed != this->isStablePressed && this->hasElapsed(this->lastEdgeMiliseconds, BUTTON_DEBOUNCE_MILISECONDS, nowMiliseconds)) {
+        if (this->handleStableChange(event)) {
+            return true;
+        }
+    }
+
+    if (this->isStablePressed && !this->isLongPressEmitted && this->hasElapsed(this->pressStartMiliseconds, BUTTON_LONG_PRESS_MILISECONDS, nowMiliseconds)) {
+        this->isLongPressEmitted = true;
+        this->isSecondPress = false;
+        event = ButtonLongPress;
+
+        return true;
+    }
+
+    // Second press has not come, it was a single press
+    if (this->isWaitingForSecondPress && this->hasElapsed(this->releaseMiliseconds, BUTTON_DOUBLE_PRESS_MILISECONDS, nowMiliseconds)) {
+        this->isWaitingForSecondPress = false;
+        event = ButtonPress;
+
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t ButtonDebouncer::getRemainingMiliseconds(uint32_t sinceMiliseconds, uint16_t durationMiliseconds, uint32_t nowMiliseconds) {
+    uint32_t elapsed = nowMiliseconds - sinceMiliseconds;
+
+    return elapsed >= durationMiliseconds ? 0 : durationMiliseconds - elapsed;
+}
+
+uint32_t ButtonDebouncer::getMilisecondsUntilDeadline(uint32_t nowMiliseconds) {
+    uint32_t deadline = BUTTON_NO_DEADLINE;
+
+    if (this->isRawPressed != this->isStablePressed) {
+        deadline = std::min(deadline, this->getRemainingMiliseconds(this->lastEdgeMiliseconds, BUTTON_DEBOUNCE_MILISECONDS, nowMiliseconds));
+    }
+
+    if (this->isStablePressed && !this->isLongPressEmitted) {
+        deadline = std::min(deadline, this->getRemainingMiliseconds(this->pressStartMiliseconds, BUTTON_LONG_PRESS_MILISECONDS, nowMiliseconds));
+    }
+
+    if (this->isWaitingForSecondPress) {
+        deadline = std::min(deadline, this->getRemainingMiliseconds(this->releaseMiliseconds, BUTTON_DOUBLE_PRESS_MILISECONDS, nowMiliseconds));
+    }
+
+    return deadline;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef BUTTON_DEBOUNCER_H
+#define BUTTON_DEBOUNCER_H
+
+#include <Arduino.h>
+
+const uint16_t BUTTON_DEBOUNCE_MILISECONDS = 30; // Level has to be stable that long after last edge
+const uint16_t BUTTON_LONG_PRESS_MILISECONDS = 800;
+const uint16_t BUTTON_DOUBLE_PRESS_MILISECONDS = 300; // From first release to second press
+
+const uint32_t BUTTON_NO_DEADLINE = UINT32_MAX;
+
+enum ButtonEventType { ButtonPress, ButtonLongPress, ButtonDoublePress };
+
+/**
+ * Turns timestamped raw edges of one button into press / long press / double press events
+ * Press is reported on release, delayed by double press window only when double press is enabled
+ * No hardware access, 32-bit millis timestamps (wrap-safe)
+ */
+class ButtonDebouncer {
+    private:
+        bool isDoublePressEnabled;
+        bool isRawPressed;
+        bool isStablePressed;
+        uint32_t lastEdgeMiliseconds;
+        uint32_t pressStartMiliseconds;
+        uint32_t releaseMiliseconds;
+        bool isLongPressEmitted;
+        bool isSecondPress;
+        bool isWaitingForSecondPress;
+
+        bool hasElapsed(uint32_t sinceMiliseconds, uint16_t durationMiliseconds, uint32_t nowMiliseconds);
+        uint32_t getRemainingMiliseconds(uint32_t sinceMiliseconds, uint16_t durationMiliseconds, uint32_t nowMiliseconds);
+        bool handleStableChange(ButtonEventType& event);
+
+    public:
+        ButtonDebouncer();
+        void setDoublePressEnabled(bool isEnabled);
+        void handleEdge(bool isPressed, uint32_t timestampMiliseconds);
+        bool update(uint32_t nowMiliseconds, ButtonEventType& event); // Call until false, one event per call
+        uint32_t getMilisecondsUntilDeadline(uint32_t nowMiliseconds); // BUTTON_NO_DEADLINE when idle
+};
+
+#endif
\ No newline at end of file
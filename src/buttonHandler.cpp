@@ -1,32 +1,98 @@
 #include <Arduino.h>
+#include <driver/gpio.h>
+#include <hal/gpio_ll.h>
 #include <buttonHandler.h>
 
 ButtonHandler::ButtonHandler(byte buttonGpio) {
-    this->lastButtonState = false;
     this->buttonGpio = buttonGpio;
+    this->edgesQueue = nullptr;
+    this->isWakeupEnabled = false;
     this->pressCallback = nullptr;
+    this->longPressCallback = nullptr;
+    this->doublePressCallback = nullptr;
 }
 
-void ButtonHandler::initialize() {
+void ButtonHandler::initialize(QueueHandle_t edgesQueue) {
+    this->edgesQueue = edgesQueue;
+
     pinMode(buttonGpio, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(buttonGpio), ButtonHandler::handleInterrupt, this, CHANGE);
+}
+
+void IRAM_ATTR ButtonHandler::handleInterrupt(void* param) {
+    ButtonHandler* button = static_cast<ButtonHandler*>(param);
+    BaseType_t hasWokenTask = pdFALSE;
+
+    ButtonEdge edge = {
+        button: button,
+        isPressed: gpio_get_level((gpio_num_t)button->buttonGpio) == LOW,
+        timestampMiliseconds: millis()
+    };
+
+    if (button->isWakeupEnabled) {
+        gpio_ll_wakeup_enable(&GPIO, (gpio_num_t)button->buttonGpio, edge.isPressed ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+    }
+
+    // Full queue only loses bouncing edges, level is re-read on next one
+    xQueueSendFromISR(button->edgesQueue, &edge, &hasWokenTask);
+
+    if (hasWokenTask == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * Has to be called after initialize
+ */
+void ButtonHandler::setWakeupEnabled(bool isEnabled) {
+    gpio_num_t gpio = (gpio_num_t)this->buttonGpio;
+
+    this->isWakeupEnabled = isEnabled;
+
+    if (isEnabled) {
+        gpio_wakeup_enable(gpio, gpio_get_level(gpio) == LOW ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+    } else {
+        gpio_wakeup_disable(gpio);
+        gpio_set_intr_type(gpio, GPIO_INTR_ANYEDGE);
+    }
 }
 
 void ButtonHandler::attachButtonPressCallback(void (*callback)()) {
     this->pressCallback = callback;
 }
 
-void ButtonHandler::checkButtonPress() {
-    bool newButtonState = digitalRead(buttonGpio);
-    unsigned long currentTime = micros();
+void ButtonHandler::attachButtonLongPressCallback(void (*callback)()) {
+    this->longPressCallback = callback;
+}
+
+/**
+ * Single press is delayed by double press window only for buttons with this callback
+ */
+void ButtonHandler::attachButtonDoublePressCallback(void (*callback)()) {
+    this->doublePressCallback = callback;
+    this->debouncer.setDoublePressEnabled(callback != nullptr);
+}
+
+byte ButtonHandler::getGpio() {
+    return this->buttonGpio;
+}
+
+ButtonDebouncer& ButtonHandler::getDebouncer() {
+    return this->debouncer;
+}
+
+void ButtonHandler::handleEvent(ButtonEventType event) {
+    void (*callback)() = this->pressCallback;
 
-    if (lastButtonState != newButtonState && currentTime - lastCompareMicros >= 100 * 1000) {
-        if (!newButtonState) {
-            if (pressCallback != nullptr) {
-                pressCallback();
-            }
-        }
+    if (event == ButtonLongPress && this->longPressCallback != nullptr) {
+        callback = this->longPressCallback;
+    }
+
+    if (event == ButtonDoublePress && this->doublePressCallback != nullptr) {
+        callback = this->doublePressCallback;
+    }
 
-        lastButtonState = newButtonState;
-        lastCompareMicros = currentTime;
+    if (callback != nullptr) {
+        callback();
     }
 }
\ No newline at end of file
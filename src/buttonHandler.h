@@ -2,21 +2,50 @@
 #define BUTTON_HANDLER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
+#include <buttonDebouncer.h>
+
+class ButtonHandler;
+
+// Raw edge captured in interrupt
+struct ButtonEdge {
+    ButtonHandler* button;
+    bool isPressed;
+    uint32_t timestampMiliseconds;
+};
+
+/**
+ * One button (active low, internal pull-up)
+ * Interrupt only timestamps edges, debouncing runs in ButtonInput task, callbacks run in task dispatching events (loop)
+ * Long press without its callback is reported as press
+ * Only level interrupts wake up from light sleep, so while wakeup is enabled interrupt waits for the opposite level after each edge
+ */
 class ButtonHandler {
     private:
-        bool lastButtonState;
-        unsigned long lastCompareMicros; // Microseconds
         byte buttonGpio;
-        void (*pressCallback)();   
+        QueueHandle_t edgesQueue;
+        ButtonDebouncer debouncer;
+        volatile bool isWakeupEnabled;
+        void (*pressCallback)();
+        void (*longPressCallback)();
+        void (*doublePressCallback)();
+
+        static void handleInterrupt(void* param);
 
     public:
         ButtonHandler(byte buttonGpio);
-        void initialize();
+        void initialize(QueueHandle_t edgesQueue);
+        void setWakeupEnabled(bool isEnabled);
+        byte getGpio();
 
         void attachButtonPressCallback(void (*callback)());
+        void attachButtonLongPressCallback(void (*callback)());
+        void attachButtonDoublePressCallback(void (*callback)());
 
-        void checkButtonPress();
+        ButtonDebouncer& getDebouncer();
+        void handleEvent(ButtonEventType event);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <Arduino.h>
+#include <algorithm>
+#include <buttonInput.h>
+
+ButtonInput::ButtonInput() {
+    this->edgesQueue = nullptr;
+    this->eventsQueue = nullptr;
+    this->taskHandle = nullptr;
+    this->buttonsCount = 0;
+}
+
+void ButtonInput::initialize(uint32_t stackSize) {
+    this->edgesQueue = xQueueCreate(BUTTON_INPUT_EDGES_QUEUE_LENGTH, sizeof(ButtonEdge));
+    this->eventsQueue = xQueueCreate(BUTTON_INPUT_EVENTS_QUEUE_LENGTH, sizeof(ButtonEvent));
+
+    xTaskCreate(ButtonInput::taskFunction, "ButtonInputTask", stackSize, this, 2, &this->taskHandle);
+}
+
+/**
+ * Has to be called after initialize, interrupt of the button is enabled here
+ */
+bool ButtonInput::addButton(ButtonHandler* button) {
+    if (this->edgesQueue == nullptr || this->buttonsCount >= BUTTON_INPUT_MAX_BUTTONS) {
+        return false;
+    }
+
+    this->buttons[this->buttonsCount] = button;
+    this->buttonsCount++;
+
+    button->initialize(this->edgesQueue);
+
+    return true;
+}
+
+void ButtonInput::taskFunction(void* param) {
+    static_cast<ButtonInput*>(param)->run();
+}
+
+void ButtonInput::run() {
+    ButtonEdge edge;
+
+    while (true) {
+        if (xQueueReceive(this->edgesQueue, &edge, this->getWaitTicks()) == pdTRUE) {
+            edge.button->getDebouncer().handleEdge(edge.isPressed, edge.timestampMiliseconds);
+        }
+
+        uint32_t nowMiliseconds = millis();
+
+        for (uint8_t i = 0; i < this->buttonsCount; i++) {
+            ButtonEventType type;
+
+            while (this->buttons[i]->getDebouncer().update(nowMiliseconds, type)) {
+                ButtonEvent event = {
+                    button: this->buttons[i],
+                    type: type
+                };
+
+                if (xQueueSend(this->eventsQueue, &event, 0) != pdTRUE) {
+                    Serial.println("Button event dropped, events queue is full");
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Nearest deadline of all buttons, without any the task sleeps until next edge
+ */
+TickType_t ButtonInput::getWaitTicks() {
+    uint32_t nowMiliseconds = millis();
+    uint32_t deadline = BUTTON_NO_DEADLINE;
+
+    for (uint8_t i = 0; i < this->buttonsCount; i++) {
+        deadline = std::min(deadline, this->buttons[i]->getDebouncer().getMilisecondsUntilDeadline(nowMiliseconds));
+    }
+
+    if (deadline == BUTTON_NO_DEADLINE) {
+        return portMAX_DELAY;
+    }
+
+    return pdMS_TO_TICKS(deadline);
+}
+
+/**
+ * Waits for first event up to timeout, then handles all queued ones
+ */
+bool ButtonInput::dispatchEvents(TickType_t timeoutTicks) {
+    if (this->eventsQueue == nullptr) {
+        vTaskDelay(timeoutTicks);
+        return false;
+    }
+
+    ButtonEvent event;
+    bool hasHandledEvent = false;
+
+    while (xQueueReceive(this->eventsQueue, &event, hasHandledEvent ? 0 : timeoutTicks) == pdTRUE) {
+        event.button->handleEvent(event.type);
+        hasHandledEvent = true;
+    }
+
+    return hasHandledEvent;
+}
+
+TaskHandle_t ButtonInput::getTaskHandle() {
+    return this->taskHandle;
+}
\ No newline at end of file
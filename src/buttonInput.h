@@ -0,0 +1,45 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+
+#include <buttonHandler.h>
+
+const uint8_t BUTTON_INPUT_MAX_BUTTONS = 4;
+const uint8_t BUTTON_INPUT_EDGES_QUEUE_LENGTH = 32;
+const uint8_t BUTTON_INPUT_EVENTS_QUEUE_LENGTH = 8;
+
+struct ButtonEvent {
+    ButtonHandler* button;
+    ButtonEventType type;
+};
+
+/**
+ * Debouncer task of all buttons
+ * Sleeps on edges queue, wakes up by itself only for pending debounce / long press / double press deadlines
+ * Events are handed over to dispatchEvents() caller, so callbacks run in its task (not in debouncer)
+ */
+class ButtonInput {
+    private:
+        QueueHandle_t edgesQueue;
+        QueueHandle_t eventsQueue;
+        TaskHandle_t taskHandle;
+        ButtonHandler* buttons[BUTTON_INPUT_MAX_BUTTONS];
+        uint8_t buttonsCount;
+
+        static void taskFunction(void* param);
+        void run();
+        TickType_t getWaitTicks();
+
+    public:
+        ButtonInput();
+        void initialize(uint32_t stackSize);
+        bool addButton(ButtonHandler* button);
+        bool dispatchEvents(TickType_t timeoutTicks); // True when any event was handled
+        TaskHandle_t getTaskHandle();
+};
+
+#endif
\ No newline at end of file
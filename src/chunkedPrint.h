@@ -0,0 +1,77 @@
+#ifndef CHUNKED_PRINT_H
+#define CHUNKED_PRINT_H
+
+#include <Arduino.h>
+
+/**
+ * Only counts written bytes, measures output before it is streamed (Content-Length)
+ */
+class LengthCountingPrint : public Print {
+    private:
+        size_t length;
+
+    public:
+        LengthCountingPrint(): length(0) {}
+
+        size_t write(uint8_t character) override {
+            this->length++;
+
+            return 1;
+        }
+
+        size_t write(const uint8_t* buffer, size_t size) override {
+            this->length += size;
+
+            return size;
+        }
+
+        size_t getLength() {
+            return this->length;
+        }
+};
+
+/**
+ * Collects small writes into chunks of N bytes before they reach the output (one TCP segment instead of one per value)
+ * Call flush() after the last write
+ */
+template <size_t N>
+class ChunkedPrint : public Print {
+    private:
+        Print& output;
+        uint8_t chunk[N];
+        size_t chunkLength;
+        bool hasFailed;
+
+    public:
+        ChunkedPrint(Print& output): output(output), chunkLength(0), hasFailed(false) {}
+
+        size_t write(uint8_t character) override {
+            return this->write(&character, 1);
+        }
+
+        size_t write(const uint8_t* buffer, size_t size) override {
+            for (size_t i = 0; i < size; i++) {
+                if (this->chunkLength == N) {
+                    this->flush();
+                }
+
+                this->chunk[this->chunkLength++] = buffer[i];
+            }
+
+            return size;
+        }
+
+        void flush() {
+            if (this->chunkLength > 0 && this->output.write(this->chunk, this->chunkLength) != this->chunkLength) {
+                this->hasFailed = true;
+            }
+
+            this->chunkLength = 0;
+        }
+
+        bool isFailed() {
+            return this->hasFailed;
+        }
+};
+
+#endif
\ No newline at end of file
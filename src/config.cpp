@@ -2,6 +2,7 @@
 
 AppModeEnum AppMode = Manual; // Always initializing with Manual for security reasons (not stored in memory)
 const bool WEATHER_FORECAST_ENABLED = true;
+const bool DEEP_SLEEP_ENABLED = false; // Between Auto mode calculations, BLE is unreachable and only Enter button wakes up
 bool forceOpeningWindowCalculation = false; // Flag to recalculate manually WindowOpening any time
 bool hasNTPAlreadyConfigured = false; // Can be changed only once
 bool isNTPUnderConfiguration = false;
@@ -18,13 +19,15 @@ const char* BACKEND_APP_URL = "http://window-opening.nero12.usermd.net";
 
 const int DELAY_DIFF_BETWEEN_SERVOS_MILISECONDS = 500; // 0.5s - difference between one will start before other one
 
-const int MOVE_SMOOTHLY_MILISECONDS_INTERVAL = 40;
+const int MOVE_SMOOTHLY_MILISECONDS_INTERVAL = 20; // Same as servo PWM period (50Hz)
+const float MOVE_SMOOTHLY_MAX_VELOCITY = 30; // % of calibrated range per second
+const float MOVE_SMOOTHLY_MAX_ACCELERATION = 40; // % of calibrated range per second^2
+const MotionProfileShape MOVE_SMOOTHLY_PROFILE_SHAPE = MotionProfileSCurve;
 
 const uint32_t VOLTAGE_REFERENCE = 1100;
 const float RESISTOR_FIRST_VALUE = 5000.0;  // 5kΩ
 const float RESISTOR_SECOND_VALUE = 2150.0;   // 2.15kΩ
 
-const float BATTERY_VOLTAGE_0_REFERENCE = 6.5;
 const float BATTERY_VOLTAGE_100_REFERENCE = 8.45;
 const float BATTERY_VOLTAGE_MIN_PERCENTAGE = 20;
 
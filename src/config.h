@@ -2,11 +2,13 @@
 #define APP_CONFIG_H
 
 #include <Arduino.h>
+#include <motionProfile.h>
 
 enum AppModeEnum { Auto, Manual };
 
 extern AppModeEnum AppMode;
 extern const bool WEATHER_FORECAST_ENABLED;
+extern const bool DEEP_SLEEP_ENABLED;
 
 // Flags
 extern bool forceOpeningWindowCalculation;
@@ -26,12 +28,14 @@ extern const char* BACKEND_APP_URL;
 extern const int DELAY_DIFF_BETWEEN_SERVOS_MILISECONDS;
 
 extern const int MOVE_SMOOTHLY_MILISECONDS_INTERVAL;
+extern const float MOVE_SMOOTHLY_MAX_VELOCITY;
+extern const float MOVE_SMOOTHLY_MAX_ACCELERATION;
+extern const MotionProfileShape MOVE_SMOOTHLY_PROFILE_SHAPE;
 
 extern const uint32_t VOLTAGE_REFERENCE;
 extern const float RESISTOR_FIRST_VALUE;
 extern const float RESISTOR_SECOND_VALUE;
 
-extern const float BATTERY_VOLTAGE_0_REFERENCE;
 extern const float BATTERY_VOLTAGE_100_REFERENCE;
 extern const float BATTERY_VOLTAGE_MIN_PERCENTAGE;
 
@@ -0,0 +1,92 @@
+#ifndef FIXED_VECTOR_H
+#define FIXED_VECTOR_H
+
+#include <Arduino.h>
+
+/**
+ * Vector with capacity fixed at compile time, storage is inline (never touches heap)
+ * Adding to full vector fails and returns false, callers decide what to drop
+ * Items are kept contiguous, insert / erase shift the rest (capacities are small)
+ */
+template <typename T, uint16_t N>
+class FixedVector {
+    private:
+        T items[N];
+        uint16_t count;
+
+    public:
+        FixedVector(): count(0) {}
+
+        bool push_back(const T& item) {
+            return this->insert(this->count, item);
+        }
+
+        bool insert(uint16_t index, const T& item) {
+            if (this->count >= N || index > this->count) {
+                return false;
+            }
+
+            for (uint16_t i = this->count; i > index; i--) {
+                this->items[i] = this->items[i - 1];
+            }
+
+            this->items[index] = item;
+            this->count++;
+
+            return true;
+        }
+
+        void erase(uint16_t index) {
+            if (index >= this->count) {
+                return;
+            }
+
+            for (uint16_t i = index; i + 1 < this->count; i++) {
+                this->items[i] = this->items[i + 1];
+            }
+
+            this->count--;
+        }
+
+        void clear() {
+            this->count = 0;
+        }
+
+        T& operator[](uint16_t index) {
+            return this->items[index];
+        }
+
+        T& front() {
+            return this->items[0];
+        }
+
+        T& back() {
+            return this->items[this->count - 1];
+        }
+
+        T* begin() {
+            return this->items;
+        }
+
+        T* end() {
+            return this->items + this->count;
+        }
+
+        uint16_t size() const {
+            return this->count;
+        }
+
+        uint16_t capacity() const {
+            return N;
+        }
+
+        bool empty() const {
+            return this->count == 0;
+        }
+
+        bool full() const {
+            return this->count >= N;
+        }
+};
+
+#endif
\ No newline at end of file
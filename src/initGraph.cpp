@@ -0,0 +1,80 @@
+#include <initGraph.h>
+
+InitGraph::InitGraph(BootTracer* bootTracer): bootTracer(bootTracer) {
+    this->stagesCount = 0;
+    this->doneStages = nullptr;
+}
+
+EventBits_t InitGraph::addStage(const char* name, InitStageFunction function, EventBits_t dependencies, uint32_t stackSize) {
+    if (this->stagesCount >= INIT_GRAPH_MAX_STAGES) {
+        Serial.print("Too many init stages, not added: ");
+        Serial.println(name);
+
+        return 0;
+    }
+
+    uint8_t index = this->stagesCount;
+
+    this->stages[index] = InitStage{
+        name: name,
+        function: function,
+        dependencies: dependencies & this->getAllStages(),
+        stackSize: stackSize,
+        graph: this,
+        index: index
+    };
+    this->stagesCount++;
+
+    return (EventBits_t) 1 << index;
+}
+
+EventBits_t InitGraph::getAllStages() {
+    return ((EventBits_t) 1 << this->stagesCount) - 1;
+}
+
+void InitGraph::run() {
+    this->doneStages = xEventGroupCreate();
+
+    // Background stages first, they wait for their dependencies on their own
+    for (uint8_t i = 0; i < this->stagesCount; i++) {
+        InitStage& stage = this->stages[i];
+
+        if (stage.stackSize != INIT_GRAPH_INLINE) {
+            xTaskCreate(InitGraph::stageTaskFunction, stage.name, stage.stackSize, &stage, 1, nullptr);
+        }
+    }
+
+    for (uint8_t i = 0; i < this->stagesCount; i++) {
+        InitStage& stage = this->stages[i];
+
+        if (stage.stackSize == INIT_GRAPH_INLINE) {
+            this->runStage(stage);
+        }
+    }
+}
+
+void InitGraph::stageTaskFunction(void* param) {
+    InitStage* stage = static_cast<InitStage*>(param);
+
+    stage->graph->runStage(*stage);
+
+    vTaskDelete(nullptr);
+}
+
+void InitGraph::runStage(InitStage& stage) {
+    if (stage.dependencies != 0) {
+        xEventGroupWaitBits(this->doneStages, stage.dependencies, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+
+    uint8_t tracedStage = this->bootTracer->begin(stage.name);
+    stage.function();
+    this->bootTracer->end(tracedStage);
+
+    xEventGroupSetBits(this->doneStages, (EventBits_t) 1 << stage.index);
+}
+
+bool InitGraph::waitFor(EventBits_t stages, TickType_t timeoutTicks) {
+    EventBits_t bits = xEventGroupWaitBits(this->doneStages, stages, pdFALSE, pdTRUE, timeoutTicks);
+
+    return (bits & stages) == stages;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef INIT_GRAPH_H
+#define INIT_GRAPH_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+
+#include <bootTracer.h>
+
+const uint8_t INIT_GRAPH_MAX_STAGES = 24; // Usable bits of event group
+const uint32_t INIT_GRAPH_INLINE = 0; // Stage runs in task calling run()
+
+typedef void (*InitStageFunction)();
+
+class InitGraph;
+
+struct InitStage {
+    const char* name;
+    InitStageFunction function;
+    EventBits_t dependencies; // Bits of stages which have to be done first
+    uint32_t stackSize; // INIT_GRAPH_INLINE or stack of own task
+    InitGraph* graph;
+    uint8_t index;
+};
+
+/**
+ * Boot stages with dependencies, each stage is traced
+ * Stages with own stack start in their own tasks as soon as their dependencies are done,
+ * inline stages run one by one inside run() (which returns when all of them are done)
+ * Stage can depend only on stages added before it, so there are no cycles
+ */
+class InitGraph {
+    private:
+        BootTracer* bootTracer;
+        InitStage stages[INIT_GRAPH_MAX_STAGES];
+        uint8_t stagesCount;
+        EventGroupHandle_t doneStages;
+
+        static void stageTaskFunction(void* param);
+        void runStage(InitStage& stage);
+
+    public:
+        InitGraph(BootTracer* bootTracer);
+        EventBits_t addStage(const char* name, InitStageFunction function, EventBits_t dependencies = 0, uint32_t stackSize = INIT_GRAPH_INLINE); // Returns bit of the stage
+        EventBits_t getAllStages();
+        void run();
+        bool waitFor(EventBits_t stages, TickType_t timeoutTicks);
+};
+
+#endif
\ No newline at end of file
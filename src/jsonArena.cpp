@@ -0,0 +1,127 @@
+#include <jsonArena.h>
+
+const size_t JSON_ARENA_NO_BLOCK = SIZE_MAX;
+
+// Precedes every block, keeps the block aligned
+struct JsonArenaBlockHeader {
+    uint32_t size;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(JsonArenaBlockHeader) == JSON_ARENA_ALIGNMENT, "Block header has to keep blocks aligned");
+
+size_t alignJsonArenaSize(size_t size) {
+    return (size + JSON_ARENA_ALIGNMENT - 1) & ~(JSON_ARENA_ALIGNMENT - 1);
+}
+
+JsonArena::JsonArena(uint8_t* buffer, size_t capacity) {
+    this->buffer = buffer;
+    this->capacity = capacity;
+    this->peakUsed = 0;
+    this->reset();
+}
+
+void JsonArena::reset() {
+    this->used = 0;
+    this->lastBlockOffset = JSON_ARENA_NO_BLOCK;
+    this->liveBlocksCount = 0;
+}
+
+size_t JsonArena::getBlockOffset(void* pointer) {
+    return (uint8_t*) pointer - this->buffer - sizeof(JsonArenaBlockHeader);
+}
+
+size_t JsonArena::getBlockSize(size_t blockOffset) {
+    return ((JsonArenaBlockHeader*) (this->buffer + blockOffset))->size;
+}
+
+void JsonArena::updatePeakUsed() {
+    if (this->used > this->peakUsed) {
+        this->peakUsed = this->used;
+    }
+}
+
+void* JsonArena::allocate(size_t size) {
+    size_t blockSize = sizeof(JsonArenaBlockHeader) + alignJsonArenaSize(size);
+
+    if (blockSize > this->capacity - this->used) {
+        return nullptr;
+    }
+
+    size_t blockOffset = this->used;
+    ((JsonArenaBlockHeader*) (this->buffer + blockOffset))->size = size;
+
+    this->used += blockSize;
+    this->updatePeakUsed();
+    this->lastBlockOffset = blockOffset;
+    this->liveBlocksCount++;
+
+    return this->buffer + blockOffset + sizeof(JsonArenaBlockHeader);
+}
+
+void JsonArena::deallocate(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    size_t blockOffset = this->getBlockOffset(pointer);
+
+    this->liveBlocksCount--;
+
+    if (this->liveBlocksCount == 0) {
+        this->reset();
+        return;
+    }
+
+    // Older blocks stay until the arena rewinds
+    if (blockOffset == this->lastBlockOffset) {
+        this->used = blockOffset;
+        this->lastBlockOffset = JSON_ARENA_NO_BLOCK;
+    }
+}
+
+void* JsonArena::reallocate(void* pointer, size_t newSize) {
+    if (pointer == nullptr) {
+        return this->allocate(newSize);
+    }
+
+    size_t blockOffset = this->getBlockOffset(pointer);
+
+    if (blockOffset == this->lastBlockOffset) {
+        size_t blockSize = sizeof(JsonArenaBlockHeader) + alignJsonArenaSize(newSize);
+
+        if (blockSize > this->capacity - blockOffset) {
+            return nullptr;
+        }
+
+        ((JsonArenaBlockHeader*) (this->buffer + blockOffset))->size = newSize;
+        this->used = blockOffset + blockSize;
+        this->updatePeakUsed();
+
+        return pointer;
+    }
+
+    void* newPointer = this->allocate(newSize);
+
+    if (newPointer == nullptr) {
+        return nullptr;
+    }
+
+    size_t oldSize = this->getBlockSize(blockOffset);
+    memcpy(newPointer, pointer, oldSize < newSize ? oldSize : newSize);
+    this->liveBlocksCount--; // Old block is abandoned, its space comes back on rewind
+
+    return newPointer;
+}
+
+size_t JsonArena::getUsed() {
+    return this->used;
+}
+
+size_t JsonArena::getPeakUsed() {
+    return this->peakUsed;
+}
+
+size_t JsonArena::getCapacity() {
+    return this->capacity;
+}
\ No newline at end of file
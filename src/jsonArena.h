@@ -0,0 +1,54 @@
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+const size_t JSON_ARENA_ALIGNMENT = 8; // Doubles and 64-bit integers in extension slots
+
+/**
+ * Bump allocator for ArduinoJson documents, memory comes from fixed buffer (never from heap)
+ * Blocks are only appended, freeing the newest one (pool shrink, string rollback) gives its space back
+ * Arena rewinds itself when its last live block is freed, i.e. when document using it is destroyed
+ * Full arena returns nullptr, document reports overflowed() and serializes what fitted
+ * Single owner (task) per arena, not thread safe
+ */
+class JsonArena : public ArduinoJson::Allocator {
+    private:
+        uint8_t* buffer; // JSON_ARENA_ALIGNMENT aligned
+        size_t capacity;
+        size_t used;
+        size_t peakUsed;
+        size_t lastBlockOffset; // Only newest block can be resized in place
+        uint16_t liveBlocksCount;
+
+        size_t getBlockOffset(void* pointer);
+        size_t getBlockSize(size_t blockOffset);
+        void updatePeakUsed();
+
+    public:
+        JsonArena(uint8_t* buffer, size_t capacity);
+
+        void* allocate(size_t size) override;
+        void deallocate(void* pointer) override;
+        void* reallocate(void* pointer, size_t newSize) override;
+
+        void reset(); // Only when no document uses the arena
+        size_t getUsed();
+        size_t getPeakUsed(); // Since boot, to size the buffer
+        size_t getCapacity();
+};
+
+/**
+ * Arena with its buffer inline
+ */
+template <size_t N>
+class StaticJsonArena : public JsonArena {
+    private:
+        alignas(JSON_ARENA_ALIGNMENT) uint8_t storage[N];
+
+    public:
+        StaticJsonArena(): JsonArena(storage, N) {}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <lcdMarquee.h>
+
+LcdMarquee::LcdMarquee(uint8_t columns) {
+  this->columns = columns;
+  this->textLength = 0;
+  this->position = 0;
+  this->nextStepMiliseconds = 0;
+  this->isActive = false;
+}
+
+void LcdMarquee::start(uint16_t textLength, uint32_t nowMiliseconds) {
+  this->textLength = textLength;
+  this->position = 0;
+  this->nextStepMiliseconds = nowMiliseconds + LCD_SCROLL_START_DELAY_MILISECONDS;
+  this->isActive = textLength > this->columns;
+}
+
+bool LcdMarquee::isRunning() {
+  return this->isActive;
+}
+
+uint32_t LcdMarquee::getMilisecondsUntilNextStep(uint32_t nowMiliseconds) {
+  int32_t remaining = (int32_t)(this->nextStepMiliseconds - nowMiliseconds);
+
+  return remaining > 0 ? remaining : 0;
+}
+
+bool LcdMarquee::update(uint32_t nowMiliseconds, uint16_t characterMiliseconds) {
+  if (!this->isActive || (int32_t)(nowMiliseconds - this->nextStepMiliseconds) < 0) {
+    return false;
+  }
+
+  if (this->position + this->columns >= this->textLength) {
+    this->position = 0;
+    this->nextStepMiliseconds = nowMiliseconds + LCD_SCROLL_START_DELAY_MILISECONDS;
+  } else {
+    this->position++;
+    this->nextStepMiliseconds = nowMiliseconds + characterMiliseconds;
+  }
+
+  return true;
+}
+
+uint16_t LcdMarquee::getPosition() {
+  return this->position;
+}
\ No newline at end of file
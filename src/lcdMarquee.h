@@ -0,0 +1,32 @@
+#ifndef LCD_MARQUEE_H
+#define LCD_MARQUEE_H
+
+#include <Arduino.h>
+
+const uint16_t LCD_SCROLL_START_DELAY_MILISECONDS = 2000; // Text stays still after print and after each full loop
+const uint16_t LCD_SCROLL_DEFAULT_CHARACTER_MILISECONDS = 500;
+const uint16_t LCD_SCROLL_MIN_CHARACTER_MILISECONDS = 50; // Render frame interval
+
+/**
+ * Scroll timing of a row wider than the display, no LCD access
+ * Runs only for texts which do not fit, otherwise it has no deadline (render task sleeps)
+ * 32-bit millis timestamps, differences are wrap-safe
+ */
+class LcdMarquee {
+  private:
+    uint8_t columns;
+    uint16_t textLength;
+    uint16_t position;
+    uint32_t nextStepMiliseconds;
+    bool isActive;
+
+  public:
+    LcdMarquee(uint8_t columns);
+    void start(uint16_t textLength, uint32_t nowMiliseconds);
+    bool isRunning();
+    uint32_t getMilisecondsUntilNextStep(uint32_t nowMiliseconds);
+    bool update(uint32_t nowMiliseconds, uint16_t characterMiliseconds); // True when position has changed
+    uint16_t getPosition();
+};
+
+#endif
\ No newline at end of file
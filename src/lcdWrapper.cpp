@@ -1,118 +1,278 @@
 #include <lcdWrapper.h>
 
-LcdWrapper::LcdWrapper(LiquidCrystal_I2C* lcd): lcd(lcd) {}
+LcdWrapper::LcdWrapper(BatchedLcd* lcd, int (*readScrollSpeed)()): lcd(lcd), readScrollSpeed(readScrollSpeed), marquee(LCD_COLUMNS) {
+  this->screen = LcdScreen{};
+  this->renderedScreen = LcdScreen{};
 
-void LcdWrapper::checkScroll() {
-  if (this->topRowText == "" || millis() - lastPrintMiliseconds < printDelay) {
-    return;
-  }
+#ifdef ESP_PLATFORM
+  this->screensQueue = nullptr;
+  this->screenMutex = nullptr;
+  this->taskHandle = nullptr;
+#endif
 
-  int topRowTextLength = this->topRowText.length();
+  memset(this->frame, ' ', sizeof(this->frame));
+  this->resetDisplayedFrame();
+}
 
-  if (topRowTextLength > 16) {
-    if (this->scrollPosition + 16 == topRowTextLength) {
-      this->scrollPosition = 0;
+void LcdWrapper::initialize(uint32_t stackSize) {
+#ifdef ESP_PLATFORM
+  this->screensQueue = xQueueCreate(1, sizeof(LcdScreen));
+  this->screenMutex = xSemaphoreCreateMutex();
 
-      String finalBottomRowText = this->bottomRowText;
+  xTaskCreate(LcdWrapper::taskFunction, "LcdRenderTask", stackSize, this, 1, &this->taskHandle);
+#endif
 
-      for (int i = 0; i < topRowTextLength - 16; i++) {
-        this->lcd->scrollDisplayRight();
-        finalBottomRowText += " ";
-      }
+  this->lockScreen();
+  this->screen.initializationsCount++;
+  this->submitScreen();
+  this->unlockScreen();
+}
 
-      this->lcd->setCursor(0, 1);
-      this->lcd->print(finalBottomRowText);
-    } else {
-      this->scrollPosition++;
-      this->lcd->scrollDisplayLeft();
+#ifdef ESP_PLATFORM
+void LcdWrapper::taskFunction(void* param) {
+  static_cast<LcdWrapper*>(param)->run();
+}
+
+void LcdWrapper::run() {
+  LcdScreen screen;
+
+  while (true) {
+    // Marquee is the only deadline, without it task sleeps until next screen
+    TickType_t waitTicks = portMAX_DELAY;
 
-      this->lcd->setCursor(this->scrollPosition, 1);
-      this->lcd->print(this->bottomRowText);
+    if (this->marquee.isRunning()) {
+      waitTicks = pdMS_TO_TICKS(this->marquee.getMilisecondsUntilNextStep(millis()));
     }
 
-    this->lastPrintMiliseconds = millis();
+    if (xQueueReceive(this->screensQueue, &screen, waitTicks) == pdTRUE) {
+      this->renderScreen(screen);
+    } else {
+      this->scroll();
+      this->flush();
+    }
+
+    // Screens submitted meanwhile overwrite each other in the queue, only the latest is drawn
+    vTaskDelay(pdMS_TO_TICKS(LCD_RENDER_FRAME_INTERVAL_MILISECONDS));
+  }
+}
+
+TaskHandle_t LcdWrapper::getTaskHandle() {
+  return this->taskHandle;
+}
+#endif
+
+/**
+ * Navigation, BackgroundApp and periodical tasks describe screen from different tasks
+ */
+void LcdWrapper::lockScreen() {
+#ifdef ESP_PLATFORM
+  if (this->screenMutex != nullptr) {
+    xSemaphoreTake(this->screenMutex, portMAX_DELAY);
+  }
+#endif
+}
+
+void LcdWrapper::unlockScreen() {
+#ifdef ESP_PLATFORM
+  if (this->screenMutex != nullptr) {
+    xSemaphoreGive(this->screenMutex);
+  }
+#endif
+}
+
+/**
+ * Never blocks, without render task (host tests) screen is drawn right away
+ */
+void LcdWrapper::submitScreen() {
+#ifdef ESP_PLATFORM
+  if (this->screensQueue != nullptr) {
+    xQueueOverwrite(this->screensQueue, &this->screen);
   }
+#else
+  this->renderScreen(this->screen);
+#endif
 }
 
 void LcdWrapper::backlight() {
-  this->lcd->backlight();
+  this->lockScreen();
+
+  if (!this->screen.isBacklightOn) {
+    this->screen.isBacklightOn = true;
+    this->submitScreen();
+  }
+
+  this->unlockScreen();
 }
 
 void LcdWrapper::noBacklight() {
-  this->lcd->noBacklight();
+  this->lockScreen();
+
+  if (this->screen.isBacklightOn) {
+    this->screen.isBacklightOn = false;
+    this->submitScreen();
+  }
+
+  this->unlockScreen();
 }
 
 void LcdWrapper::turnOn() {
-  this->lcd->init();
-  this->lcd->backlight();
+  this->lockScreen();
+  this->screen.initializationsCount++;
+  this->screen.isBacklightOn = true;
+  this->submitScreen();
+  this->unlockScreen();
 }
 
 void LcdWrapper::turnOff() {
-  this->lcd->noBacklight();
+  this->noBacklight();
 }
 
-void LcdWrapper::initialize() {
-  this->lcd->init();
+void LcdWrapper::print(const char* topRowText, const char* bottomRowText) {
+  this->lockScreen();
+
+  if (
+    strncmp(this->screen.topRowText, topRowText, LCD_TEXT_MAX_LENGTH) == 0 &&
+    strncmp(this->screen.bottomRowText, bottomRowText, LCD_TEXT_MAX_LENGTH) == 0
+  ) {
+    this->unlockScreen();
+    return;
+  }
+
+  snprintf(this->screen.topRowText, sizeof(this->screen.topRowText), "%s", topRowText);
+  snprintf(this->screen.bottomRowText, sizeof(this->screen.bottomRowText), "%s", bottomRowText);
+  this->submitScreen();
+
+  this->unlockScreen();
+}
+
+void LcdWrapper::print(String topRowText, String bottomRowText) {
+  this->print(topRowText.c_str(), bottomRowText.c_str());
+}
+
+void LcdWrapper::print(String topRowText) {
+  this->print(topRowText.c_str(), "");
 }
 
 void LcdWrapper::clear() {
-  this->topRowText = "";
-  this->bottomRowText = "";
-  this->lcd->clear();
+  this->print("", "");
 }
 
 void LcdWrapper::clearTopRow() {
-  this->topRowText = "";
-  this->lcd->setCursor(0, 0);
-  this->lcd->print("                                ");
+  char bottomRowText[LCD_TEXT_MAX_LENGTH + 1];
+
+  this->lockScreen();
+  memcpy(bottomRowText, this->screen.bottomRowText, sizeof(bottomRowText));
+  this->unlockScreen();
+
+  this->print("", bottomRowText);
 }
 
 void LcdWrapper::clearBottomRow() {
-  this->bottomRowText = "";
-  this->lcd->setCursor(0, 1);
-  this->lcd->print("                                ");
+  char topRowText[LCD_TEXT_MAX_LENGTH + 1];
+
+  this->lockScreen();
+  memcpy(topRowText, this->screen.topRowText, sizeof(topRowText));
+  this->unlockScreen();
+
+  this->print(topRowText, "");
 }
 
-void LcdWrapper::print(String topRowText, String bottomRowText) {
-  if (topRowText == this->topRowText && bottomRowText == this->bottomRowText) {
-    return;
+/**
+ * Everything below runs only in render task
+ */
+void LcdWrapper::renderScreen(const LcdScreen& screen) {
+  bool isReinitialized = screen.initializationsCount != this->renderedScreen.initializationsCount;
+
+  if (isReinitialized) {
+    this->lcd->init();
+    this->resetDisplayedFrame();
+    this->renderedScreen.initializationsCount = screen.initializationsCount;
   }
 
-  this->lcd->home();
-  this->lastPrintMiliseconds = millis();
-  this->scrollPosition = 0;
+  if (isReinitialized || screen.isBacklightOn != this->renderedScreen.isBacklightOn) {
+    if (screen.isBacklightOn) {
+      this->lcd->backlight();
+    } else {
+      this->lcd->noBacklight();
+    }
 
-  if (topRowText != this->topRowText) {
-    this->clearTopRow();
-    this->topRowText = topRowText;
+    this->renderedScreen.isBacklightOn = screen.isBacklightOn;
+  }
 
-    this->lcd->setCursor(0, 0);
-    this->lcd->print(this->topRowText);
+  bool hasTextChanged = strcmp(screen.topRowText, this->renderedScreen.topRowText) != 0 || strcmp(screen.bottomRowText, this->renderedScreen.bottomRowText) != 0;
+
+  if (hasTextChanged) {
+    memcpy(this->renderedScreen.topRowText, screen.topRowText, sizeof(screen.topRowText));
+    memcpy(this->renderedScreen.bottomRowText, screen.bottomRowText, sizeof(screen.bottomRowText));
+
+    this->marquee.start(strlen(this->renderedScreen.topRowText), millis());
+
+    this->renderRow(0, this->renderedScreen.topRowText, 0);
+    this->renderRow(1, this->renderedScreen.bottomRowText, 0);
   }
 
-  if (bottomRowText != this->bottomRowText) {
-    this->clearBottomRow();
-    this->bottomRowText = bottomRowText;
+  this->flush();
+}
 
-    this->lcd->setCursor(0, 1);
-    this->lcd->print(this->bottomRowText);
+void LcdWrapper::scroll() {
+  if (this->marquee.update(millis(), this->getScrollCharacterMiliseconds())) {
+    this->renderRow(0, this->renderedScreen.topRowText, this->marquee.getPosition());
   }
 }
 
-void LcdWrapper::print(String topRowText) {
-  if (topRowText == this->topRowText && this->bottomRowText == "") {
-    return;
+uint16_t LcdWrapper::getScrollCharacterMiliseconds() {
+  int characterMiliseconds = this->readScrollSpeed();
+
+  if (characterMiliseconds < LCD_SCROLL_MIN_CHARACTER_MILISECONDS) {
+    return LCD_SCROLL_MIN_CHARACTER_MILISECONDS;
   }
 
-  this->lcd->home();
-  this->lastPrintMiliseconds = millis();
+  return characterMiliseconds > UINT16_MAX ? UINT16_MAX : characterMiliseconds;
+}
 
-  this->topRowText = topRowText;
-  this->bottomRowText = ""; 
-  this->scrollPosition = 0;
+/**
+ * After init LCD is cleared and cursor is at home
+ */
+void LcdWrapper::resetDisplayedFrame() {
+  memset(this->displayedFrame, ' ', sizeof(this->displayedFrame));
+  this->cursorColumn = 0;
+  this->cursorRow = 0;
+}
 
-  this->lcd->clear();
-  this->lcd->setCursor(0, 0);
-  this->lcd->print(this->topRowText);
+void LcdWrapper::renderRow(uint8_t row, const char* text, uint16_t offset) {
+  uint16_t textLength = strlen(text);
+
+  for (uint8_t column = 0; column < LCD_COLUMNS; column++) {
+    uint16_t index = offset + column;
+
+    this->frame[row][column] = index < textLength ? text[index] : ' ';
+  }
 }
 
+/**
+ * LCD moves cursor right after each character, so setCursor is needed only when skipping unchanged cells
+ */
+void LcdWrapper::flush() {
+  this->lcd->beginBatch();
+
+  for (uint8_t row = 0; row < LCD_ROWS; row++) {
+    for (uint8_t column = 0; column < LCD_COLUMNS; column++) {
+      char character = this->frame[row][column];
+
+      if (this->displayedFrame[row][column] == character) {
+        continue;
+      }
+
+      if (this->cursorRow != row || this->cursorColumn != column) {
+        this->lcd->setCursor(column, row);
+        this->cursorRow = row;
+      }
+
+      this->lcd->write(character);
+      this->displayedFrame[row][column] = character;
+      this->cursorColumn = column + 1;
+    }
+  }
+
+  this->lcd->endBatch();
+}
\ No newline at end of file
@@ -2,31 +2,90 @@
 #define LCD_WRAPPER_H
 
 #include <Arduino.h>
-#include <LiquidCrystal_I2C.h>
+#include <batchedLcd.h>
+#include <lcdMarquee.h>
 
-const int printDelay = 2000;
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#endif
 
+const uint8_t LCD_COLUMNS = 16;
+const uint8_t LCD_ROWS = 2;
+const uint8_t LCD_TEXT_MAX_LENGTH = 40; // HD44780 DDRAM row, longer texts are cut
+const uint16_t LCD_RENDER_FRAME_INTERVAL_MILISECONDS = 50; // Frame rate cap (20 fps)
+
+// Desired state of the display, render task draws only the latest one
+struct LcdScreen {
+  char topRowText[LCD_TEXT_MAX_LENGTH + 1];
+  char bottomRowText[LCD_TEXT_MAX_LENGTH + 1];
+  bool isBacklightOn;
+  uint32_t initializationsCount; // LCD is re-initialized when it changes (turnOn)
+};
+
+/**
+ * Callers only describe desired screen, it is never drawn from their task (no I2C, no blocking on the bus)
+ * Render task is the only owner of LCD, screens submitted faster than frame rate are coalesced into the latest one
+ * Renderer keeps RAM frame, flush() sends only cells which differ from what LCD shows (batched into few I2C transactions)
+ * Top row longer than 16 columns is scrolled in software (no scrollDisplayLeft / Right),
+ * render task wakes up for marquee steps only while such text is displayed
+ */
 class LcdWrapper {
   private:
-    LiquidCrystal_I2C* lcd;
-    String topRowText = "";
-    String bottomRowText = "";
-    uint16_t scrollPosition = 0;
-    uint16_t lastPrintMiliseconds = 0;
+    BatchedLcd* lcd;
+    int (*readScrollSpeed)(); // Miliseconds per character, setting can change at any time
+
+    // Callers side
+    LcdScreen screen;
+
+#ifdef ESP_PLATFORM
+    QueueHandle_t screensQueue;
+    SemaphoreHandle_t screenMutex;
+    TaskHandle_t taskHandle;
+
+    static void taskFunction(void* param);
+    void run();
+#endif
+
+    void lockScreen();
+    void unlockScreen();
+    void submitScreen();
+
+    // Render task side
+    LcdScreen renderedScreen;
+    LcdMarquee marquee;
+
+    char frame[LCD_ROWS][LCD_COLUMNS];
+    char displayedFrame[LCD_ROWS][LCD_COLUMNS];
+    uint8_t cursorColumn; // Where next written character lands, LCD_COLUMNS = unknown / off screen
+    uint8_t cursorRow;
+
+    void renderScreen(const LcdScreen& screen);
+    void scroll();
+    uint16_t getScrollCharacterMiliseconds();
+    void renderRow(uint8_t row, const char* text, uint16_t offset);
+    void resetDisplayedFrame();
+    void flush();
 
   public:
-    LcdWrapper(LiquidCrystal_I2C* lcd);
-    void checkScroll();
+    LcdWrapper(BatchedLcd* lcd, int (*readScrollSpeed)());
+    void initialize(uint32_t stackSize);
     void backlight();
     void noBacklight();
     void turnOn();
     void turnOff();
     void print(String topRowText);
     void print(String topRowText, String bottomRowText);
-    void initialize();
+    void print(const char* topRowText, const char* bottomRowText = ""); // No heap, for texts redrawn every tick
     void clear();
     void clearBottomRow();
     void clearTopRow();
+
+#ifdef ESP_PLATFORM
+    TaskHandle_t getTaskHandle();
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <ledAnimation.h>
+
+bool LedPattern::addKeyframe(LedColor color, uint16_t fadeMiliseconds, uint16_t holdMiliseconds) {
+    if (this->keyframesCount >= LED_PATTERN_MAX_KEYFRAMES) {
+        return false;
+    }
+
+    this->keyframes[this->keyframesCount] = LedKeyframe{
+        color: color,
+        fadeMiliseconds: fadeMiliseconds,
+        holdMiliseconds: holdMiliseconds
+    };
+    this->keyframesCount++;
+
+    return true;
+}
+
+uint32_t LedPattern::getDurationMiliseconds() {
+    uint32_t duration = 0;
+
+    for (uint8_t i = 0; i < this->keyframesCount; i++) {
+        duration += this->keyframes[i].fadeMiliseconds + this->keyframes[i].holdMiliseconds;
+    }
+
+    return duration;
+}
+
+LedPattern LedPatterns::solid(LedColor color) {
+    LedPattern pattern;
+    pattern.addKeyframe(color, 0, 0);
+
+    return pattern;
+}
+
+LedPattern LedPatterns::pulse(LedColor color, uint16_t periodMiliseconds) {
+    uint16_t fadeMiliseconds = periodMiliseconds / 10;
+
+    LedPattern pattern;
+    pattern.isLooped = true;
+    pattern.addKeyframe(color, fadeMiliseconds, 0);
+    pattern.addKeyframe(LED_COLOR_OFF, fadeMiliseconds * 2, periodMiliseconds - fadeMiliseconds * 3);
+
+    return pattern;
+}
+
+LedPattern LedPatterns::breathing(LedColor color, uint16_t periodMiliseconds) {
+    uint16_t fadeMiliseconds = periodMiliseconds / 2;
+
+    LedPattern pattern;
+    pattern.isLooped = true;
+    pattern.addKeyframe(color, fadeMiliseconds, 0);
+    pattern.addKeyframe(LED_COLOR_OFF, periodMiliseconds - fadeMiliseconds, 0);
+
+    return pattern;
+}
+
+LedPattern LedPatterns::colorCycle(const LedColor* colors, uint8_t colorsCount, uint16_t colorMiliseconds) {
+    // Same on / off rhythm as one color blinking, fades take part of both halves
+    uint16_t halfMiliseconds = colorMiliseconds / 2;
+    uint16_t fadeMiliseconds = halfMiliseconds / 4;
+
+    LedPattern pattern;
+    pattern.isLooped = true;
+
+    for (uint8_t i = 0; i < colorsCount; i++) {
+        if (
+            !pattern.addKeyframe(colors[i], fadeMiliseconds, halfMiliseconds - fadeMiliseconds) ||
+            !pattern.addKeyframe(LED_COLOR_OFF, fadeMiliseconds, colorMiliseconds - halfMiliseconds - fadeMiliseconds)
+        ) {
+            break;
+        }
+    }
+
+    return pattern;
+}
\ No newline at end of file
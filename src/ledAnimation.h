@@ -0,0 +1,41 @@
+#ifndef LED_ANIMATION_H
+#define LED_ANIMATION_H
+
+#include <Arduino.h>
+
+const uint8_t LED_PATTERN_MAX_KEYFRAMES = 16;
+
+struct LedColor {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+};
+
+const LedColor LED_COLOR_OFF = LedColor{ red: 0, green: 0, blue: 0 };
+
+struct LedKeyframe {
+    LedColor color;
+    uint16_t fadeMiliseconds; // Hardware fade from previous color, 0 = step
+    uint16_t holdMiliseconds; // After fade, before next keyframe
+};
+
+struct LedPattern {
+    LedKeyframe keyframes[LED_PATTERN_MAX_KEYFRAMES];
+    uint8_t keyframesCount = 0;
+    bool isLooped = false;
+
+    bool addKeyframe(LedColor color, uint16_t fadeMiliseconds, uint16_t holdMiliseconds);
+    uint32_t getDurationMiliseconds();
+};
+
+/**
+ * Keyframe sequences for LedWrapper, no hardware access
+ */
+namespace LedPatterns {
+    LedPattern solid(LedColor color);
+    LedPattern pulse(LedColor color, uint16_t periodMiliseconds); // Short flash, then dark
+    LedPattern breathing(LedColor color, uint16_t periodMiliseconds); // Slow fade in and out
+    LedPattern colorCycle(const LedColor* colors, uint8_t colorsCount, uint16_t colorMiliseconds); // Each color faded in and out, LED off in between
+}
+
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <ledWrapper.h>
+#include <driver/ledc.h>
 
 LedWrapper::LedWrapper(uint8_t redChannel, byte redGpio, uint8_t greenChannel, byte greenGpio, uint8_t blueChannel, byte blueGpio) {
     this->redGpio = redGpio;
@@ -8,9 +9,13 @@ LedWrapper::LedWrapper(uint8_t redChannel, byte redGpio, uint8_t greenChannel, b
     this->redChannel = redChannel;
     this->greenChannel = greenChannel;
     this->blueChannel = blueChannel;
+
+    this->patternsQueue = nullptr;
+    this->taskHandle = nullptr;
+    this->patternsCount = 0;
 }
 
-void LedWrapper::initialize() {
+void LedWrapper::initialize(uint32_t stackSize) {
     ledcSetup(redChannel, PWM_LED_FREQUENCY, PWM_LED_RESOLUTION);
     ledcSetup(greenChannel, PWM_LED_FREQUENCY, PWM_LED_RESOLUTION);
     ledcSetup(blueChannel, PWM_LED_FREQUENCY, PWM_LED_RESOLUTION);
@@ -18,12 +23,106 @@ void LedWrapper::initialize() {
     ledcAttachPin(redGpio, redChannel);
     ledcAttachPin(greenGpio, greenChannel);
     ledcAttachPin(blueGpio, blueChannel);
+
+    ledc_fade_func_install(0);
+
+    this->patternsQueue = xQueueCreate(1, sizeof(LedPattern));
+    xTaskCreate(LedWrapper::taskFunction, "LedAnimationTask", stackSize, this, 1, &this->taskHandle);
+}
+
+void LedWrapper::taskFunction(void* param) {
+    static_cast<LedWrapper*>(param)->run();
+}
+
+void LedWrapper::run() {
+    LedPattern pattern;
+    bool hasPattern = false;
+
+    while (true) {
+        if (!hasPattern) {
+            xQueueReceive(this->patternsQueue, &pattern, portMAX_DELAY);
+        }
+
+        hasPattern = this->playPattern(pattern);
+    }
+}
+
+/**
+ * Returns true when interrupted, newer pattern is already received into given one
+ */
+bool LedWrapper::playPattern(LedPattern& pattern) {
+    do {
+        for (uint8_t i = 0; i < pattern.keyframesCount; i++) {
+            LedKeyframe keyframe = pattern.keyframes[i];
+
+            this->fadeTo(keyframe.color, keyframe.fadeMiliseconds);
+
+            // Fade runs in hardware, nothing to do until next keyframe
+            if (xQueueReceive(this->patternsQueue, &pattern, pdMS_TO_TICKS(keyframe.fadeMiliseconds + keyframe.holdMiliseconds)) == pdTRUE) {
+                return true;
+            }
+        }
+    } while (pattern.isLooped);
+
+    return false;
+}
+
+void LedWrapper::fadeTo(LedColor color, uint16_t fadeMiliseconds) {
+    this->fadeChannel(this->redChannel, color.red, fadeMiliseconds);
+    this->fadeChannel(this->greenChannel, color.green, fadeMiliseconds);
+    this->fadeChannel(this->blueChannel, color.blue, fadeMiliseconds);
+}
+
+/**
+ * Arduino LEDC channels 0 - 7 are high speed, 8 - 15 low speed group
+ * LED is common anode, duty is inverted
+ */
+void LedWrapper::fadeChannel(uint8_t channel, uint8_t value, uint16_t fadeMiliseconds) {
+    ledc_mode_t speedMode = (ledc_mode_t)(channel / 8);
+    ledc_channel_t ledcChannel = (ledc_channel_t)(channel % 8);
+    uint32_t duty = 255 - value;
+
+    if (fadeMiliseconds == 0) {
+        ledc_set_duty(speedMode, ledcChannel, duty);
+        ledc_update_duty(speedMode, ledcChannel);
+        return;
+    }
+
+    ledc_set_fade_with_time(speedMode, ledcChannel, duty, fadeMiliseconds);
+    ledc_fade_start(speedMode, ledcChannel, LEDC_FADE_NO_WAIT);
+}
+
+/**
+ * Never blocks
+ */
+bool LedWrapper::play(const LedPattern& pattern) {
+    if (this->patternsQueue == nullptr || pattern.keyframesCount == 0) {
+        return false;
+    }
+
+    LedPattern patternToPlay = pattern;
+
+    // Looped pattern without any duration would never let the task sleep
+    if (patternToPlay.getDurationMiliseconds() == 0) {
+        patternToPlay.isLooped = false;
+    }
+
+    this->patternsCount++;
+    xQueueOverwrite(this->patternsQueue, &patternToPlay);
+
+    return true;
+}
+
+uint32_t LedWrapper::getPatternsCount() {
+    return this->patternsCount;
+}
+
+TaskHandle_t LedWrapper::getTaskHandle() {
+    return this->taskHandle;
 }
 
 void LedWrapper::setColor(uint8_t red, uint8_t green, uint8_t blue) {
-    ledcWrite(redChannel, 255 - red);
-    ledcWrite(greenChannel, 255 - green);
-    ledcWrite(blueChannel, 255 - blue);
+    this->play(LedPatterns::solid(LedColor{ red: red, green: green, blue: blue }));
 }
 
 void LedWrapper::setNoColor() {
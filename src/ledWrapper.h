@@ -2,10 +2,21 @@
 #define LED_WRAPPER_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+
+#include <ledAnimation.h>
 
 #define PWM_LED_FREQUENCY   12000
 #define PWM_LED_RESOLUTION  8
 
+/**
+ * Colors are played as keyframe patterns by animation task
+ * Transitions are faded by LEDC hardware, task only wakes up once per keyframe
+ * Newer pattern (or plain color) interrupts the one being played
+ */
 class LedWrapper {
     private:
         byte redGpio;
@@ -15,9 +26,23 @@ class LedWrapper {
         uint8_t greenChannel;
         uint8_t blueChannel;
 
+        QueueHandle_t patternsQueue;
+        TaskHandle_t taskHandle;
+        std::atomic<uint32_t> patternsCount;
+
+        static void taskFunction(void* param);
+        void run();
+        bool playPattern(LedPattern& pattern);
+        void fadeTo(LedColor color, uint16_t fadeMiliseconds);
+        void fadeChannel(uint8_t channel, uint8_t value, uint16_t fadeMiliseconds);
+
     public:
         LedWrapper(uint8_t redChannel, byte redGpio, uint8_t greenChannel, byte greenGpio, uint8_t blueChannel, byte blueGpio);
-        void initialize();
+        void initialize(uint32_t stackSize);
+
+        bool play(const LedPattern& pattern);
+        uint32_t getPatternsCount(); // Changes whenever anything is played
+        TaskHandle_t getTaskHandle();
 
         void setColor(uint8_t red, uint8_t green, uint8_t blue);
         void setNoColor();
@@ -33,4 +58,4 @@ class LedWrapper {
         void setColorOrange();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,23 +1,37 @@
 #include <logs.h>
 #include <timeHelpers.h>
 
-vector<Log> logs;
+FixedVector<Log, MAX_LOGS> logs;
+
+LogRecord logsHistory[MAX_LOGS_HISTORY];
+uint32_t logsHistoryNextSequence = 0;
+portMUX_TYPE logsHistoryMux = portMUX_INITIALIZER_UNLOCKED;
+
+void addLogRecord(double temperature, int windowOpening, int deltaTemporaryWindowOpening) {
+    LogRecord record;
+    record.date = time(nullptr);
+    record.temperature = temperature;
+    record.windowOpening = windowOpening;
+    record.deltaTemporaryWindowOpening = deltaTemporaryWindowOpening;
+
+    portENTER_CRITICAL(&logsHistoryMux);
+    logsHistory[logsHistoryNextSequence % MAX_LOGS_HISTORY] = record;
+    logsHistoryNextSequence++;
+    portEXIT_CRITICAL(&logsHistoryMux);
+}
 
 void addLog(double temperature, int windowOpening, int deltaTemporaryWindowOpening) {
     Serial.println("Adding log locally: to history");
     Log newLog;
 
-    String currentTime = getCurrentTime();
-
-    if (currentTime == "") {
+    if (!formatCurrentTime(newLog.date, sizeof(newLog.date))) {
         Serial.println("Aborting adding log locally - current time is empty");
         return;
     }
 
     Serial.print("Current time: ");
-    Serial.println(currentTime);
+    Serial.println(newLog.date);
 
-    newLog.date = currentTime;
     newLog.temperature = temperature;
     newLog.windowOpening = windowOpening;
     newLog.deltaTemporaryWindowOpening = deltaTemporaryWindowOpening;
@@ -32,11 +46,12 @@ void addLog(double temperature, int windowOpening, int deltaTemporaryWindowOpeni
     Serial.print("Delta Temporary Window Opening: ");
     Serial.println(newLog.deltaTemporaryWindowOpening);
 
-    logs.push_back(newLog);
-
-    if (logs.size() > MAX_LOGS) {
-        logs.erase(logs.begin());
+    if (logs.full()) {
+        logs.erase(0);
     }
+
+    logs.push_back(newLog);
+    addLogRecord(temperature, windowOpening, deltaTemporaryWindowOpening);
 }
 
 vector<Log> getLastLogs(int amount) {
@@ -46,9 +61,84 @@ vector<Log> getLastLogs(int amount) {
         amount = logs.size();
     }
 
-    for (auto it = logs.rbegin(); it != logs.rbegin() + amount; it++) {
-        lastLogs.push_back(*it);
+    for (int i = logs.size() - 1; i >= (int) logs.size() - amount; i--) {
+        lastLogs.push_back(logs[i]);
     }
 
     return lastLogs;
+}
+
+uint32_t getLogsHistoryFirstSequence() {
+    uint32_t nextSequence = getLogsHistoryNextSequence();
+
+    return nextSequence > MAX_LOGS_HISTORY ? nextSequence - MAX_LOGS_HISTORY : 0;
+}
+
+uint32_t getLogsHistoryNextSequence() {
+    portENTER_CRITICAL(&logsHistoryMux);
+    uint32_t nextSequence = logsHistoryNextSequence;
+    portEXIT_CRITICAL(&logsHistoryMux);
+
+    return nextSequence;
+}
+
+/**
+ * Copies record out of the ring, false if it has been already overwritten or not yet written
+ */
+bool readLogRecord(uint32_t sequence, LogRecord& record) {
+    bool isAvailable = false;
+
+    portENTER_CRITICAL(&logsHistoryMux);
+    if (sequence < logsHistoryNextSequence && logsHistoryNextSequence - sequence <= MAX_LOGS_HISTORY) {
+        record = logsHistory[sequence % MAX_LOGS_HISTORY];
+        isAvailable = true;
+    }
+    portEXIT_CRITICAL(&logsHistoryMux);
+
+    return isAvailable;
+}
+
+/**
+ * Oldest first, returns how many records were copied
+ */
+uint8_t copyNewestLogRecords(LogRecord* records, uint8_t maxCount) {
+    portENTER_CRITICAL(&logsHistoryMux);
+    uint32_t availableCount = min<uint32_t>(logsHistoryNextSequence, MAX_LOGS_HISTORY);
+    uint8_t count = min<uint32_t>(availableCount, maxCount);
+    uint32_t firstSequence = logsHistoryNextSequence - count;
+
+    for (uint8_t i = 0; i < count; i++) {
+        records[i] = logsHistory[(firstSequence + i) % MAX_LOGS_HISTORY];
+    }
+    portEXIT_CRITICAL(&logsHistoryMux);
+
+    return count;
+}
+
+/**
+ * Sequence numbers continue where they ended before deep sleep (BLE transfers rely on them)
+ */
+void restoreLogRecords(const LogRecord* records, uint8_t count, uint32_t nextSequence) {
+    count = min<uint32_t>(count, nextSequence);
+
+    portENTER_CRITICAL(&logsHistoryMux);
+    logsHistoryNextSequence = nextSequence - count;
+
+    for (uint8_t i = 0; i < count; i++) {
+        logsHistory[logsHistoryNextSequence % MAX_LOGS_HISTORY] = records[i];
+        logsHistoryNextSequence++;
+    }
+    portEXIT_CRITICAL(&logsHistoryMux);
+
+    logs.clear();
+
+    for (uint8_t i = max(0, count - MAX_LOGS); i < count; i++) {
+        Log restoredLog;
+        formatDate(records[i].date, restoredLog.date, sizeof(restoredLog.date));
+        restoredLog.temperature = records[i].temperature;
+        restoredLog.windowOpening = records[i].windowOpening;
+        restoredLog.deltaTemporaryWindowOpening = records[i].deltaTemporaryWindowOpening;
+
+        logs.push_back(restoredLog);
+    }
 }
\ No newline at end of file
@@ -3,21 +3,41 @@
 
 #include <Arduino.h>
 #include <vector>
+#include <fixedVector.h>
+#include <timeHelpers.h>
 
 using namespace std;
 
 const int MAX_LOGS = 10;
+const int MAX_LOGS_HISTORY = 2016; // One week of logs with default 5 minutes interval
 
 struct Log {
-    String date;
+    char date[DATE_STRING_LENGTH];
     double temperature;
     int windowOpening;
     int deltaTemporaryWindowOpening;
 };
 
-extern vector<Log> logs;
+// Compact form of Log kept in history ring (full history is only streamed over BLE)
+struct LogRecord {
+    uint32_t date; // Unix timestamp
+    float temperature;
+    int16_t windowOpening;
+    int16_t deltaTemporaryWindowOpening;
+};
+
+extern FixedVector<Log, MAX_LOGS> logs; // Oldest first
 
 void addLog(double temperature, int windowOpening, int deltaTemporaryWindowOpening);
 vector<Log> getLastLogs(int amount);
 
+// History ring: every record gets growing sequence number, oldest ones are overwritten
+uint32_t getLogsHistoryFirstSequence();
+uint32_t getLogsHistoryNextSequence();
+bool readLogRecord(uint32_t sequence, LogRecord& record);
+
+// Fast resume after deep sleep, only newest records fit into RTC memory
+uint8_t copyNewestLogRecords(LogRecord* records, uint8_t maxCount);
+void restoreLogRecords(const LogRecord* records, uint8_t count, uint32_t nextSequence);
+
 #endif
\ No newline at end of file
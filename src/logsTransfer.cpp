@@ -0,0 +1,201 @@
+#include <Arduino.h>
+#include <logsTransfer.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_system.h>
+#endif
+
+LogsTransfer::LogsTransfer(uint32_t (*getFirstSequence)(), uint32_t (*getNextSequence)(), bool (*readRecord)(uint32_t sequence, LogRecord& record)) {
+  this->getFirstSequence = getFirstSequence;
+  this->getNextSequence = getNextSequence;
+  this->readRecord = readRecord;
+  this->chunkBuffer[0] = '\0';
+}
+
+void LogsTransfer::lock() {
+#ifdef ESP_PLATFORM
+  portENTER_CRITICAL(&this->mux);
+#endif
+}
+
+void LogsTransfer::unlock() {
+#ifdef ESP_PLATFORM
+  portEXIT_CRITICAL(&this->mux);
+#endif
+}
+
+uint32_t LogsTransfer::getFreeHeap() {
+#ifdef ESP_PLATFORM
+  return esp_get_free_heap_size();
+#else
+  return 0;
+#endif
+}
+
+uint32_t LogsTransfer::start(uint32_t offset, unsigned long currentMillis) {
+  uint32_t firstOffset = this->getFirstSequence();
+  uint32_t endOffset = this->getNextSequence();
+  uint32_t freeHeap = this->getFreeHeap();
+
+  // Older records have been already overwritten in the ring
+  if (offset < firstOffset) {
+    offset = firstOffset;
+  }
+
+  if (offset > endOffset) {
+    offset = endOffset;
+  }
+
+  this->lock();
+  this->isActive = true;
+  this->chunkSequence = 0;
+  this->startOffset = offset;
+  this->nextOffset = offset;
+  this->acknowledgedOffset = offset;
+  this->endOffset = endOffset;
+  this->bytesSent = 0;
+  this->startMillis = currentMillis;
+  this->lastAcknowledgmentMillis = currentMillis;
+  this->startFreeHeap = freeHeap;
+  this->minimumFreeHeap = freeHeap;
+  this->unlock();
+
+  Serial.print("Logs transfer started from offset: ");
+  Serial.println(offset);
+
+  return offset;
+}
+
+void LogsTransfer::acknowledge(uint32_t offset, unsigned long currentMillis) {
+  this->lock();
+  if (this->isActive && offset > this->acknowledgedOffset && offset <= this->nextOffset) {
+    this->acknowledgedOffset = offset;
+    this->lastAcknowledgmentMillis = currentMillis;
+  }
+  this->unlock();
+}
+
+void LogsTransfer::cancel() {
+  this->lock();
+  this->isActive = false;
+  this->unlock();
+}
+
+bool LogsTransfer::isTransferActive() {
+  this->lock();
+  bool isActive = this->isActive;
+  this->unlock();
+
+  return isActive;
+}
+
+uint32_t LogsTransfer::getEndOffset() {
+  this->lock();
+  uint32_t endOffset = this->endOffset;
+  this->unlock();
+
+  return endOffset;
+}
+
+/**
+ * One chunk per call while the window allows it, summary once everything is acknowledged
+ * Chunk is reserved under the lock (offsets and end are read together), it is built from that snapshot afterwards
+ */
+uint16_t LogsTransfer::buildNextMessage(unsigned long currentMillis) {
+  uint32_t freeHeap = this->getFreeHeap();
+
+  this->lock();
+  if (!this->isActive) {
+    this->unlock();
+    return 0;
+  }
+
+  if (freeHeap < this->minimumFreeHeap) {
+    this->minimumFreeHeap = freeHeap;
+  }
+
+  // No acknowledgment in time, going back to last confirmed record
+  bool hasAcknowledgmentTimedOut = this->nextOffset > this->acknowledgedOffset && currentMillis - this->lastAcknowledgmentMillis > LOGS_TRANSFER_ACK_TIMEOUT_MILISECONDS;
+
+  if (hasAcknowledgmentTimedOut) {
+    this->nextOffset = this->acknowledgedOffset;
+    this->lastAcknowledgmentMillis = currentMillis;
+  }
+
+  uint32_t offset = this->nextOffset;
+  uint32_t endOffset = this->endOffset;
+  uint32_t sequence = this->chunkSequence;
+  bool isFinished = this->acknowledgedOffset >= endOffset;
+  uint32_t windowEndOffset = this->acknowledgedOffset + LOGS_TRANSFER_WINDOW_CHUNKS * LOGS_TRANSFER_RECORDS_PER_CHUNK;
+  uint32_t recordsInChunk = 0;
+
+  if (isFinished) {
+    this->isActive = false;
+  } else if (offset < endOffset && offset < windowEndOffset) {
+    recordsInChunk = min<uint32_t>(LOGS_TRANSFER_RECORDS_PER_CHUNK, endOffset - offset);
+    this->nextOffset = offset + recordsInChunk;
+    this->chunkSequence++;
+  }
+
+  uint32_t recordsCount = endOffset - this->startOffset;
+  uint32_t bytesSent = this->bytesSent;
+  unsigned long durationMiliseconds = currentMillis - this->startMillis;
+  uint32_t heapPeakBytes = this->startFreeHeap - this->minimumFreeHeap;
+  this->unlock();
+
+  if (hasAcknowledgmentTimedOut) {
+    Serial.println("Logs transfer: acknowledgment timeout, resending");
+  }
+
+  if (isFinished) {
+    uint32_t bytesPerSecond = durationMiliseconds > 0 ? (uint64_t) bytesSent * 1000 / durationMiliseconds : bytesSent;
+
+    int length = snprintf(chunkBuffer, sizeof(chunkBuffer), "[{\"commandType\":\"LOGS_TRANSFER_FINISHED\",\"data\":{\"records\":%u,\"bytes\":%u,\"durationMiliseconds\":%lu,\"bytesPerSecond\":%u,\"heapPeakBytes\":%u,\"chunkBufferBytes\":%u}}]", recordsCount, bytesSent, durationMiliseconds, bytesPerSecond, heapPeakBytes, (unsigned) sizeof(chunkBuffer));
+
+    Serial.print("Logs transfer finished: ");
+    Serial.println(chunkBuffer);
+
+    return min<int>(length, sizeof(chunkBuffer) - 1);
+  }
+
+  if (recordsInChunk == 0) {
+    return 0;
+  }
+
+  uint16_t length = this->buildChunk(sequence, offset, recordsInChunk, endOffset);
+
+  this->lock();
+  this->bytesSent += length;
+  this->unlock();
+
+  return length;
+}
+
+const char* LogsTransfer::getMessage() {
+  return this->chunkBuffer;
+}
+
+/**
+ * Writes chunk straight from the history ring into chunkBuffer
+ */
+uint16_t LogsTransfer::buildChunk(uint32_t sequence, uint32_t offset, uint32_t recordsInChunk, uint32_t endOffset) {
+  int length = snprintf(chunkBuffer, sizeof(chunkBuffer), "[{\"commandType\":\"LOGS_CHUNK\",\"data\":{\"seq\":%u,\"offset\":%u,\"end\":%u,\"records\":[", sequence, offset, endOffset);
+
+  bool isFirstRecord = true;
+
+  for (uint32_t i = 0; i < recordsInChunk; i++) {
+    LogRecord record;
+
+    // Record overwritten during transfer, it is skipped but still counted so client can follow offsets
+    if (!this->readRecord(offset + i, record)) {
+      continue;
+    }
+
+    length += snprintf(chunkBuffer + length, sizeof(chunkBuffer) - length, "%s[%u,%.2f,%d,%d]", isFirstRecord ? "" : ",", record.date, record.temperature, record.windowOpening, record.deltaTemporaryWindowOpening);
+    isFirstRecord = false;
+  }
+
+  length += snprintf(chunkBuffer + length, sizeof(chunkBuffer) - length, "],\"count\":%u}}]", recordsInChunk);
+
+  return min<int>(length, sizeof(chunkBuffer) - 1);
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef LOGS_TRANSFER_H
+#define LOGS_TRANSFER_H
+
+#include <Arduino.h>
+
+#include <logs.h>
+
+const uint8_t LOGS_TRANSFER_RECORDS_PER_CHUNK = 6;
+const uint8_t LOGS_TRANSFER_WINDOW_CHUNKS = 4; // How many chunks can be sent without acknowledgment
+const uint16_t LOGS_TRANSFER_ACK_TIMEOUT_MILISECONDS = 3000; // After that sending restarts from last acknowledged offset
+const uint16_t LOGS_TRANSFER_CHUNK_BUFFER_SIZE = 400;
+
+/**
+ * Streams logs history ring over BLE in chunks
+ * Every chunk has sequence number and offset (sequence of its first record)
+ * Client acknowledges with offset of the next record it expects (cumulative), so any transfer can be resumed from that offset
+ * Commands come from BLE callbacks task, chunks are built in sending task, whole transfer state is guarded by mux
+ */
+class LogsTransfer {
+  private:
+    uint32_t (*getFirstSequence)();
+    uint32_t (*getNextSequence)();
+    bool (*readRecord)(uint32_t sequence, LogRecord& record);
+
+    bool isActive = false;
+    uint32_t chunkSequence = 0;
+    uint32_t nextOffset = 0; // Next record to be sent
+    uint32_t acknowledgedOffset = 0; // All records below are confirmed by client
+    uint32_t endOffset = 0; // Snapshot of history end when transfer started
+    unsigned long lastAcknowledgmentMillis = 0;
+
+    // Statistics
+    uint32_t startOffset = 0;
+    uint32_t bytesSent = 0;
+    unsigned long startMillis = 0;
+    uint32_t startFreeHeap = 0;
+    uint32_t minimumFreeHeap = 0;
+
+    char chunkBuffer[LOGS_TRANSFER_CHUNK_BUFFER_SIZE]; // Only touched by sending task
+
+#ifdef ESP_PLATFORM
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+    void lock();
+    void unlock();
+    uint32_t getFreeHeap();
+    uint16_t buildChunk(uint32_t sequence, uint32_t offset, uint32_t recordsInChunk, uint32_t endOffset);
+
+  public:
+    LogsTransfer(uint32_t (*getFirstSequence)(), uint32_t (*getNextSequence)(), bool (*readRecord)(uint32_t sequence, LogRecord& record));
+    uint32_t start(uint32_t offset, unsigned long currentMillis); // Returns offset transfer really starts from
+    void acknowledge(uint32_t offset, unsigned long currentMillis);
+    void cancel();
+    bool isTransferActive();
+    uint32_t getEndOffset();
+    uint16_t buildNextMessage(unsigned long currentMillis); // Length of message in getMessage(), 0 - nothing to send now
+    const char* getMessage();
+};
+
+#endif
\ No newline at end of file
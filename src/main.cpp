@@ -9,12 +9,13 @@
 #include <Adafruit_BME280.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
-#include <LiquidCrystal_I2C.h>
+#include <batchedLcd.h>
 #include <WiFiClientSecure.h>
 
 #include <gpios.h>
 #include <memoryData.h>
 #include <buttonHandler.h>
+#include <buttonInput.h>
 #include <navigation.h>
 #include <servoWrapper.h>
 #include <ledWrapper.h>
@@ -28,14 +29,24 @@
 #include <lcdWrapper.h>
 #include <bluetoothWrapper.h>
 #include <batteryVoltageMeter.h>
+#include <adcSampler.h>
 #include <timeHelpers.h>
 #include <periodicalTasksQueue.h>
-#include <valuesJitterFilter.h>
 #include <servosPowerSupply.h>
+#include <bme280Sensor.h>
+#include <sensorSampler.h>
+#include <motionExecutor.h>
+#include <powerManager.h>
+#include <rtcResume.h>
+#include <bootTracer.h>
+#include <initGraph.h>
+#include <allocationTracker.h>
+#include <fixedVector.h>
+#include <esp_heap_caps.h>
 /**
  * How to simulate calculations:
  * AppModeEnum AppMode = Manual; -> Auto
- * float currentTemperature = bme.readTemperature(); -> hardcode temperature
+ * float currentTemperature = sensorSampler.getSnapshot().reading.temperature; -> hardcode temperature
  */
 
 #define EEPROM_SIZE 768
@@ -47,50 +58,82 @@ TwoWire I2C_BME_280 = TwoWire(1);
 
 // Task Handles
 TaskHandle_t CheckPeriodicalTasksQueue;
-TaskHandle_t ServosSmoothMovementTask;
 TaskHandle_t WindowOpeningCalculationTask;
 TaskHandle_t NTPTask;
 // Optional
 TaskHandle_t CheckMemoryTask;
 
 const int CHECK_PERIODICAL_TASKS_QUEUE_TASK_STACK_SIZE = 14336;
-const int SERVOS_SMOOTH_MOVEMENT_TASK_STACK_SIZE = 1536;
+const int MOTION_EXECUTOR_TASK_STACK_SIZE = 2048;
 const int WINDOW_OPENING_CALCULATION_TASK_STACK_SIZE = 4096;
 const int NTP_TASK_STACK_SIZE = 3072;
+const int SENSOR_SAMPLER_TASK_STACK_SIZE = 2048;
+const int LCD_RENDER_TASK_STACK_SIZE = 2048;
+const int LED_ANIMATION_TASK_STACK_SIZE = 2048;
+const int BUTTON_INPUT_TASK_STACK_SIZE = 2048;
+const int ADC_SAMPLER_TASK_STACK_SIZE = 2048;
+const int BLUETOOTH_INIT_TASK_STACK_SIZE = 4096;
+const int WIFI_INIT_TASK_STACK_SIZE = 3072;
+const int BOOT_REPORT_TASK_STACK_SIZE = 2048;
+
+const int MENU_SELECTION_POLL_MILISECONDS = 20; // Potentiometer, only while awake
+const int CHECK_PERIODICAL_TASKS_QUEUE_MAX_WAIT_MILISECONDS = 1000; // Tasks added from other tasks are picked up within this
+const uint32_t WEATHER_FETCH_INTERVAL_MILISECONDS = 1000 * 60 * 60; // Once per hour
+const uint32_t DEEP_SLEEP_MIN_MILISECONDS = 30000; // Boot costs more than shorter sleep saves
+const TickType_t FAST_RESUME_FIRST_SAMPLE_TIMEOUT_TICKS = pdMS_TO_TICKS(2000);
+const TickType_t DEEP_SLEEP_MOTION_TIMEOUT_TICKS = pdMS_TO_TICKS(500); // Loop is blocked meanwhile, longer moves postpone sleep
+const TickType_t NTP_FIRST_SAMPLE_TIMEOUT_TICKS = pdMS_TO_TICKS(10000); // Failing sensor must not stop HTTP tasks from being scheduled
 const int CHECK_MEMORY_TASK_STACK_SIZE = 4096;
 
 // Instances
 
-ValuesJitterFilter valuesJitterFilter;
+int readLcdScrollSpeed() {
+    return lcdScrollSpeedMemory.readValue();
+}
 
-LiquidCrystal_I2C lcd(0x27, 16, 2);
-LcdWrapper lcdWrapper(&lcd);
+BatchedLcd lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+LcdWrapper lcdWrapper(&lcd, readLcdScrollSpeed);
 
 HTTPClient httpClient;
+WiFiClient backendAppClient;
 WiFiClientSecure *client = new WiFiClientSecure;
 
-BatteryVoltageMeter batteryVoltageMeterBox(BATTERY_VOLTAGE_BOX_METER_GPIO, BATTERY_VOLTAGE_0_REFERENCE, BATTERY_VOLTAGE_100_REFERENCE, lastReadBatteryVoltageBox);
-BatteryVoltageMeter batteryVoltageMeterServos(BATTERY_VOLTAGE_SERVOS_METER_GPIO, BATTERY_VOLTAGE_0_REFERENCE, BATTERY_VOLTAGE_100_REFERENCE, lastReadBatteryVoltageServos);
-
 ServosPowerSupply servosPowerSupply(SERVOS_POWER_SUPPLY_GPIO);
 
+AdcSampler adcSampler;
+BatteryVoltageMeter batteryVoltageMeterBox(&adcSampler, nullptr, BATTERY_VOLTAGE_BOX_METER_GPIO, lastReadBatteryVoltageBox);
+BatteryVoltageMeter batteryVoltageMeterServos(&adcSampler, &servosPowerSupply, BATTERY_VOLTAGE_SERVOS_METER_GPIO, lastReadBatteryVoltageServos);
+
 Servo servoPullOpen;
 Servo servoPullClose;
 ServoWrapper servoPullOpenWrapper(SERVO_PULL_OPEN_GPIO, servoPullOpen, servoPullOpenCalibrationMinMemory, servoPullOpenCalibrationMaxMemory, servosPowerSupply);
 ServoWrapper servoPullCloseWrapper(SERVO_PULL_CLOSE_GPIO, servoPullClose, servoPullCloseCalibrationMinMemory, servoPullCloseCalibrationMaxMemory, servosPowerSupply);
 
+MotionExecutor motionExecutor(servosPowerSupply);
+
 LedWrapper ledWrapper(LED_RED_PWM_TIMER_INDEX, LED_RED_GPIO, LED_GREEN_PWM_TIMER_INDEX, LED_GREEN_GPIO, LED_BLUE_PWM_TIMER_INDEX, LED_BLUE_GPIO);
 
-Navigation navigation(POTENTIOMETER_GPIO, true, servoPullOpenWrapper, servoPullCloseWrapper, ledWrapper, &AppMode, &lcdWrapper, &batteryVoltageMeterBox, &batteryVoltageMeterServos, &valuesJitterFilter);
+Navigation navigation(POTENTIOMETER_GPIO, true, &adcSampler, servoPullOpenWrapper, servoPullCloseWrapper, ledWrapper, &AppMode, &lcdWrapper, &batteryVoltageMeterBox, &batteryVoltageMeterServos, &motionExecutor);
 ButtonHandler enterButton(ENTER_BUTTON_GPIO);
 ButtonHandler exitButton(EXIT_BUTTON_GPIO);
+ButtonInput buttonInput;
 
 BackgroundApp backgroundApp(ledWrapper, lcdWrapper, &warningsAreActiveMemory);
-BackendApp backendApp(&httpClient, &backgroundApp);
+BackendApp backendApp(&httpClient, &backendAppClient, &backgroundApp);
+
+Bme280Sensor bme;
+SensorSampler sensorSampler(bme, &sensorProfileMemory);
 
-Adafruit_BME280 bme;
+BootTracer bootTracer;
+InitGraph initGraph(&bootTracer);
 
-BluetoothWrapper bluetoothWrapper(&bme, &backgroundApp, &servoPullOpenWrapper, &servoPullCloseWrapper, &batteryVoltageMeterBox, &batteryVoltageMeterServos);
+BluetoothWrapper bluetoothWrapper(&sensorSampler, &backgroundApp, &servoPullOpenWrapper, &servoPullCloseWrapper, &batteryVoltageMeterBox, &batteryVoltageMeterServos, &motionExecutor, &bootTracer);
+
+PowerManager powerManager(&adcSampler, &bluetoothWrapper);
+AppMainStateEnum previousAppMainState = Awaken;
+RtcResumeState* resumeState = nullptr;
+bool isFastResumed = false; // Woken up from deep sleep for Auto mode calculation, until UI is woken up
+time_t lastWeatherFetchTime = 0;
 
 enum HttpQueryTypeEnum { BackendAppWeatherForecastAndAirPollutionQueries, BackendAppSaveLogQuery };
 
@@ -101,7 +144,9 @@ struct HttpQueryQueueItem {
 
 bool isHttpQueriesQueueOccupied = false;
 
-vector<HttpQueryQueueItem> httpQueriesQueue;
+const uint16_t HTTP_QUERIES_QUEUE_CAPACITY = 4; // Weather fetch and log save, each queued at most once per interval
+
+FixedVector<HttpQueryQueueItem, HTTP_QUERIES_QUEUE_CAPACITY> httpQueriesQueue;
 
 void initWifi() {
     WiFi.mode(WIFI_STA);
@@ -139,7 +184,7 @@ void warningsTaskFunction() {
         backgroundApp.handleWarningsDisplay();
     }
 
-    addPeriodicalTaskInMillis(warningsTaskFunction, 100);
+    addPeriodicalTaskInMillis(warningsTaskFunction, timerDelay);
 }
 
 void weatherForecastAndAirPollutionTaskFunction() {
@@ -153,9 +198,11 @@ void weatherForecastAndAirPollutionTaskFunction() {
         backendAppLog: nullptr
     };
 
-    httpQueriesQueue.push_back(weatherForecastAndAirPollutionQueueItem);
+    if (!httpQueriesQueue.push_back(weatherForecastAndAirPollutionQueueItem)) {
+        Serial.println("HTTP queries queue is full, weather fetch dropped");
+    }
 
-    addPeriodicalTaskInMillis(weatherForecastAndAirPollutionTaskFunction, 1000 * 60 * 60); // Once per hour
+    addPeriodicalTaskInMillis(weatherForecastAndAirPollutionTaskFunction, WEATHER_FETCH_INTERVAL_MILISECONDS);
 }
 
 // unsigned long lastHttpRequestMillis = 0;
@@ -204,6 +251,7 @@ void httpTaskFunction() {
                 auto airPollutionData = backendApp.fetchAirPollution();
 
                 addWeatherLog(weatherItem.temperature, weatherItem.windSpeed, weatherItem.date, airPollutionData.pm25, airPollutionData.pm25Date, airPollutionData.pm10, airPollutionData.pm10Date);
+                lastWeatherFetchTime = time(nullptr);
 
                 break;
             }
@@ -216,7 +264,7 @@ void httpTaskFunction() {
             }       
         }
 
-        httpQueriesQueue.erase(httpQueriesQueue.begin());
+        httpQueriesQueue.erase(0);
         isHttpQueriesQueueOccupied = false;
 
         disconnectWifi();
@@ -288,16 +336,6 @@ void wifiConnectionTaskFunction() {
     addPeriodicalTaskInMillis(wifiConnectionTaskFunction, 1000);
 }
 
-void displayTaskFunction() {
-    if (shouldDisplayFunctionTasksExecutionLogs) {
-        Serial.println(">>> displayTaskFunction executed");
-    }
-
-    lcdWrapper.checkScroll();
-
-    addPeriodicalTaskInMillis(displayTaskFunction, 1000);
-}
-
 void bleTaskFunction() {
     if (shouldDisplayFunctionTasksExecutionLogs) {
         Serial.println(">>> bleTaskFunction executed");
@@ -329,10 +367,15 @@ void batteryMeterTaskFunction() {
     float batteryVoltageServos = batteryVoltageMeterServos.getVoltage();
     float batteryPercentageServos = batteryVoltageMeterServos.calculatePercentage(batteryVoltageServos);
 
+    char batteryVoltageMessage[BATTERY_VOLTAGE_MESSAGE_LENGTH];
+
+    batteryVoltageMeterBox.formatBatteryVoltageMessage(batteryVoltageMessage, sizeof(batteryVoltageMessage));
     Serial.print("Battery Voltage Box: ");
-    Serial.println(batteryVoltageMeterBox.getBatteryVoltageMessage());
+    Serial.println(batteryVoltageMessage);
+
+    batteryVoltageMeterServos.formatBatteryVoltageMessage(batteryVoltageMessage, sizeof(batteryVoltageMessage));
     Serial.print("Battery Voltage Servos: ");
-    Serial.println(batteryVoltageMeterServos.getBatteryVoltageMessage());
+    Serial.println(batteryVoltageMessage);
 
     if (batteryPercentageBox < BATTERY_VOLTAGE_MIN_PERCENTAGE || batteryPercentageServos < BATTERY_VOLTAGE_MIN_PERCENTAGE) {
         if (batteryPercentageBox < BATTERY_VOLTAGE_MIN_PERCENTAGE) {    
@@ -351,34 +394,48 @@ void batteryMeterTaskFunction() {
     addPeriodicalTaskInMillis(batteryMeterTaskFunction, 5000); // Once per 5 seconds
 }
 
-// Tasks
-void checkPeriodicalTasksQueueTask(void *param) {
-    while (true) {
-        checkPeriodicalTasksQueue();
-
-        vTaskDelay(100 / portTICK_PERIOD_MS);
+uint32_t getMilisecondsUntilWeatherFetch() {
+    if (lastWeatherFetchTime == 0) {
+        return 0;
     }
+
+    uint32_t elapsedMiliseconds = (time(nullptr) - lastWeatherFetchTime) * 1000;
+
+    return elapsedMiliseconds >= WEATHER_FETCH_INTERVAL_MILISECONDS ? 0 : WEATHER_FETCH_INTERVAL_MILISECONDS - elapsedMiliseconds;
+}
+
+bool isWeatherFetchDue() {
+    return getMilisecondsUntilWeatherFetch() == 0;
 }
 
-void servosSmoothMovementTask(void *param) {
+// Tasks
+void checkPeriodicalTasksQueueTask(void *param) {
     while (true) {
-        if (servoPullOpenWrapper.isMovingSmoothly) {
-            servoPullOpenWrapper.moveSmoothly();
-        }
+        checkPeriodicalTasksQueue();
 
-        if (servoPullCloseWrapper.isMovingSmoothly) {
-            servoPullCloseWrapper.moveSmoothly();
-        }
+        // Sleeping until nearest task, so CPU can sleep too
+        unsigned long waitMiliseconds = min(getMilisecondsUntilNextPeriodicalTask(), (unsigned long) CHECK_PERIODICAL_TASKS_QUEUE_MAX_WAIT_MILISECONDS);
 
-        vTaskDelay(MOVE_SMOOTHLY_MILISECONDS_INTERVAL / portTICK_PERIOD_MS);
+        vTaskDelay(pdMS_TO_TICKS(max(waitMiliseconds, 1UL)));
     }
 }
 
 unsigned long previousWindowOpeningCalculationMillis = 0;
 void windowOpeningCalculationTask(void *param) {
+    // Wakeup from deep sleep is there for this calculation, it is not delayed
+    bool shouldCheckImmediately = isFastResumed;
+
+    if (shouldCheckImmediately && !noTemperatureMode) {
+        sensorSampler.waitForFirstSample(FAST_RESUME_FIRST_SAMPLE_TIMEOUT_TICKS);
+    }
+
     while (true) {
         // Checking if state has changed every second
-        vTaskDelay(1000 / portTICK_PERIOD_MS);
+        if (!shouldCheckImmediately) {
+            vTaskDelay(1000 / portTICK_PERIOD_MS);
+        }
+
+        shouldCheckImmediately = false;
 
         if (!hasNTPAlreadyConfigured) {
             Serial.println("NTP not configured");
@@ -397,18 +454,29 @@ void windowOpeningCalculationTask(void *param) {
         ) {
             Serial.println("Calculating window opening");
 
-            float currentTemperature = noTemperatureMode ? optimalTemperatureMemory.readValue() : bme.readTemperature();
+            float currentTemperature = noTemperatureMode ? optimalTemperatureMemory.readValue() : sensorSampler.getSnapshot().reading.temperature;
+
+            if (isnan(currentTemperature)) {
+                Serial.println("No temperature sample yet");
+                continue;
+            }
+
             auto [newWindowOpening, backendAppLog] = PIDController::calculateWindowOpening(currentTemperature);
 
-            // Save to Backend
-            Serial.println("Adding to queue: BackendAppSaveLogQuery");
-            HttpQueryQueueItem queueItem = {
-                type: BackendAppSaveLogQuery,
-                backendAppLog: &backendAppLog
-            };
+            // Save to Backend, wakeups from deep sleep stay offline unless weather has to be fetched anyway
+            if (!isFastResumed || isWeatherFetchDue()) {
+                Serial.println("Adding to queue: BackendAppSaveLogQuery");
+                HttpQueryQueueItem queueItem = {
+                    type: BackendAppSaveLogQuery,
+                    backendAppLog: &backendAppLog
+                };
 
-            httpQueriesQueue.push_back(queueItem);
+                if (!httpQueriesQueue.push_back(queueItem)) {
+                    Serial.println("HTTP queries queue is full, log save dropped");
+                }
+            }
 
+            // Commanded positions, no read back from PWM
             uint8_t servoPullClosePosition = servoPullCloseWrapper.getCurrentPosition();
             uint8_t servoPullOpenPosition = servoPullOpenWrapper.getCurrentPosition();
 
@@ -422,21 +490,26 @@ void windowOpeningCalculationTask(void *param) {
             Serial.print("servosAvaragePosition: ");
             Serial.println(servosAvaragePosition);
 
-            if (abs(newWindowOpening - servosAvaragePosition) > 2) {
+            bool isAlreadyAtTarget = servoPullCloseWrapper.getTargetPosition() == newWindowOpening && servoPullOpenWrapper.getTargetPosition() == newWindowOpening;
+
+            if (!isAlreadyAtTarget) {
                 boolean isWindowOpening = newWindowOpening > servosAvaragePosition; // Closing or Opening
 
                 Serial.print("WindowCalculationTask: New Window Opening: ");
                 Serial.println(newWindowOpening);
 
+                // Servo releasing the window starts first, the other one follows with delay
+                MotionPlan plan;
+
                 if (isWindowOpening) {
-                    servoPullCloseWrapper.setMovingSmoothlyTarget(newWindowOpening);
-                    vTaskDelay(DELAY_DIFF_BETWEEN_SERVOS_MILISECONDS / portTICK_PERIOD_MS);
-                    servoPullOpenWrapper.setMovingSmoothlyTarget(newWindowOpening);
+                    plan.addAxis(&servoPullCloseWrapper, newWindowOpening, 0);
+                    plan.addAxis(&servoPullOpenWrapper, newWindowOpening, DELAY_DIFF_BETWEEN_SERVOS_MILISECONDS);
                 } else {
-                    servoPullOpenWrapper.setMovingSmoothlyTarget(newWindowOpening);
-                    vTaskDelay(DELAY_DIFF_BETWEEN_SERVOS_MILISECONDS / portTICK_PERIOD_MS);
-                    servoPullCloseWrapper.setMovingSmoothlyTarget(newWindowOpening);
+                    plan.addAxis(&servoPullOpenWrapper, newWindowOpening, 0);
+                    plan.addAxis(&servoPullCloseWrapper, newWindowOpening, DELAY_DIFF_BETWEEN_SERVOS_MILISECONDS);
                 }
+
+                motionExecutor.submit(plan);
             }
 
             previousWindowOpeningCalculationMillis = currentMillis; // Overriding also AUTO interval even if executed manually
@@ -470,8 +543,14 @@ void ntpTask(void *param) {
             hasNTPAlreadyConfigured = true; // It happens only once
 
             // Init first log (50 will be invalid value probably)
-            float initialTemperature = noTemperatureMode ? optimalTemperatureMemory.readValue() : bme.readTemperature();
-            addLog(initialTemperature, 50, 0);
+            bool hasInitialTemperature = noTemperatureMode || sensorSampler.waitForFirstSample(NTP_FIRST_SAMPLE_TIMEOUT_TICKS);
+
+            if (hasInitialTemperature) {
+                float initialTemperature = noTemperatureMode ? optimalTemperatureMemory.readValue() : sensorSampler.getSnapshot().reading.temperature;
+                addLog(initialTemperature, 50, 0);
+            } else {
+                Serial.println("No temperature sample yet, skipping initial log");
+            }
 
             addPeriodicalTaskInMillis(httpTaskFunction, 100);
             
@@ -485,6 +564,15 @@ void checkMemoryTask(void *param) {
         Serial.println("Free heap: " + String(esp_get_free_heap_size()) + " bytes");
         Serial.println("Minimum ever free heap: " + String(esp_get_minimum_free_heap_size()) + " bytes");
 
+        uint32_t freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        uint32_t largestFreeBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+        Serial.printf("Largest free block: %u bytes, fragmentation: %.2f \n", largestFreeBlock, calculateFragmentationRatio(freeHeap, largestFreeBlock));
+
+#ifdef ALLOCATION_TRACKING
+        AllocationTotals allocationTotals = getAllocationTotals();
+        Serial.printf("Allocations: %u, frees: %u, bytes in flight: %u (peak %u) \n", allocationTotals.allocationsCount, allocationTotals.freesCount, allocationTotals.bytesInFlight, allocationTotals.peakBytesInFlight);
+#endif
+
         UBaseType_t uxHighWaterMark;
         
         uxHighWaterMark = uxTaskGetStackHighWaterMark(CheckPeriodicalTasksQueue);
@@ -502,79 +590,301 @@ void checkMemoryTask(void *param) {
             Serial.printf("NTPTask minimum: %d / %d \n", uxHighWaterMark, NTP_TASK_STACK_SIZE);
         }
 
-        uxHighWaterMark = uxTaskGetStackHighWaterMark(ServosSmoothMovementTask);
-        Serial.printf("ServosSmoothMovementTask minimum: %d / %d \n", uxHighWaterMark, SERVOS_SMOOTH_MOVEMENT_TASK_STACK_SIZE);
+        uxHighWaterMark = uxTaskGetStackHighWaterMark(motionExecutor.getTaskHandle());
+        Serial.printf("MotionExecutorTask minimum: %d / %d \n", uxHighWaterMark, MOTION_EXECUTOR_TASK_STACK_SIZE);
+
+        if (adcSampler.getTaskHandle() != nullptr) {
+            uxHighWaterMark = uxTaskGetStackHighWaterMark(adcSampler.getTaskHandle());
+            Serial.printf("AdcSamplerTask minimum: %d / %d \n", uxHighWaterMark, ADC_SAMPLER_TASK_STACK_SIZE);
+        }
+
+        uxHighWaterMark = uxTaskGetStackHighWaterMark(buttonInput.getTaskHandle());
+        Serial.printf("ButtonInputTask minimum: %d / %d \n", uxHighWaterMark, BUTTON_INPUT_TASK_STACK_SIZE);
+
+        uxHighWaterMark = uxTaskGetStackHighWaterMark(ledWrapper.getTaskHandle());
+        Serial.printf("LedAnimationTask minimum: %d / %d \n", uxHighWaterMark, LED_ANIMATION_TASK_STACK_SIZE);
+
+        uxHighWaterMark = uxTaskGetStackHighWaterMark(lcdWrapper.getTaskHandle());
+        Serial.printf("LcdRenderTask minimum: %d / %d \n", uxHighWaterMark, LCD_RENDER_TASK_STACK_SIZE);
+
+        if (sensorSampler.getTaskHandle() != nullptr) {
+            uxHighWaterMark = uxTaskGetStackHighWaterMark(sensorSampler.getTaskHandle());
+            Serial.printf("SensorSamplerTask minimum: %d / %d \n", uxHighWaterMark, SENSOR_SAMPLER_TASK_STACK_SIZE);
+        }
 
         vTaskDelay(1000 / portTICK_PERIOD_MS); // Once per second
     }
 }
 
-void setup() {
+// Wakeup deadlines
+uint32_t periodicalTasksDeadline() {
+    return getMilisecondsUntilNextPeriodicalTask();
+}
+
+uint32_t motionDeadline() {
+    return motionExecutor.isBusy() ? 0 : POWER_MANAGER_NO_DEADLINE;
+}
+
+uint32_t connectivityDeadline() {
+    // Connections are not kept through sleep
+    bool isBusy = isBLEClientConnected || isWifiConnected || isWifiConnecting || !httpQueriesQueue.empty();
+
+    return isBusy ? 0 : POWER_MANAGER_NO_DEADLINE;
+}
+
+uint32_t warningsDeadline() {
+    // LED fades need their clocks running
+    bool isShown = warningsAreActiveMemory.readValue() != 0 && !backgroundApp.warnings.empty();
+
+    return isShown ? 0 : POWER_MANAGER_NO_DEADLINE;
+}
+
+uint32_t windowOpeningCalculationDeadline() {
+    if (!hasNTPAlreadyConfigured || AppMode != Auto) {
+        return POWER_MANAGER_NO_DEADLINE;
+    }
+
+    uint32_t intervalMiliseconds = windowOpeningCalculationIntervalMemory.readValue() * 1000;
+    uint32_t elapsedMiliseconds = millis() - previousWindowOpeningCalculationMillis;
+
+    return elapsedMiliseconds >= intervalMiliseconds ? 0 : intervalMiliseconds - elapsedMiliseconds;
+}
+
+/**
+ * Only Auto mode with nothing in progress sleeps deeply, until next calculation or weather fetch
+ */
+uint32_t getDeepSleepMiliseconds() {
+    if (!DEEP_SLEEP_ENABLED || AppMode != Auto || !hasNTPAlreadyConfigured || forceOpeningWindowCalculation) {
+        return 0;
+    }
+
+    bool isBusy = motionDeadline() == 0 || connectivityDeadline() == 0 || warningsDeadline() == 0 || servosPowerSupply.isPoweredOn();
+
+    if (isBusy) {
+        return 0;
+    }
+
+    uint32_t sleepMiliseconds = min(windowOpeningCalculationDeadline(), getMilisecondsUntilWeatherFetch());
+
+    return sleepMiliseconds >= DEEP_SLEEP_MIN_MILISECONDS ? sleepMiliseconds : 0;
+}
+
+void enterDeepSleep(uint32_t sleepMiliseconds) {
+    // Plan could have been submitted (BLE) since deadlines were checked, saved positions have to be final
+    if (!motionExecutor.waitForCompletion(DEEP_SLEEP_MOTION_TIMEOUT_TICKS)) {
+        Serial.println("Deep sleep postponed, servos are moving");
+        return;
+    }
+
+    unsigned long sinceCalculationMiliseconds = millis() - previousWindowOpeningCalculationMillis;
+
+    RtcResumeState state = {};
+    state.appMode = AppMode;
+    state.lastWindowOpeningCalculationTime = time(nullptr) - sinceCalculationMiliseconds / 1000;
+    state.lastWeatherFetchTime = lastWeatherFetchTime;
+    state.servoPullOpenPosition = servoPullOpenWrapper.getCurrentPosition();
+    state.servoPullClosePosition = servoPullCloseWrapper.getCurrentPosition();
+    state.hasBmeCalibration = !noTemperatureMode;
+    state.bmeCalibration = bme.getCalibration();
+
+    for (uint8_t i = 0; i < SENSOR_PROFILES_COUNT; i++) {
+        state.sensorCalibrations[i] = sensorSampler.getCalibration(i);
+    }
+
+    state.batteryBoxHistory = batteryVoltageMeterBox.getStateOfCharge()->getHistory();
+    state.batteryServosHistory = batteryVoltageMeterServos.getStateOfCharge()->getHistory();
+
+    saveRtcResumeState(state);
+
+    servosPowerSupply.holdOffDuringDeepSleep();
+
+    powerManager.enterDeepSleep(sleepMiliseconds);
+}
+
+/**
+ * Before tasks are started, time base survived in RTC timer so NTP is not needed
+ */
+void resumeFromDeepSleep(const RtcResumeState& state) {
+    AppMode = state.appMode;
+    hasNTPAlreadyConfigured = true;
+    lastWeatherFetchTime = state.lastWeatherFetchTime;
+
+    unsigned long sinceCalculationMiliseconds = (time(nullptr) - state.lastWindowOpeningCalculationTime) * 1000;
+    previousWindowOpeningCalculationMillis = millis() - sinceCalculationMiliseconds;
+
+    restoreRtcResumeLogs(state);
+    batteryVoltageMeterBox.getStateOfCharge()->restoreHistory(state.batteryBoxHistory);
+    batteryVoltageMeterServos.getStateOfCharge()->restoreHistory(state.batteryServosHistory);
+
+    Serial.println("Resumed from deep sleep");
+}
+
+// Init stages
+void initEepromStage() {
+    if (!EEPROM.begin(EEPROM_SIZE)) {
+        Serial.println("EEPROM Error");
+        while (1);
+    }
+}
+
+void initLcdStage() {
     Wire.begin(LCD_SDA_GPIO, LCD_SCL_GPIO);
-    Serial.begin(115200);
+    lcdWrapper.initialize(LCD_RENDER_TASK_STACK_SIZE);
+}
+
+void initAdcStage() {
+    adcSampler.addPin(POTENTIOMETER_GPIO);
+    adcSampler.addPin(BATTERY_VOLTAGE_BOX_METER_GPIO);
+    adcSampler.addPin(BATTERY_VOLTAGE_SERVOS_METER_GPIO);
+    adcSampler.initialize(ADC_SAMPLER_TASK_STACK_SIZE);
 
     batteryVoltageMeterBox.initialize();
     batteryVoltageMeterServos.initialize();
+}
 
-    initWifi();
+void initBluetoothStage() {
+    bluetoothWrapper.initialize();
+}
 
-    if (!EEPROM.begin(EEPROM_SIZE)) {
-        Serial.println("EEPROM Error");
-        return;
+void initWifiStage() {
+    // Resumed wakeup connects only when some query needs it
+    if (!isFastResumed) {
+        initWifi();
     }
+}
 
+void initSensorStage() {
     I2C_BME_280.begin(BME_280_SDA_GPIO, BME_280_SCL_GPIO, 100000); 
 
-    if (!noTemperatureMode) {
-        if (!bme.begin(BME280_ADDRESS, &I2C_BME_280)) {
-            Serial.println("BME280 not working correctly");
-            while (1);
-        }
+    if (noTemperatureMode) {
+        return;
+    }
+
+    bool isBmeResumed = isFastResumed && resumeState->hasBmeCalibration && bme.resume(BME280_ADDRESS, &I2C_BME_280, resumeState->bmeCalibration);
 
-        Serial.println("BME280 initialized");
+    if (!isBmeResumed && !bme.begin(BME280_ADDRESS, &I2C_BME_280)) {
+        Serial.println("BME280 not working correctly");
+        while (1);
     }
-    
-    bluetoothWrapper.initialize();
 
-    delay(100);
+    Serial.println(isBmeResumed ? "BME280 resumed" : "BME280 initialized");
+
+    if (isFastResumed) {
+        for (uint8_t i = 0; i < SENSOR_PROFILES_COUNT; i++) {
+            sensorSampler.restoreCalibration(i, resumeState->sensorCalibrations[i]);
+        }
+    }
 
+    sensorSampler.initialize(SENSOR_SAMPLER_TASK_STACK_SIZE);
+}
+
+void initUiStage() {
     navigation.initialize();
-    ledWrapper.initialize();
+    ledWrapper.initialize(LED_ANIMATION_TASK_STACK_SIZE);
 
-    enterButton.initialize();
-    exitButton.initialize();
     enterButton.attachButtonPressCallback(handleEnterButtonPress);
     exitButton.attachButtonPressCallback(handleExitButtonPress);
+    buttonInput.initialize(BUTTON_INPUT_TASK_STACK_SIZE);
+    buttonInput.addButton(&enterButton);
+    buttonInput.addButton(&exitButton);
+
+    powerManager.initialize();
+    powerManager.addWakeupButton(&enterButton);
+    powerManager.addWakeupButton(&exitButton);
+    powerManager.addDeadlineProvider(periodicalTasksDeadline);
+    powerManager.addDeadlineProvider(motionDeadline);
+    powerManager.addDeadlineProvider(connectivityDeadline);
+    powerManager.addDeadlineProvider(warningsDeadline);
+    powerManager.addDeadlineProvider(windowOpeningCalculationDeadline);
+}
 
+void initServosStage() {
     servosPowerSupply.initialize();
 
-    servoPullOpenWrapper.initialize(SERVO_PULL_OPEN_PWM_TIMER_INDEX);
-    servoPullCloseWrapper.initialize(SERVO_PULL_CLOSE_PWM_TIMER_INDEX);
+    if (isFastResumed) {
+        servoPullOpenWrapper.initialize(SERVO_PULL_OPEN_PWM_TIMER_INDEX, resumeState->servoPullOpenPosition);
+        servoPullCloseWrapper.initialize(SERVO_PULL_CLOSE_PWM_TIMER_INDEX, resumeState->servoPullClosePosition);
 
-    // Tasks
+        resumeFromDeepSleep(*resumeState);
+    } else {
+        servoPullOpenWrapper.initialize(SERVO_PULL_OPEN_PWM_TIMER_INDEX);
+        servoPullCloseWrapper.initialize(SERVO_PULL_CLOSE_PWM_TIMER_INDEX);
+    }
+}
+
+void initTasksStage() {
     xTaskCreate(checkPeriodicalTasksQueueTask, "CheckPeriodicalTasksQueueTask", CHECK_PERIODICAL_TASKS_QUEUE_TASK_STACK_SIZE, NULL, 1, &CheckPeriodicalTasksQueue);
-    xTaskCreate(servosSmoothMovementTask, "ServosSmoothMovementTask", SERVOS_SMOOTH_MOVEMENT_TASK_STACK_SIZE, NULL, 1, &ServosSmoothMovementTask);
-    xTaskCreate(ntpTask, "NTPTask", NTP_TASK_STACK_SIZE, NULL, 1, &NTPTask);
+    motionExecutor.initialize(MOTION_EXECUTOR_TASK_STACK_SIZE);
+
+    if (!hasNTPAlreadyConfigured) {
+        xTaskCreate(ntpTask, "NTPTask", NTP_TASK_STACK_SIZE, NULL, 1, &NTPTask);
+    } else {
+        addPeriodicalTaskInMillis(httpTaskFunction, 100); // Otherwise added once NTP is configured
+    }
     xTaskCreate(windowOpeningCalculationTask, "WindowOpeningCalculationTask", WINDOW_OPENING_CALCULATION_TASK_STACK_SIZE, NULL, 1, &WindowOpeningCalculationTask);
 
     // Optional
     // xTaskCreate(checkMemoryTask, "CheckMemoryTask", CHECK_MEMORY_TASK_STACK_SIZE, NULL, 1, &CheckMemoryTask);
 
     // Periodical Tasks
-    addPeriodicalTaskInMillis(displayTaskFunction, 100);
     addPeriodicalTaskInMillis(warningsTaskFunction, 500);
-    addPeriodicalTaskInMillis(weatherForecastAndAirPollutionTaskFunction, 700);
+    addPeriodicalTaskInMillis(weatherForecastAndAirPollutionTaskFunction, isFastResumed ? max<uint32_t>(getMilisecondsUntilWeatherFetch(), 700) : 700);
     addPeriodicalTaskInMillis(wifiConnectionTaskFunction, 900);
     addPeriodicalTaskInMillis(bleTaskFunction, 1100);
     addPeriodicalTaskInMillis(batteryMeterTaskFunction, 1300);
+}
 
-    lcdWrapper.initialize();
+void reportBootStage() {
+    bootTracer.printReport();
+}
+
+void setup() {
+    uint32_t setupStartMicroseconds = micros();
+
+    Serial.begin(115200);
+    bootTracer.record("preSetup", 0, setupStartMicroseconds);
+
+    resumeState = getRtcResumeState();
+    isFastResumed = resumeState != nullptr;
+
+    // Radios are brought up in background one after another, UI does not wait for them
+    EventBits_t eepromStage = initGraph.addStage("eeprom", initEepromStage);
+    EventBits_t lcdStage = initGraph.addStage("lcd", initLcdStage, eepromStage);
+    EventBits_t adcStage = initGraph.addStage("adc", initAdcStage);
+    EventBits_t bluetoothStage = initGraph.addStage("ble", initBluetoothStage, eepromStage, BLUETOOTH_INIT_TASK_STACK_SIZE);
+    initGraph.addStage("wifi", initWifiStage, bluetoothStage, WIFI_INIT_TASK_STACK_SIZE);
+    EventBits_t uiStage = initGraph.addStage("ui", initUiStage, lcdStage | adcStage);
+    EventBits_t servosStage = initGraph.addStage("servos", initServosStage, eepromStage);
+    EventBits_t sensorStage = initGraph.addStage("sensor", initSensorStage, eepromStage);
+    initGraph.addStage("tasks", initTasksStage, uiStage | servosStage | sensorStage);
+    initGraph.addStage("report", reportBootStage, initGraph.getAllStages(), BOOT_REPORT_TASK_STACK_SIZE);
+
+    initGraph.run();
 }
 
 void loop() {
-    // Navigation
-    enterButton.checkButtonPress();
-    exitButton.checkButtonPress();
+    if (navigation.appMainState != previousAppMainState) {
+        if (navigation.appMainState == Sleep) {
+            powerManager.enterSleepMode();
+        } else if (previousAppMainState == Sleep) {
+            powerManager.exitSleepMode();
+            isFastResumed = false; // User is there, wakeup is not only for calculation anymore
+        }
+
+        previousAppMainState = navigation.appMainState;
+    }
+
+    if (navigation.appMainState == Sleep) {
+        uint32_t deepSleepMiliseconds = getDeepSleepMiliseconds();
+
+        if (deepSleepMiliseconds > 0) {
+            enterDeepSleep(deepSleepMiliseconds);
+        }
+    }
+
+    // Navigation, sleeping screen has nothing to poll so loop waits for buttons (and lets CPU sleep)
+    TickType_t waitTicks = navigation.appMainState == Sleep ? powerManager.sleepUntilNextWakeup() : pdMS_TO_TICKS(MENU_SELECTION_POLL_MILISECONDS);
+    buttonInput.dispatchEvents(waitTicks);
 
     if (navigation.isMenuSelectionActivated) {
         navigation.handleMenuSelection();
@@ -614,9 +924,4 @@ void loop() {
             break;
         }
     }
-
-    // Power Supply to Servos
-    servosPowerSupply.checkTargetState();
-
-    delay(20);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <memoryValue.h>
 #include <pidController.h>
 #include <memoryData.h>
+#include <sensorProfiles.h>
+#include <lcdMarquee.h>
 
 // MemoryValues
 
@@ -42,4 +44,8 @@ MemoryValue openingTermPositiveTemperatureIncreaseMemory(OPENING_TERM_POSITIVE_T
 
 MemoryValue warningsAreActiveMemory(WARNINGS_ARE_ACTIVE_SET_ADDRESS, WARNINGS_ARE_ACTIVE_VALUE_ADDRESS, 1);
 
-MemoryValue batteryVoltageMetersAreActiveMemory(BATTERY_VOLTAGE_METERS_ARE_ACTIVE_SET_ADDRESS, BATTERY_VOLTAGE_METERS_ARE_ACTIVE_VALUE_ADDRESS, 1);
\ No newline at end of file
+MemoryValue batteryVoltageMetersAreActiveMemory(BATTERY_VOLTAGE_METERS_ARE_ACTIVE_SET_ADDRESS, BATTERY_VOLTAGE_METERS_ARE_ACTIVE_VALUE_ADDRESS, 1);
+
+MemoryValue sensorProfileMemory(SENSOR_PROFILE_SET_ADDRESS, SENSOR_PROFILE_VALUE_ADDRESS, DEFAULT_SENSOR_PROFILE);
+
+MemoryValue lcdScrollSpeedMemory(LCD_SCROLL_SPEED_SET_ADDRESS, LCD_SCROLL_SPEED_VALUE_ADDRESS, LCD_SCROLL_DEFAULT_CHARACTER_MILISECONDS); // Miliseconds per character
\ No newline at end of file
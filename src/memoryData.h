@@ -58,6 +58,12 @@ const int WARNINGS_ARE_ACTIVE_VALUE_ADDRESS = 124;
 const int BATTERY_VOLTAGE_METERS_ARE_ACTIVE_SET_ADDRESS = 128;
 const int BATTERY_VOLTAGE_METERS_ARE_ACTIVE_VALUE_ADDRESS = 132;
 
+const int SENSOR_PROFILE_SET_ADDRESS = 136;
+const int SENSOR_PROFILE_VALUE_ADDRESS = 140;
+
+const int LCD_SCROLL_SPEED_SET_ADDRESS = 144;
+const int LCD_SCROLL_SPEED_VALUE_ADDRESS = 148;
+
 // MemoryValues
 
 // Pull Open Calibration Min
@@ -99,4 +105,8 @@ extern MemoryValue warningsAreActiveMemory;
 
 extern MemoryValue batteryVoltageMetersAreActiveMemory;
 
+extern MemoryValue sensorProfileMemory;
+
+extern MemoryValue lcdScrollSpeedMemory;
+
 #endif
@@ -0,0 +1,149 @@
+#include <Arduino.h>
+#include <motionExecutor.h>
+#include <config.h>
+
+bool MotionPlan::addAxis(ServoWrapper* servo, uint8_t targetPosition, uint16_t startOffsetMiliseconds) {
+    if (this->axesCount >= MOTION_PLAN_MAX_AXES) {
+        return false;
+    }
+
+    this->axes[this->axesCount] = MotionAxis{
+        servo: servo,
+        targetPosition: targetPosition,
+        startOffsetMiliseconds: startOffsetMiliseconds
+    };
+    this->axesCount++;
+
+    return true;
+}
+
+MotionExecutor::MotionExecutor(ServosPowerSupply& servosPowerSupply): servosPowerSupply(servosPowerSupply) {
+    this->plansQueue = nullptr;
+    this->eventGroup = nullptr;
+    this->stateMutex = nullptr;
+    this->taskHandle = nullptr;
+    this->activeServosCount = 0;
+}
+
+void MotionExecutor::initialize(uint32_t stackSize) {
+    this->plansQueue = xQueueCreate(1, sizeof(MotionPlan));
+    this->eventGroup = xEventGroupCreate();
+    this->stateMutex = xSemaphoreCreateMutex();
+    xEventGroupSetBits(this->eventGroup, MOTION_EXECUTOR_IDLE_BIT);
+
+    xTaskCreate(MotionExecutor::taskFunction, "MotionExecutorTask", stackSize, this, 1, &this->taskHandle);
+}
+
+void MotionExecutor::taskFunction(void* param) {
+    static_cast<MotionExecutor*>(param)->run();
+}
+
+void MotionExecutor::run() {
+    MotionPlan plan;
+
+    while (true) {
+        // Sleeping until there is any work
+        xQueueReceive(this->plansQueue, &plan, portMAX_DELAY);
+        this->startPlan(plan);
+
+        TickType_t lastWakeTime = xTaskGetTickCount();
+
+        while (this->tickActiveServos()) {
+            vTaskDelayUntil(&lastWakeTime, MOVE_SMOOTHLY_MILISECONDS_INTERVAL / portTICK_PERIOD_MS);
+
+            if (xQueueReceive(this->plansQueue, &plan, 0) == pdTRUE) {
+                this->startPlan(plan);
+            }
+        }
+
+        this->activeServosCount = 0;
+        this->servosPowerSupply.endMove();
+
+        // Newer plan could have been submitted after last check, submit() can't slip in between check and set
+        xSemaphoreTake(this->stateMutex, portMAX_DELAY);
+        if (uxQueueMessagesWaiting(this->plansQueue) == 0) {
+            xEventGroupSetBits(this->eventGroup, MOTION_EXECUTOR_IDLE_BIT);
+        }
+        xSemaphoreGive(this->stateMutex);
+    }
+}
+
+/**
+ * Profiles of all axes are computed here once, ticks only evaluate them
+ */
+void MotionExecutor::startPlan(const MotionPlan& plan) {
+    uint16_t settleMiliseconds = this->servosPowerSupply.beginMove();
+
+    for (uint8_t i = 0; i < plan.axesCount; i++) {
+        const MotionAxis& axis = plan.axes[i];
+
+        axis.servo->setMovingSmoothlyTarget(axis.targetPosition, settleMiliseconds + axis.startOffsetMiliseconds);
+
+        bool isAlreadyActive = false;
+
+        for (uint8_t j = 0; j < this->activeServosCount; j++) {
+            if (this->activeServos[j] == axis.servo) {
+                isAlreadyActive = true;
+                break;
+            }
+        }
+
+        if (!isAlreadyActive && this->activeServosCount < MOTION_EXECUTOR_MAX_ACTIVE_SERVOS) {
+            this->activeServos[this->activeServosCount] = axis.servo;
+            this->activeServosCount++;
+        }
+    }
+}
+
+/**
+ * Returns true while any servo is still moving (or waiting for its start offset)
+ */
+bool MotionExecutor::tickActiveServos() {
+    bool isAnyMoving = false;
+
+    for (uint8_t i = 0; i < this->activeServosCount; i++) {
+        ServoWrapper* servo = this->activeServos[i];
+
+        if (servo->isMovingSmoothly) {
+            servo->moveSmoothly();
+        }
+
+        isAnyMoving = isAnyMoving || servo->isMovingSmoothly;
+    }
+
+    return isAnyMoving;
+}
+
+bool MotionExecutor::submit(const MotionPlan& plan) {
+    if (this->plansQueue == nullptr || plan.axesCount == 0) {
+        return false;
+    }
+
+    xSemaphoreTake(this->stateMutex, portMAX_DELAY);
+    xEventGroupClearBits(this->eventGroup, MOTION_EXECUTOR_IDLE_BIT);
+    xQueueOverwrite(this->plansQueue, &plan);
+    xSemaphoreGive(this->stateMutex);
+
+    return true;
+}
+
+bool MotionExecutor::isBusy() {
+    return (xEventGroupGetBits(this->eventGroup) & MOTION_EXECUTOR_IDLE_BIT) == 0;
+}
+
+/**
+ * Blocks caller until all servos reached their targets (plans submitted meanwhile included)
+ */
+bool MotionExecutor::waitForCompletion(TickType_t timeoutTicks) {
+    if (this->eventGroup == nullptr) {
+        return true;
+    }
+
+    EventBits_t bits = xEventGroupWaitBits(this->eventGroup, MOTION_EXECUTOR_IDLE_BIT, pdFALSE, pdTRUE, timeoutTicks);
+
+    return (bits & MOTION_EXECUTOR_IDLE_BIT) != 0;
+}
+
+TaskHandle_t MotionExecutor::getTaskHandle() {
+    return this->taskHandle;
+}
\ No newline at end of file
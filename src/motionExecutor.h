@@ -0,0 +1,63 @@
+#ifndef MOTION_EXECUTOR_H
+#define MOTION_EXECUTOR_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+
+#include <servoWrapper.h>
+#include <servosPowerSupply.h>
+
+const uint8_t MOTION_PLAN_MAX_AXES = 2;
+const uint8_t MOTION_EXECUTOR_MAX_ACTIVE_SERVOS = 4;
+
+const EventBits_t MOTION_EXECUTOR_IDLE_BIT = BIT0;
+
+struct MotionAxis {
+    ServoWrapper* servo;
+    uint8_t targetPosition; // 0 - 100
+    uint16_t startOffsetMiliseconds; // Delay from plan start
+};
+
+struct MotionPlan {
+    MotionAxis axes[MOTION_PLAN_MAX_AXES];
+    uint8_t axesCount = 0;
+
+    bool addAxis(ServoWrapper* servo, uint8_t targetPosition, uint16_t startOffsetMiliseconds = 0);
+};
+
+/**
+ * Owns smooth servo movements
+ * Task sleeps on plans queue while idle, ticks servos only while a plan is executed
+ * Submitting never blocks, newer plan replaces the one waiting (and re-plans servos which are already moving)
+ * Servos are powered up once per plan (axes wait for settle time) and power is released when the plan completes
+ * Queue and idle bit change together under stateMutex, queued plan is never reported as idle
+ */
+class MotionExecutor {
+    private:
+        ServosPowerSupply& servosPowerSupply;
+        QueueHandle_t plansQueue;
+        EventGroupHandle_t eventGroup;
+        SemaphoreHandle_t stateMutex;
+        TaskHandle_t taskHandle;
+        ServoWrapper* activeServos[MOTION_EXECUTOR_MAX_ACTIVE_SERVOS];
+        uint8_t activeServosCount;
+
+        static void taskFunction(void* param);
+        void run();
+        void startPlan(const MotionPlan& plan);
+        bool tickActiveServos();
+
+    public:
+        MotionExecutor(ServosPowerSupply& servosPowerSupply);
+        void initialize(uint32_t stackSize);
+        bool submit(const MotionPlan& plan);
+        bool isBusy(); // Cleared when all servos reached their targets
+        bool waitForCompletion(TickType_t timeoutTicks); // False on timeout
+        TaskHandle_t getTaskHandle();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <Arduino.h>
+#include <cmath>
+#include <motionProfile.h>
+
+MotionProfile::MotionProfile() {
+    this->shape = MotionProfileTrapezoidal;
+    this->startPosition = 0;
+    this->distance = 0;
+    this->direction = 1;
+    this->peakVelocity = 0;
+    this->accelerationTime = 0;
+    this->cruiseTime = 0;
+}
+
+void MotionProfile::plan(float startPosition, float targetPosition, float maxVelocity, float maxAcceleration, MotionProfileShape shape) {
+    this->shape = shape;
+    this->startPosition = startPosition;
+    this->distance = fabsf(targetPosition - startPosition);
+    this->direction = targetPosition >= startPosition ? 1 : -1;
+
+    if (this->distance == 0 || maxVelocity <= 0 || maxAcceleration <= 0) {
+        this->peakVelocity = 0;
+        this->accelerationTime = 0;
+        this->cruiseTime = 0;
+        return;
+    }
+
+    // Sine-squared ramp peaks at double of its average acceleration
+    float averageAcceleration = shape == MotionProfileSCurve ? maxAcceleration / 2 : maxAcceleration;
+
+    // Both ramps together cover peakVelocity * accelerationTime
+    float fullRampsDistance = maxVelocity * maxVelocity / averageAcceleration;
+
+    if (this->distance >= fullRampsDistance) {
+        this->peakVelocity = maxVelocity;
+        this->accelerationTime = maxVelocity / averageAcceleration;
+        this->cruiseTime = (this->distance - fullRampsDistance) / maxVelocity;
+    } else {
+        // Max velocity not reachable, triangular profile
+        this->peakVelocity = sqrtf(this->distance * averageAcceleration);
+        this->accelerationTime = this->peakVelocity / averageAcceleration;
+        this->cruiseTime = 0;
+    }
+}
+
+/**
+ * Distance covered during acceleration ramp after given time
+ */
+float MotionProfile::rampDistance(float time) {
+    float ramp = this->accelerationTime;
+
+    if (this->shape == MotionProfileSCurve) {
+        return this->peakVelocity * (time * time / (2 * ramp) + ramp * (cosf(2 * PI * time / ramp) - 1) / (4 * PI * PI));
+    }
+
+    return this->peakVelocity * time * time / (2 * ramp);
+}
+
+float MotionProfile::positionAt(unsigned long elapsedMiliseconds) {
+    float time = elapsedMiliseconds / 1000.0f;
+    float totalTime = 2 * this->accelerationTime + this->cruiseTime;
+    float covered;
+
+    if (time >= totalTime) {
+        covered = this->distance;
+    } else if (time < this->accelerationTime) {
+        covered = this->rampDistance(time);
+    } else if (time < this->accelerationTime + this->cruiseTime) {
+        covered = this->peakVelocity * this->accelerationTime / 2 + this->peakVelocity * (time - this->accelerationTime);
+    } else {
+        covered = this->distance - this->rampDistance(totalTime - time);
+    }
+
+    return this->startPosition + this->direction * covered;
+}
+
+float MotionProfile::velocityAt(unsigned long elapsedMiliseconds) {
+    float time = elapsedMiliseconds / 1000.0f;
+    float totalTime = 2 * this->accelerationTime + this->cruiseTime;
+
+    if (time >= totalTime) {
+        return 0;
+    }
+
+    float rampTime;
+
+    if (time < this->accelerationTime) {
+        rampTime = time;
+    } else if (time < this->accelerationTime + this->cruiseTime) {
+        return this->peakVelocity;
+    } else {
+        rampTime = totalTime - time;
+    }
+
+    if (this->shape == MotionProfileSCurve) {
+        return this->peakVelocity * (rampTime / this->accelerationTime - sinf(2 * PI * rampTime / this->accelerationTime) / (2 * PI));
+    }
+
+    return this->peakVelocity * rampTime / this->accelerationTime;
+}
+
+float MotionProfile::getTargetPosition() {
+    return this->startPosition + this->direction * this->distance;
+}
+
+unsigned long MotionProfile::getDurationMiliseconds() {
+    return ceilf((2 * this->accelerationTime + this->cruiseTime) * 1000);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <Arduino.h>
+
+enum MotionProfileShape { MotionProfileTrapezoidal, MotionProfileSCurve };
+
+/**
+ * Time-optimal point to point trajectory limited by max velocity and max acceleration
+ * Trapezoidal: constant acceleration ramps
+ * SCurve: sine-squared acceleration ramps (no acceleration jumps), peak acceleration still limited by maxAcceleration
+ * Planned once per move, afterwards only evaluated
+ */
+class MotionProfile {
+    private:
+        MotionProfileShape shape;
+        float startPosition;
+        float distance; // Absolute
+        float direction; // 1 or -1
+        float peakVelocity;
+        float accelerationTime; // Seconds (same for deceleration)
+        float cruiseTime; // Seconds
+        float rampDistance(float time);
+
+    public:
+        MotionProfile();
+        void plan(float startPosition, float targetPosition, float maxVelocity, float maxAcceleration, MotionProfileShape shape);
+        float positionAt(unsigned long elapsedMiliseconds);
+        float velocityAt(unsigned long elapsedMiliseconds); // Absolute
+        float getTargetPosition();
+        unsigned long getDurationMiliseconds();
+};
+
+#endif
\ No newline at end of file
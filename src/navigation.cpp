@@ -26,7 +26,7 @@ vector<Setting> settings {
     },
 };
 
-Navigation::Navigation(byte potentiometerGpio, boolean isPotentiometerInverted, ServoWrapper& servoPullOpen, ServoWrapper& servoPullClose, LedWrapper& led, AppModeEnum* appMode, LcdWrapper* lcd, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos, ValuesJitterFilter* valuesJitterFilter): servoPullOpen(servoPullOpen), servoPullClose(servoPullClose), led(led), lcd(lcd), batteryVoltageMeterBox(batteryVoltageMeterBox), batteryVoltageMeterServos(batteryVoltageMeterServos), valuesJitterFilter(valuesJitterFilter) {
+Navigation::Navigation(byte potentiometerGpio, boolean isPotentiometerInverted, AdcSampler* adcSampler, ServoWrapper& servoPullOpen, ServoWrapper& servoPullClose, LedWrapper& led, AppModeEnum* appMode, LcdWrapper* lcd, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos, MotionExecutor* motionExecutor): adcSampler(adcSampler), servoPullOpen(servoPullOpen), servoPullClose(servoPullClose), led(led), lcd(lcd), batteryVoltageMeterBox(batteryVoltageMeterBox), batteryVoltageMeterServos(batteryVoltageMeterServos), potentiometerFilter(MedianFilter<uint16_t, 3>(), EmaFilter<uint16_t>(POTENTIOMETER_EMA_ALPHA), HysteresisFilter<uint16_t>(POTENTIOMETER_HYSTERESIS, 0, ADC_RAW_MAX_VALUE)), motionExecutor(motionExecutor) {
     this->appMainState = Sleep;
     this->mainMenuState = MainMenuNone; // Chosen menu
     this->mainMenuTemporaryState = MainMenuNone; // Temporary position while selecting
@@ -75,11 +75,9 @@ Navigation::Navigation(byte potentiometerGpio, boolean isPotentiometerInverted,
 }
 
 void Navigation::initialize() {
-    if (this->isPotentiometerInverted) {
-        this->valuesJitterFilter->addValue("pontentiometer", 4095, 4095, 0, 1.5);
-    } else {
-        this->valuesJitterFilter->addValue("pontentiometer", 0, 0, 4095, 1.5);
-    }
+    // Seeding filter with current position
+    this->potentiometerFilter.reset();
+    this->getPotentiometerValue();
 }
 
 void Navigation::assignRangesForMainMenu(const vector<MainMenuEnum>& positions) {
@@ -141,12 +139,10 @@ void Navigation::logAppState() {
 }
 
 uint16_t Navigation::getPotentiometerValue() {
-    uint16_t value = analogRead(this->potentiometerGpio);
+    uint16_t value = this->adcSampler->getValue(this->potentiometerGpio);
     value = this->isPotentiometerInverted ? 4095 - value : value;
 
-    int filteredValue = this->valuesJitterFilter->updateValue("pontentiometer", value);
-
-    return filteredValue;
+    return this->potentiometerFilter.update(value);
 }
 
 void Navigation::handleForward() {
@@ -342,11 +338,13 @@ void Navigation::handleMenuSelection() {
         displayMainMenuLed(this->mainMenuTemporaryState);
     }
 
-    String mainMenuStateString = translateMainMenuStateEnumIntoString(mainMenuTemporaryState);
+    // Runs every tick while menu is browsed, rows are formatted on stack (no String)
+    const char* mainMenuStateString = translateMainMenuStateEnumIntoString(mainMenuTemporaryState);
+    char bottomRowText[LCD_TEXT_MAX_LENGTH + 1];
 
     switch (mainMenuTemporaryState) {
         case MainMenuCalibration: {
-            String bottomRowText = translateServoEnumToStringShort(this->selectedServoEnum) + " " + String(this->selectedServo->min) + ":" + String(this->selectedServo->max);
+            snprintf(bottomRowText, sizeof(bottomRowText), "%s %d:%d", translateServoEnumToStringShort(this->selectedServoEnum), this->selectedServo->min, this->selectedServo->max);
 
             lcd->print(mainMenuStateString, bottomRowText);
             break;
@@ -365,12 +363,16 @@ void Navigation::handleMenuSelection() {
         }
 
         case MainMenuBatteryVoltageBox: {
-            lcd->print(mainMenuStateString, batteryVoltageMeterBox->getBatteryVoltageMessage());
+            batteryVoltageMeterBox->formatBatteryVoltageMessage(bottomRowText, sizeof(bottomRowText));
+
+            lcd->print(mainMenuStateString, bottomRowText);
             break;     
         }
 
         case MainMenuBatteryVoltageServos: {
-            lcd->print(mainMenuStateString, batteryVoltageMeterServos->getBatteryVoltageMessage());
+            batteryVoltageMeterServos->formatBatteryVoltageMessage(bottomRowText, sizeof(bottomRowText));
+
+            lcd->print(mainMenuStateString, bottomRowText);
             break;
         }
 
@@ -394,7 +396,7 @@ void Navigation::handleCalibrate() {
     calibrationTemporaryValue = servoValue;
 
     Serial.println(servoValue);
-    lcd->print(translateMainMenuStateEnumIntoString(mainMenuState) + ":", String(servoValue));
+    printValue(translateMainMenuStateEnumIntoString(mainMenuState), nullptr, servoValue);
 
     selectedServo->write(calibrationTemporaryValue);
 }
@@ -403,11 +405,10 @@ void Navigation::handleMove() {
     uint16_t value = getPotentiometerValue();
     uint8_t servoValue = translateAnalogTo100Range(value);
 
-    Serial.println("ServoValue: " + String(servoValue));
-
-    String bottomRowText = translateServoEnumToStringShort(selectedServoEnum) + ": " + String(servoValue);
+    Serial.print("ServoValue: ");
+    Serial.println(servoValue);
 
-    lcd->print(translateMainMenuStateEnumIntoString(mainMenuState) + ":", bottomRowText);
+    printValue(translateMainMenuStateEnumIntoString(mainMenuState), translateServoEnumToStringShort(selectedServoEnum), servoValue);
 
     selectedServo->moveTo(servoValue);
 }
@@ -416,9 +417,10 @@ void Navigation::handleMoveBothServos() {
     uint16_t value = getPotentiometerValue();
     uint8_t servoValue = translateAnalogTo100Range(value);
 
-    Serial.println("ServoValue: " + String(servoValue));
+    Serial.print("ServoValue: ");
+    Serial.println(servoValue);
 
-    lcd->print(translateMainMenuStateEnumIntoString(mainMenuState) + ":", String(servoValue));
+    printValue(translateMainMenuStateEnumIntoString(mainMenuState), nullptr, servoValue);
 
     servoPullOpen.moveTo(servoValue);
     servoPullClose.moveTo(servoValue);
@@ -436,7 +438,7 @@ void Navigation::handleServoSelection() {
 
     temporarySelectedServoEnum = localTemporarySelectedServoEnum;
 
-    lcd->print(translateMainMenuStateEnumIntoString(mainMenuState) + ":", translateServoEnumToString(temporarySelectedServoEnum));
+    lcd->print(String(translateMainMenuStateEnumIntoString(mainMenuState)) + ":", translateServoEnumToString(temporarySelectedServoEnum));
     Serial.println(translateServoEnumToString(temporarySelectedServoEnum));
 }
 
@@ -452,7 +454,7 @@ void Navigation::handleAppModeSelection() {
 
     temporaryAppMode = localTemporaryAppMode;
 
-    lcd->print(translateMainMenuStateEnumIntoString(mainMenuState) + ":", translateAppModeEnumToString(temporaryAppMode));
+    lcd->print(String(translateMainMenuStateEnumIntoString(mainMenuState)) + ":", translateAppModeEnumToString(temporaryAppMode));
     Serial.println(translateAppModeEnumToString(temporaryAppMode));
 }
 
@@ -488,7 +490,7 @@ void Navigation::handleSetSettingValue() {
 
     this->temporarySettingValue = settingSelectionValue;
 
-    lcd->print(translateSettingEnumToString(temporarySelectedSettingEnum) + ":", String(settingSelectionValue));
+    printValue(translateSettingEnumToString(temporarySelectedSettingEnum), nullptr, settingSelectionValue);
     Serial.println(settingSelectionValue);
 }
 
@@ -496,20 +498,20 @@ void Navigation::handleMoveSmoothlySelection() {
     uint16_t value = getPotentiometerValue();
     uint8_t servoPosition = translateAnalogTo100Range(value); // 0 - 100
 
-    Serial.println("ServoPosition: " + String(servoPosition));
+    Serial.print("ServoPosition: ");
+    Serial.println(servoPosition);
 
-    String bottomRowText = translateServoEnumToStringShort(selectedServoEnum) + ": " + String(servoPosition);
-
-    lcd->print(translateMainMenuStateEnumIntoString(this->mainMenuState) + ":", bottomRowText);
+    printValue(translateMainMenuStateEnumIntoString(this->mainMenuState), translateServoEnumToStringShort(selectedServoEnum), servoPosition);
 }
 
 void Navigation::handleMoveBothServosSmoothlySelection() {
     uint16_t value = getPotentiometerValue();
     uint8_t servoPosition = translateAnalogTo100Range(value); // 0 - 100
 
-    Serial.println("ServoPosition: " + String(servoPosition));
+    Serial.print("ServoPosition: ");
+    Serial.println(servoPosition);
 
-    lcd->print(translateMainMenuStateEnumIntoString(this->mainMenuState) + ":", String(servoPosition));
+    printValue(translateMainMenuStateEnumIntoString(this->mainMenuState), nullptr, servoPosition);
 }
 
 void Navigation::confirmServoSelection() {
@@ -580,7 +582,10 @@ void Navigation::moveServoSmoothlyTo() {
     uint16_t value = getPotentiometerValue();
     uint8_t servoPosition = translateAnalogTo100Range(value); // 0 - 100
 
-    selectedServo->setMovingSmoothlyTarget(servoPosition);
+    MotionPlan plan;
+    plan.addAxis(selectedServo, servoPosition);
+
+    motionExecutor->submit(plan);
 }
 
 void Navigation::moveBothServosSmoothlyTo() {
@@ -588,12 +593,15 @@ void Navigation::moveBothServosSmoothlyTo() {
     uint8_t servoPosition = translateAnalogTo100Range(value); // 0 - 100
 
     // No delay between movement beginning
-    servoPullOpen.setMovingSmoothlyTarget(servoPosition);
-    servoPullClose.setMovingSmoothlyTarget(servoPosition);
+    MotionPlan plan;
+    plan.addAxis(&servoPullOpen, servoPosition);
+    plan.addAxis(&servoPullClose, servoPosition);
+
+    motionExecutor->submit(plan);
 }
 
 
-String Navigation::translateAppModeEnumToString(AppModeEnum appMode) {
+const char* Navigation::translateAppModeEnumToString(AppModeEnum appMode) {
     switch (appMode) {
         case Manual:
             return "Manual";
@@ -604,7 +612,7 @@ String Navigation::translateAppModeEnumToString(AppModeEnum appMode) {
     return "Unknown";
 }
 
-String Navigation::translateAppMainStateEnumIntoString(AppMainStateEnum appMainState) {
+const char* Navigation::translateAppMainStateEnumIntoString(AppMainStateEnum appMainState) {
     switch (appMainState) {
         case Sleep:
             return "Sleep";
@@ -615,7 +623,7 @@ String Navigation::translateAppMainStateEnumIntoString(AppMainStateEnum appMainS
     return "Unknown";
 }
 
-String Navigation::translateMainMenuStateEnumIntoString(MainMenuEnum mainMenuState) {
+const char* Navigation::translateMainMenuStateEnumIntoString(MainMenuEnum mainMenuState) {
     switch (mainMenuState) {
         case MainMenuNone:
             return "None";
@@ -644,7 +652,7 @@ String Navigation::translateMainMenuStateEnumIntoString(MainMenuEnum mainMenuSta
     return "Unknown";
 }
 
-String Navigation::translateServoEnumToString(ServoEnum servoEnum) {
+const char* Navigation::translateServoEnumToString(ServoEnum servoEnum) {
     switch (servoEnum) {
         case ServoPullOpen:
             return "ServoPullOpen";
@@ -655,7 +663,7 @@ String Navigation::translateServoEnumToString(ServoEnum servoEnum) {
     return "Unknown";
 }
 
-String Navigation::translateServoEnumToStringShort(ServoEnum servoEnum) {
+const char* Navigation::translateServoEnumToStringShort(ServoEnum servoEnum) {
     switch (servoEnum) {
         case ServoPullOpen:
             return "Open";
@@ -666,7 +674,7 @@ String Navigation::translateServoEnumToStringShort(ServoEnum servoEnum) {
     return "Unknown";
 }
 
-String Navigation::translateSettingEnumToString(SettingEnum settingEnum) {
+const char* Navigation::translateSettingEnumToString(SettingEnum settingEnum) {
     switch (settingEnum) {
         case SettingOptimalTemperature:
             return "OptimalTemperature";
@@ -679,6 +687,24 @@ String Navigation::translateSettingEnumToString(SettingEnum settingEnum) {
     return "Unknown";
 }
 
+/**
+ * "Top:" / "Label: value" (or just value), used by handlers redrawn every tick
+ */
+void Navigation::printValue(const char* topRowText, const char* label, int32_t value) {
+    char topRow[LCD_TEXT_MAX_LENGTH + 1];
+    char bottomRow[LCD_TEXT_MAX_LENGTH + 1];
+
+    snprintf(topRow, sizeof(topRow), "%s:", topRowText);
+
+    if (label != nullptr) {
+        snprintf(bottomRow, sizeof(bottomRow), "%s: %ld", label, (long) value);
+    } else {
+        snprintf(bottomRow, sizeof(bottomRow), "%ld", (long) value);
+    }
+
+    lcd->print(topRow, bottomRow);
+}
+
 void Navigation::displayMainMenuLed(MainMenuEnum mainMenuState) {
     switch (mainMenuState) {
         case MainMenuCalibration:
@@ -10,10 +10,18 @@
 #include <memoryData.h>
 #include <lcdWrapper.h>
 #include <batteryVoltageMeter.h>
-#include <valuesJitterFilter.h>
+#include <adcSampler.h>
+#include <signalFilters.h>
+#include <motionExecutor.h>
 
 using namespace std;
 
+const float POTENTIOMETER_EMA_ALPHA = 0.3;
+const uint16_t POTENTIOMETER_HYSTERESIS = 40; // ~1% of ADC range
+
+// Median removes ADC spikes, EMA smooths, hysteresis keeps selection from flickering on boundaries (and snaps to 0 / 4095 near the ends)
+typedef FilterPipeline<uint16_t, MedianFilter<uint16_t, 3>, EmaFilter<uint16_t>, HysteresisFilter<uint16_t>> PotentiometerFilter;
+
 enum AppMainStateEnum { Sleep, Awaken };
 enum MainMenuEnum {
     MainMenuNone,
@@ -73,6 +81,7 @@ class Navigation {
     private:
         byte potentiometerGpio;
         boolean isPotentiometerInverted;
+        AdcSampler* adcSampler;
         vector<MainMenuPosition> mainMenuPositions;
         vector<SettingPosition> settingSelectionPositions;
         vector<ServoSelectionPosition> servoSelectionPositions;
@@ -95,7 +104,8 @@ class Navigation {
         LcdWrapper* lcd;
         BatteryVoltageMeter* batteryVoltageMeterBox;
         BatteryVoltageMeter* batteryVoltageMeterServos;
-        ValuesJitterFilter* valuesJitterFilter;
+        PotentiometerFilter potentiometerFilter;
+        MotionExecutor* motionExecutor;
         
         void setServoCalibrationMin();
         void setServoCalibrationMax();
@@ -112,13 +122,13 @@ class Navigation {
         AppModeEnum findAppModeSelection(uint8_t position);
         SettingEnum findSettingSelection(uint8_t position);
 
-        // Translation
-        String translateAppMainStateEnumIntoString(AppMainStateEnum appMainState);
-        String translateMainMenuStateEnumIntoString(MainMenuEnum mainMenuState);
-        String translateServoEnumToString(ServoEnum servoEnum);
-        String translateServoEnumToStringShort(ServoEnum servoEnum);
-        String translateAppModeEnumToString(AppModeEnum appModeEnum);
-        String translateSettingEnumToString(SettingEnum settingEnum);
+        // Translation (static texts, no heap)
+        const char* translateAppMainStateEnumIntoString(AppMainStateEnum appMainState);
+        const char* translateMainMenuStateEnumIntoString(MainMenuEnum mainMenuState);
+        const char* translateServoEnumToString(ServoEnum servoEnum);
+        const char* translateServoEnumToStringShort(ServoEnum servoEnum);
+        const char* translateAppModeEnumToString(AppModeEnum appModeEnum);
+        const char* translateSettingEnumToString(SettingEnum settingEnum);
 
         // Confirmations
         void confirmServoSelection();
@@ -134,10 +144,11 @@ class Navigation {
         uint16_t getPotentiometerValue();
         void displayMainMenuLed(MainMenuEnum mainMenuState);
         void logAppState();
+        void printValue(const char* topRowText, const char* label, int32_t value);
         Setting* getSettingByEnum(SettingEnum settingName);
 
     public:
-        Navigation(byte potentiometerGpio, boolean isPotentiometerInverted, ServoWrapper& servoPullOpen, ServoWrapper& servoPullClose, LedWrapper& ledWrapper, AppModeEnum* appMode, LcdWrapper* lcd, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos, ValuesJitterFilter* valuesJitterFilter);
+        Navigation(byte potentiometerGpio, boolean isPotentiometerInverted, AdcSampler* adcSampler, ServoWrapper& servoPullOpen, ServoWrapper& servoPullClose, LedWrapper& ledWrapper, AppModeEnum* appMode, LcdWrapper* lcd, BatteryVoltageMeter* batteryVoltageMeterBox, BatteryVoltageMeter* batteryVoltageMeterServos, MotionExecutor* motionExecutor);
 
         AppMainStateEnum appMainState;
         MainMenuEnum mainMenuState;
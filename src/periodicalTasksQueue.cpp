@@ -1,39 +1,64 @@
 #include "periodicalTasksQueue.h"
 
-vector<PeriodicalTasksQueueItem> periodicalTasksQueue;
+FixedVector<PeriodicalTasksQueueItem, PERIODICAL_TASKS_QUEUE_CAPACITY> periodicalTasksQueue;
 
 void checkPeriodicalTasksQueue() {
+  checkPeriodicalTasksQueue(millis());
+}
+
+void checkPeriodicalTasksQueue(unsigned long currentMillis) {
   if (periodicalTasksQueue.empty()) {
     return;
   }
 
-  if (millis() >= periodicalTasksQueue[0].executionTimeMillis) {
-    periodicalTasksQueue[0].taskFunction();
-    periodicalTasksQueue.erase(periodicalTasksQueue.begin());
+  if (currentMillis >= periodicalTasksQueue[0].executionTimeMillis) {
+    // Removed before it runs, task usually reschedules itself into the freed slot
+    void (*taskFunction)() = periodicalTasksQueue[0].taskFunction;
+    periodicalTasksQueue.erase(0);
+
+    taskFunction();
   }
 }
 
-void addPeriodicalTaskInMillis(void (*taskFunction)(), unsigned long executionDelayMillis) {
-  addPeriodicalTask(taskFunction, millis() + executionDelayMillis);
+unsigned long getMilisecondsUntilNextPeriodicalTask() {
+  return getMilisecondsUntilNextPeriodicalTask(millis());
 }
 
-void addPeriodicalTask(void (*taskFunction)(), unsigned long executionTimeMillis) {
+unsigned long getMilisecondsUntilNextPeriodicalTask(unsigned long currentMillis) {
+  if (periodicalTasksQueue.empty()) {
+    return PERIODICAL_TASKS_NO_DEADLINE;
+  }
+
+  if (currentMillis >= periodicalTasksQueue[0].executionTimeMillis) {
+    return 0;
+  }
+
+  return periodicalTasksQueue[0].executionTimeMillis - currentMillis;
+}
+
+void clearPeriodicalTasksQueue() {
+  periodicalTasksQueue.clear();
+}
+
+bool addPeriodicalTaskInMillis(void (*taskFunction)(), unsigned long executionDelayMillis) {
+  return addPeriodicalTask(taskFunction, millis() + executionDelayMillis);
+}
+
+bool addPeriodicalTask(void (*taskFunction)(), unsigned long executionTimeMillis) {
   PeriodicalTasksQueueItem newItem;
   newItem.taskFunction = taskFunction;
   newItem.executionTimeMillis = executionTimeMillis;
 
-  if (periodicalTasksQueue.empty()) {
-    periodicalTasksQueue.push_back(newItem);
-    return;
+  uint16_t index = 0;
+
+  while (index < periodicalTasksQueue.size() && periodicalTasksQueue[index].executionTimeMillis <= newItem.executionTimeMillis) {
+    index++;
   }
 
-  for (int i = 0; i < periodicalTasksQueue.size(); i++) {
-    if (newItem.executionTimeMillis < periodicalTasksQueue[i].executionTimeMillis) {
-      periodicalTasksQueue.insert(periodicalTasksQueue.begin() + i, newItem);
-      return;
-    }
+  if (!periodicalTasksQueue.insert(index, newItem)) {
+    Serial.println("Periodical tasks queue is full, task dropped");
+    return false;
   }
 
-  // If the new item is the last one, add it to the end of the queue
-  periodicalTasksQueue.push_back(newItem);
+  return true;
 }
\ No newline at end of file
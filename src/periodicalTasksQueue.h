@@ -2,9 +2,10 @@
 #define PERIODICAL_TASKS_QUEUE_H
 
 #include <Arduino.h>
-#include <vector>
+#include <fixedVector.h>
 
-using namespace std;
+const unsigned long PERIODICAL_TASKS_NO_DEADLINE = UINT32_MAX;
+const uint16_t PERIODICAL_TASKS_QUEUE_CAPACITY = 12; // Every task keeps at most one pending item (reschedules itself)
 
 struct PeriodicalTasksQueueItem {
   void (*taskFunction)();
@@ -12,7 +13,11 @@ struct PeriodicalTasksQueueItem {
 };
 
 void checkPeriodicalTasksQueue();
-void addPeriodicalTask(void (*taskFunction)(), unsigned long executionTimeMillis);
-void addPeriodicalTaskInMillis(void (*taskFunction)(), unsigned long executionDelayMillis);
+void checkPeriodicalTasksQueue(unsigned long currentMillis);
+bool addPeriodicalTask(void (*taskFunction)(), unsigned long executionTimeMillis); // False when queue is full
+bool addPeriodicalTaskInMillis(void (*taskFunction)(), unsigned long executionDelayMillis);
+unsigned long getMilisecondsUntilNextPeriodicalTask(); // 0 when overdue
+unsigned long getMilisecondsUntilNextPeriodicalTask(unsigned long currentMillis);
+void clearPeriodicalTasksQueue();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <esp_attr.h>
+#include <esp_sleep.h>
+#include <powerManager.h>
+
+RTC_DATA_ATTR PowerManagerState powerManagerState = {};
+
+PowerManager::PowerManager(AdcSampler* adcSampler, BluetoothWrapper* bluetoothWrapper): adcSampler(adcSampler), bluetoothWrapper(bluetoothWrapper) {
+    this->deadlineProvidersCount = 0;
+    this->wakeupButtonsCount = 0;
+    this->isPowerManagementAvailable = false;
+    this->isAutomaticLightSleepEnabled = false;
+    this->busyLock = nullptr;
+    this->isBusyLockAcquired = false;
+}
+
+void PowerManager::initialize() {
+    powerManagerState.bootsCount++;
+    powerManagerState.isSleepMode = false; // UI always starts awake
+
+    // Fails when firmware is built without CONFIG_PM_ENABLE
+    this->isPowerManagementAvailable = this->configureAutomaticLightSleep(false) && esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "PowerManagerBusy", &this->busyLock) == ESP_OK;
+
+    esp_sleep_enable_gpio_wakeup();
+
+    Serial.print("Power management: ");
+    Serial.println(this->isPowerManagementAvailable ? "esp_pm" : "manual light sleep");
+}
+
+bool PowerManager::addDeadlineProvider(WakeupDeadlineProvider provider) {
+    if (this->deadlineProvidersCount >= POWER_MANAGER_MAX_DEADLINE_PROVIDERS) {
+        return false;
+    }
+
+    this->deadlineProviders[this->deadlineProvidersCount] = provider;
+    this->deadlineProvidersCount++;
+
+    return true;
+}
+
+bool PowerManager::addWakeupButton(ButtonHandler* button) {
+    if (this->wakeupButtonsCount >= POWER_MANAGER_MAX_WAKEUP_BUTTONS) {
+        return false;
+    }
+
+    this->wakeupButtons[this->wakeupButtonsCount] = button;
+    this->wakeupButtonsCount++;
+
+    return true;
+}
+
+bool PowerManager::configureAutomaticLightSleep(bool isEnabled) {
+    esp_pm_config_esp32_t config = {
+        max_freq_mhz: POWER_MANAGER_MAX_CPU_FREQUENCY_MHZ,
+        min_freq_mhz: POWER_MANAGER_MIN_CPU_FREQUENCY_MHZ,
+        light_sleep_enable: isEnabled
+    };
+
+    return esp_pm_configure(&config) == ESP_OK;
+}
+
+void PowerManager::setBusyLock(bool isBusy) {
+    if (this->busyLock == nullptr || this->isBusyLockAcquired == isBusy) {
+        return;
+    }
+
+    if (isBusy) {
+        esp_pm_lock_acquire(this->busyLock);
+    } else {
+        esp_pm_lock_release(this->busyLock);
+    }
+
+    this->isBusyLockAcquired = isBusy;
+}
+
+/**
+ * UI went to sleep, peripherals which keep clocks running are slowed down or stopped
+ */
+void PowerManager::enterSleepMode() {
+    if (powerManagerState.isSleepMode) {
+        return;
+    }
+
+    powerManagerState.isSleepMode = true;
+
+    for (uint8_t i = 0; i < this->wakeupButtonsCount; i++) {
+        this->wakeupButtons[i]->setWakeupEnabled(true);
+    }
+
+    this->adcSampler->suspend();
+    this->bluetoothWrapper->setLowPowerMode(true);
+
+    // Tickless idle is required too, otherwise light sleep is refused
+    this->isAutomaticLightSleepEnabled = this->isPowerManagementAvailable && this->configureAutomaticLightSleep(true);
+
+    Serial.println(this->isAutomaticLightSleepEnabled ? "Automatic light sleep enabled" : "Manual light sleep enabled");
+}
+
+void PowerManager::exitSleepMode() {
+    if (!powerManagerState.isSleepMode) {
+        return;
+    }
+
+    powerManagerState.isSleepMode = false;
+
+    if (this->isAutomaticLightSleepEnabled) {
+        this->configureAutomaticLightSleep(false);
+        this->isAutomaticLightSleepEnabled = false;
+    }
+
+    this->setBusyLock(false);
+
+    for (uint8_t i = 0; i < this->wakeupButtonsCount; i++) {
+        this->wakeupButtons[i]->setWakeupEnabled(false);
+    }
+
+    this->adcSampler->resume();
+    this->bluetoothWrapper->setLowPowerMode(false);
+
+    Serial.print("Light sleeps: ");
+    Serial.print(powerManagerState.sleepsCount);
+    Serial.print(", slept [ms]: ");
+    Serial.println(powerManagerState.sleptMiliseconds);
+}
+
+bool PowerManager::isSleepMode() {
+    return powerManagerState.isSleepMode;
+}
+
+uint32_t PowerManager::getMilisecondsUntilNextWakeup() {
+    uint32_t untilWakeup = POWER_MANAGER_NO_DEADLINE;
+
+    for (uint8_t i = 0; i < this->deadlineProvidersCount; i++) {
+        untilWakeup = std::min(untilWakeup, this->deadlineProviders[i]());
+    }
+
+    return untilWakeup;
+}
+
+/**
+ * Called from loop while UI sleeps
+ * Automatic mode only holds CPU awake while something is busy, manual mode sleeps here
+ */
+TickType_t PowerManager::sleepUntilNextWakeup() {
+    if (!powerManagerState.isSleepMode) {
+        return pdMS_TO_TICKS(POWER_MANAGER_BUSY_WAIT_MILISECONDS);
+    }
+
+    uint32_t untilWakeup = this->getMilisecondsUntilNextWakeup();
+
+    if (untilWakeup < POWER_MANAGER_MIN_SLEEP_MILISECONDS) {
+        this->setBusyLock(true);
+        return pdMS_TO_TICKS(POWER_MANAGER_BUSY_WAIT_MILISECONDS);
+    }
+
+    uint32_t sleepMiliseconds = std::min(untilWakeup, POWER_MANAGER_MAX_SLEEP_MILISECONDS);
+
+    if (this->isAutomaticLightSleepEnabled) {
+        this->setBusyLock(false);
+        return pdMS_TO_TICKS(sleepMiliseconds);
+    }
+
+    this->sleepManually(sleepMiliseconds);
+
+    return pdMS_TO_TICKS(POWER_MANAGER_AWAKE_AFTER_SLEEP_MILISECONDS);
+}
+
+/**
+ * Whole chip sleeps, woken up by timer or button level
+ */
+void PowerManager::sleepManually(uint32_t sleepMiliseconds) {
+    unsigned long sleepStartMillis = millis();
+
+    esp_sleep_enable_timer_wakeup((uint64_t) sleepMiliseconds * 1000);
+    esp_light_sleep_start();
+
+    powerManagerState.sleepsCount++;
+    powerManagerState.sleptMiliseconds += millis() - sleepStartMillis;
+    powerManagerState.lastWakeupCause = esp_sleep_get_wakeup_cause();
+}
+
+/**
+ * Boot continues from setup(), everything which has to survive is in RTC memory
+ * First wakeup button wakes up too (ext0 is the only level wakeup not requiring all pins to be low)
+ */
+void PowerManager::enterDeepSleep(uint32_t sleepMiliseconds) {
+    Serial.print("Entering deep sleep [ms]: ");
+    Serial.println(sleepMiliseconds);
+    Serial.flush();
+
+    esp_sleep_enable_timer_wakeup((uint64_t) sleepMiliseconds * 1000);
+
+    if (this->wakeupButtonsCount > 0) {
+        gpio_num_t buttonGpio = (gpio_num_t) this->wakeupButtons[0]->getGpio();
+
+        if (rtc_gpio_is_valid_gpio(buttonGpio)) {
+            // Digital pull-up is not powered in deep sleep
+            rtc_gpio_pullup_en(buttonGpio);
+            rtc_gpio_pulldown_dis(buttonGpio);
+            esp_sleep_enable_ext0_wakeup(buttonGpio, LOW);
+        }
+    }
+
+    powerManagerState.deepSleepsCount++;
+
+    esp_deep_sleep_start();
+}
+
+PowerManagerState PowerManager::getState() {
+    return powerManagerState;
+}
\ No newline at end of file
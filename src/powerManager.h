@@ -0,0 +1,78 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <esp_pm.h>
+#include <driver/rtc_io.h>
+
+#include <buttonHandler.h>
+#include <adcSampler.h>
+#include <bluetoothWrapper.h>
+
+const uint8_t POWER_MANAGER_MAX_DEADLINE_PROVIDERS = 8;
+const uint8_t POWER_MANAGER_MAX_WAKEUP_BUTTONS = 4;
+const uint32_t POWER_MANAGER_NO_DEADLINE = UINT32_MAX;
+
+const int POWER_MANAGER_MAX_CPU_FREQUENCY_MHZ = 240;
+const int POWER_MANAGER_MIN_CPU_FREQUENCY_MHZ = 80; // Lowest one keeping BLE and WiFi running
+const uint32_t POWER_MANAGER_MIN_SLEEP_MILISECONDS = 20; // Shorter sleep costs more than it saves
+const uint32_t POWER_MANAGER_MAX_SLEEP_MILISECONDS = 60000;
+const uint32_t POWER_MANAGER_BUSY_WAIT_MILISECONDS = 100; // Something needs CPU, checked again after this
+const uint32_t POWER_MANAGER_AWAKE_AFTER_SLEEP_MILISECONDS = 150; // Tick based tasks get their turn after manual sleep
+
+// Kept in RTC memory, survives sleeps (and deep sleep wakeups)
+struct PowerManagerState {
+    uint32_t bootsCount;
+    bool isSleepMode;
+    uint32_t sleepsCount; // Manual light sleeps
+    uint32_t sleptMiliseconds;
+    uint8_t lastWakeupCause; // esp_sleep_wakeup_cause_t
+    uint32_t deepSleepsCount;
+};
+
+/**
+ * Miliseconds until deadline's owner needs CPU again, 0 - busy right now, POWER_MANAGER_NO_DEADLINE - idle
+ */
+typedef uint32_t (*WakeupDeadlineProvider)();
+
+/**
+ * Light sleep while UI sleeps
+ * Automatic light sleep (esp_pm, tickless idle) is used when firmware supports it, CPU then sleeps whenever all tasks wait
+ * Otherwise loop sleeps manually until nearest deadline
+ * Any deadline provider being busy keeps CPU awake, buttons wake it up in both modes
+ */
+class PowerManager {
+    private:
+        AdcSampler* adcSampler;
+        BluetoothWrapper* bluetoothWrapper;
+        WakeupDeadlineProvider deadlineProviders[POWER_MANAGER_MAX_DEADLINE_PROVIDERS];
+        uint8_t deadlineProvidersCount;
+        ButtonHandler* wakeupButtons[POWER_MANAGER_MAX_WAKEUP_BUTTONS];
+        uint8_t wakeupButtonsCount;
+        bool isPowerManagementAvailable;
+        bool isAutomaticLightSleepEnabled;
+        esp_pm_lock_handle_t busyLock;
+        bool isBusyLockAcquired;
+
+        bool configureAutomaticLightSleep(bool isEnabled);
+        void setBusyLock(bool isBusy);
+        void sleepManually(uint32_t sleepMiliseconds);
+
+    public:
+        PowerManager(AdcSampler* adcSampler, BluetoothWrapper* bluetoothWrapper);
+        void initialize();
+        bool addDeadlineProvider(WakeupDeadlineProvider provider);
+        bool addWakeupButton(ButtonHandler* button); // After button is initialized
+
+        void enterSleepMode();
+        void exitSleepMode();
+        bool isSleepMode();
+
+        uint32_t getMilisecondsUntilNextWakeup();
+        TickType_t sleepUntilNextWakeup(); // Returns how long caller can wait for button events
+        void enterDeepSleep(uint32_t sleepMiliseconds); // Does not return
+        PowerManagerState getState();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <rtcResume.h>
+#include <weatherLogs.h>
+
+// Zeroed on power on, kept through deep sleep
+RTC_DATA_ATTR RtcResumeState rtcResumeState;
+
+RtcResumeState* getRtcResumeState() {
+    if (esp_reset_reason() != ESP_RST_DEEPSLEEP || rtcResumeState.magic != RTC_RESUME_MAGIC) {
+        return nullptr;
+    }
+
+    return &rtcResumeState;
+}
+
+void copyDate(char* destination, const String& date) {
+    strncpy(destination, date.c_str(), RTC_RESUME_DATE_LENGTH - 1);
+    destination[RTC_RESUME_DATE_LENGTH - 1] = '\0';
+}
+
+void saveRtcResumeState(RtcResumeState state) {
+    state.logsNextSequence = getLogsHistoryNextSequence();
+    state.logsCount = copyNewestLogRecords(state.logs, RTC_RESUME_LOGS_COUNT);
+    state.hasWeather = !weatherLogs.empty();
+
+    if (state.hasWeather) {
+        const WeatherLog& weatherLog = weatherLogs.back();
+
+        state.weather.outsideTemperature = weatherLog.outsideTemperature;
+        state.weather.windSpeed = weatherLog.windSpeed;
+        state.weather.pm25 = weatherLog.pm25;
+        state.weather.pm10 = weatherLog.pm10;
+        copyDate(state.weather.forecastDate, weatherLog.forecastDate);
+        copyDate(state.weather.pm25Date, weatherLog.pm25Date);
+        copyDate(state.weather.pm10Date, weatherLog.pm10Date);
+    }
+
+    state.magic = RTC_RESUME_MAGIC;
+    rtcResumeState = state;
+}
+
+void restoreRtcResumeLogs(const RtcResumeState& state) {
+    restoreLogRecords(state.logs, state.logsCount, state.logsNextSequence);
+
+    if (state.hasWeather) {
+        addWeatherLog(state.weather.outsideTemperature, state.weather.windSpeed, String(state.weather.forecastDate), state.weather.pm25, String(state.weather.pm25Date), state.weather.pm10, String(state.weather.pm10Date));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef RTC_RESUME_H
+#define RTC_RESUME_H
+
+#include <Arduino.h>
+#include <time.h>
+
+#include <config.h>
+#include <logs.h>
+#include <bme280Compensation.h>
+#include <sensorProfiles.h>
+#include <sensorSampler.h>
+#include <batteryStateOfCharge.h>
+
+const uint32_t RTC_RESUME_MAGIC = 0x52534D32; // Has to be changed together with RtcResumeState layout
+const uint8_t RTC_RESUME_LOGS_COUNT = MAX_LOGS; // RTC slow memory has 8 kB, whole history does not fit
+const uint8_t RTC_RESUME_DATE_LENGTH = 20; // "YYYY-MM-DD HH:MM:SS"
+
+struct RtcResumeWeather {
+    float outsideTemperature;
+    float windSpeed;
+    float pm25;
+    float pm10;
+    char forecastDate[RTC_RESUME_DATE_LENGTH];
+    char pm25Date[RTC_RESUME_DATE_LENGTH];
+    char pm10Date[RTC_RESUME_DATE_LENGTH];
+};
+
+// Whatever is slow to get again after deep sleep, EEPROM settings are not duplicated here
+struct RtcResumeState {
+    uint32_t magic;
+    AppModeEnum appMode;
+    time_t lastWindowOpeningCalculationTime; // System time keeps running through deep sleep (RTC timer)
+    time_t lastWeatherFetchTime; // 0 - never
+    uint8_t servoPullOpenPosition;
+    uint8_t servoPullClosePosition;
+    bool hasBmeCalibration;
+    Bme280Calibration bmeCalibration;
+    SensorProfileCalibration sensorCalibrations[SENSOR_PROFILES_COUNT];
+    uint32_t logsNextSequence;
+    uint8_t logsCount;
+    LogRecord logs[RTC_RESUME_LOGS_COUNT];
+    bool hasWeather;
+    RtcResumeWeather weather;
+    BatteryHistory batteryBoxHistory;
+    BatteryHistory batteryServosHistory;
+};
+
+RtcResumeState* getRtcResumeState(); // nullptr unless woken up from deep sleep with valid state
+void saveRtcResumeState(RtcResumeState state); // Logs and weather are taken from their modules
+void restoreRtcResumeLogs(const RtcResumeState& state); // Logs and weather back to their modules
+
+#endif
\ No newline at end of file
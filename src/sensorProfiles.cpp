@@ -0,0 +1,73 @@
+#include <sensorProfiles.h>
+
+// BME280 datasheet, typical current during measurement and in sleep / standby
+const float BME280_TEMPERATURE_CURRENT_MICROAMPERES = 350;
+const float BME280_PRESSURE_CURRENT_MICROAMPERES = 714;
+const float BME280_HUMIDITY_CURRENT_MICROAMPERES = 340;
+const float BME280_SLEEP_CURRENT_MICROAMPERES = 0.1;
+const float BME280_STANDBY_CURRENT_MICROAMPERES = 0.2;
+
+bool isValidSensorProfile(int profile) {
+    return profile >= 0 && profile < SENSOR_PROFILES_COUNT;
+}
+
+uint8_t getOversamplingFactor(uint8_t oversamplingCode) {
+    if (oversamplingCode == 0) {
+        return 0; // Skipped
+    }
+
+    if (oversamplingCode >= 0b101) {
+        return 16;
+    }
+
+    return 1 << (oversamplingCode - 1);
+}
+
+/**
+ * Maximum measurement time (datasheet 9.1)
+ */
+uint32_t calculateMeasurementTimeMicroseconds(uint8_t temperatureOversampling, uint8_t pressureOversampling, uint8_t humidityOversampling) {
+    uint8_t temperatureFactor = getOversamplingFactor(temperatureOversampling);
+    uint8_t pressureFactor = getOversamplingFactor(pressureOversampling);
+    uint8_t humidityFactor = getOversamplingFactor(humidityOversampling);
+
+    uint32_t microseconds = 1250 + 2300 * temperatureFactor;
+
+    if (pressureFactor > 0) {
+        microseconds += 2300 * pressureFactor + 575;
+    }
+
+    if (humidityFactor > 0) {
+        microseconds += 2300 * humidityFactor + 575;
+    }
+
+    return microseconds;
+}
+
+/**
+ * Average current: charge of one measurement spread over measurement period plus sleep / standby current
+ */
+float estimateSensorCurrentMicroamperes(const SensorProfileConfig& profile) {
+    uint8_t temperatureFactor = getOversamplingFactor(profile.temperatureOversampling);
+    uint8_t pressureFactor = getOversamplingFactor(profile.pressureOversampling);
+    uint8_t humidityFactor = getOversamplingFactor(profile.humidityOversampling);
+
+    // uA * ms, typical conversion times
+    float measurementCharge = BME280_TEMPERATURE_CURRENT_MICROAMPERES * 2 * temperatureFactor;
+
+    if (pressureFactor > 0) {
+        measurementCharge += BME280_PRESSURE_CURRENT_MICROAMPERES * (2 * pressureFactor + 0.5);
+    }
+
+    if (humidityFactor > 0) {
+        measurementCharge += BME280_HUMIDITY_CURRENT_MICROAMPERES * (2 * humidityFactor + 0.5);
+    }
+
+    if (profile.mode == BME280_MODE_NORMAL_CODE) {
+        float periodMiliseconds = calculateMeasurementTimeMicroseconds(profile.temperatureOversampling, profile.pressureOversampling, profile.humidityOversampling) / 1000.0 + profile.standbyMiliseconds;
+
+        return measurementCharge / periodMiliseconds + BME280_STANDBY_CURRENT_MICROAMPERES;
+    }
+
+    return measurementCharge / profile.samplingIntervalMiliseconds + BME280_SLEEP_CURRENT_MICROAMPERES;
+}
\ No newline at end of file
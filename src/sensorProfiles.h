@@ -0,0 +1,75 @@
+#ifndef SENSOR_PROFILES_H
+#define SENSOR_PROFILES_H
+
+#include <Arduino.h>
+
+enum SensorProfile {
+    SensorProfileLowPowerForced = 0,
+    SensorProfileHighPrecision = 1,
+    SensorProfileFastResponse = 2
+};
+
+const uint8_t SENSOR_PROFILES_COUNT = 3;
+const SensorProfile DEFAULT_SENSOR_PROFILE = SensorProfileLowPowerForced;
+
+// BME280 register codes (same as Adafruit_BME280 enums)
+const uint8_t BME280_MODE_FORCED_CODE = 0b01;
+const uint8_t BME280_MODE_NORMAL_CODE = 0b11;
+
+struct SensorProfileConfig {
+    const char* name;
+    uint8_t mode;
+    uint8_t temperatureOversampling;
+    uint8_t pressureOversampling;
+    uint8_t humidityOversampling;
+    uint8_t filter;
+    uint8_t standby; // Normal mode only
+    uint16_t standbyMiliseconds; // Same as standby code, for estimates
+    uint32_t samplingIntervalMiliseconds; // How often sampler publishes new snapshot
+};
+
+const SensorProfileConfig SENSOR_PROFILES[SENSOR_PROFILES_COUNT] = {
+    // Sensor sleeps between single x1 measurements (datasheet: weather monitoring)
+    {
+        name: "LOW_POWER_FORCED",
+        mode: BME280_MODE_FORCED_CODE,
+        temperatureOversampling: 0b001,
+        pressureOversampling: 0b001,
+        humidityOversampling: 0b001,
+        filter: 0b000,
+        standby: 0b000,
+        standbyMiliseconds: 0,
+        samplingIntervalMiliseconds: 60000
+    },
+    // x16 oversampling with IIR, still forced
+    {
+        name: "HIGH_PRECISION",
+        mode: BME280_MODE_FORCED_CODE,
+        temperatureOversampling: 0b101,
+        pressureOversampling: 0b101,
+        humidityOversampling: 0b101,
+        filter: 0b010,
+        standby: 0b000,
+        standbyMiliseconds: 0,
+        samplingIntervalMiliseconds: 10000
+    },
+    // Continuous measurements, sampler only reads registers
+    {
+        name: "FAST_RESPONSE",
+        mode: BME280_MODE_NORMAL_CODE,
+        temperatureOversampling: 0b001,
+        pressureOversampling: 0b001,
+        humidityOversampling: 0b001,
+        filter: 0b000,
+        standby: 0b010,
+        standbyMiliseconds: 125,
+        samplingIntervalMiliseconds: 1000
+    }
+};
+
+bool isValidSensorProfile(int profile);
+uint8_t getOversamplingFactor(uint8_t oversamplingCode);
+uint32_t calculateMeasurementTimeMicroseconds(uint8_t temperatureOversampling, uint8_t pressureOversampling, uint8_t humidityOversampling);
+float estimateSensorCurrentMicroamperes(const SensorProfileConfig& profile);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include <sensorSampler.h>
+
+SensorSampler::SensorSampler(Bme280Sensor& bme, MemoryValue* sensorProfileMemory): bme(bme), sensorProfileMemory(sensorProfileMemory), temperatureFilter(TEMPERATURE_DRIFT_VARIANCE_PER_SECOND, TEMPERATURE_DEFAULT_MEASUREMENT_NOISE) {
+    this->taskHandle = nullptr;
+    this->eventGroup = nullptr;
+    this->activeProfile = DEFAULT_SENSOR_PROFILE;
+    this->requestedProfile = DEFAULT_SENSOR_PROFILE;
+    this->isCalibrationRequested = false;
+    this->sequence = 0;
+    this->snapshot = SensorSnapshot{
+        reading: Bme280Reading{ temperature: NAN, pressure: NAN, humidity: NAN },
+        timestampMillis: 0,
+        samplesCount: 0,
+        profile: DEFAULT_SENSOR_PROFILE
+    };
+
+    for (uint8_t i = 0; i < SENSOR_PROFILES_COUNT; i++) {
+        this->calibrations[i] = SensorProfileCalibration{ isCalibrated: false, temperatureStddev: 0, pressureStddev: 0, humidityStddev: 0 };
+    }
+}
+
+/**
+ * Sensor has to be already started (begin)
+ */
+void SensorSampler::initialize(uint32_t stackSize) {
+    this->eventGroup = xEventGroupCreate();
+
+    int storedProfile = this->sensorProfileMemory->readValue();
+    uint8_t profile = isValidSensorProfile(storedProfile) ? storedProfile : DEFAULT_SENSOR_PROFILE;
+
+    this->requestedProfile = profile;
+    this->applyProfile(profile);
+
+    xTaskCreate(SensorSampler::taskFunction, "SensorSamplerTask", stackSize, this, 1, &this->taskHandle);
+    this->bme.attachMeasurementCallback(SensorSampler::measurementReadyCallback, this);
+}
+
+void SensorSampler::taskFunction(void* param) {
+    static_cast<SensorSampler*>(param)->run();
+}
+
+/**
+ * From timer service task, only wakes sampler up
+ */
+void SensorSampler::measurementReadyCallback(void* context) {
+    SensorSampler* sampler = static_cast<SensorSampler*>(context);
+
+    if (sampler->taskHandle != nullptr) {
+        xTaskNotifyGive(sampler->taskHandle);
+    }
+}
+
+bool SensorSampler::hasPendingRequests() {
+    return this->requestedProfile != this->activeProfile || this->isCalibrationRequested;
+}
+
+void SensorSampler::run() {
+    while (true) {
+        if (this->requestedProfile != this->activeProfile) {
+            this->applyProfile(this->requestedProfile);
+        }
+
+        if (this->isCalibrationRequested) {
+            this->calibrate();
+            this->isCalibrationRequested = false;
+        }
+
+        this->sample();
+
+        // Request could have arrived (and its notification consumed) while measuring
+        if (this->hasPendingRequests()) {
+            continue;
+        }
+
+        // Sleeping until next sample, profile change or calibration request wakes up earlier
+        uint32_t samplingIntervalMiliseconds = SENSOR_PROFILES[this->activeProfile].samplingIntervalMiliseconds;
+        ulTaskNotifyTake(pdTRUE, samplingIntervalMiliseconds / portTICK_PERIOD_MS);
+    }
+}
+
+void SensorSampler::applyProfile(uint8_t profile) {
+    const SensorProfileConfig& config = SENSOR_PROFILES[profile];
+
+    this->bme.setSampling(
+        (Adafruit_BME280::sensor_mode) config.mode,
+        (Adafruit_BME280::sensor_sampling) config.temperatureOversampling,
+        (Adafruit_BME280::sensor_sampling) config.pressureOversampling,
+        (Adafruit_BME280::sensor_sampling) config.humidityOversampling,
+        (Adafruit_BME280::sensor_filter) config.filter,
+        (Adafruit_BME280::standby_duration) config.standby
+    );
+
+    this->activeProfile = profile;
+    this->configureTemperatureFilter(profile);
+
+    Serial.print("BME280 profile applied: ");
+    Serial.println(config.name);
+}
+
+/**
+ * Drift grows with sampling interval, calibrated profiles know their own noise
+ */
+void SensorSampler::configureTemperatureFilter(uint8_t profile) {
+    const SensorProfileCalibration& calibration = this->calibrations[profile];
+    float intervalSeconds = SENSOR_PROFILES[profile].samplingIntervalMiliseconds / 1000.0f;
+
+    this->temperatureFilter.setProcessNoise(TEMPERATURE_DRIFT_VARIANCE_PER_SECOND * intervalSeconds);
+    this->temperatureFilter.setMeasurementNoise(calibration.isCalibrated && calibration.temperatureStddev > 0 ? calibration.temperatureStddev * calibration.temperatureStddev : TEMPERATURE_DEFAULT_MEASUREMENT_NOISE);
+}
+
+bool SensorSampler::measure(Bme280Reading& reading) {
+    const SensorProfileConfig& config = SENSOR_PROFILES[this->activeProfile];
+
+    if (config.mode == BME280_MODE_FORCED_CODE) {
+        this->bme.startForcedMeasurement();
+
+        // Sleeping during conversion, measurement timer wakes sampler up
+        Bme280MeasurementStatus status;
+
+        while ((status = this->bme.pollForcedMeasurement(reading)) == Bme280MeasurementPending) {
+            ulTaskNotifyTake(pdTRUE, BME280_FORCED_MEASUREMENT_TIMEOUT_MILISECONDS / portTICK_PERIOD_MS);
+        }
+
+        if (status != Bme280MeasurementReady) {
+            Serial.println("BME280 forced measurement failed");
+            return false;
+        }
+    } else {
+        // In normal mode sensor measures on its own
+        reading = this->bme.readAll();
+    }
+
+    if (isnan(reading.temperature)) {
+        Serial.println("BME280 reading invalid");
+        return false;
+    }
+
+    return true;
+}
+
+void SensorSampler::sample() {
+    Bme280Reading reading;
+
+    if (!this->measure(reading)) {
+        return;
+    }
+
+    reading.temperature = this->temperatureFilter.update(reading.temperature);
+
+    this->publish(reading, millis());
+}
+
+/**
+ * Back-to-back samples in each profile, standard deviation via Welford's algorithm
+ * Selected profile is restored afterwards
+ */
+void SensorSampler::calibrate() {
+    uint8_t selectedProfile = this->activeProfile;
+
+    Serial.println("BME280 profiles calibration started");
+
+    for (uint8_t profile = 0; profile < SENSOR_PROFILES_COUNT; profile++) {
+        const SensorProfileConfig& config = SENSOR_PROFILES[profile];
+        this->applyProfile(profile);
+
+        uint32_t measurementMiliseconds = calculateMeasurementTimeMicroseconds(config.temperatureOversampling, config.pressureOversampling, config.humidityOversampling) / 1000 + 1;
+        uint32_t periodMiliseconds = config.mode == BME280_MODE_NORMAL_CODE ? measurementMiliseconds + config.standbyMiliseconds : 0;
+
+        // IIR filter and normal mode need to settle first
+        vTaskDelay((measurementMiliseconds + config.standbyMiliseconds) * 4 / portTICK_PERIOD_MS);
+
+        uint8_t count = 0;
+        float mean[3] = { 0, 0, 0 };
+        float m2[3] = { 0, 0, 0 };
+
+        for (uint8_t i = 0; i < SENSOR_CALIBRATION_SAMPLES_COUNT; i++) {
+            Bme280Reading reading;
+
+            if (periodMiliseconds > 0) {
+                vTaskDelay(periodMiliseconds / portTICK_PERIOD_MS);
+            }
+
+            if (!this->measure(reading)) {
+                continue;
+            }
+
+            float values[3] = { reading.temperature, reading.pressure, reading.humidity };
+            count++;
+
+            for (uint8_t j = 0; j < 3; j++) {
+                float delta = values[j] - mean[j];
+                mean[j] += delta / count;
+                m2[j] += delta * (values[j] - mean[j]);
+            }
+        }
+
+        if (count < 2) {
+            Serial.print("BME280 calibration failed for profile: ");
+            Serial.println(config.name);
+            continue;
+        }
+
+        this->calibrations[profile] = SensorProfileCalibration{
+            isCalibrated: true,
+            temperatureStddev: sqrtf(m2[0] / (count - 1)),
+            pressureStddev: sqrtf(m2[1] / (count - 1)),
+            humidityStddev: sqrtf(m2[2] / (count - 1))
+        };
+
+        Serial.print(config.name);
+        Serial.print(" temperature stddev: ");
+        Serial.print(this->calibrations[profile].temperatureStddev, 4);
+        Serial.print(", pressure stddev: ");
+        Serial.print(this->calibrations[profile].pressureStddev, 2);
+        Serial.print(", humidity stddev: ");
+        Serial.println(this->calibrations[profile].humidityStddev, 3);
+    }
+
+    this->applyProfile(selectedProfile);
+
+    Serial.println("BME280 profiles calibration finished");
+}
+
+/**
+ * Single writer, odd sequence marks snapshot which is being written
+ */
+void SensorSampler::publish(const Bme280Reading& reading, unsigned long timestampMillis) {
+    uint32_t currentSequence = this->sequence.load(std::memory_order_relaxed);
+
+    this->sequence.store(currentSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    this->snapshot.reading = reading;
+    this->snapshot.timestampMillis = timestampMillis;
+    this->snapshot.samplesCount++;
+    this->snapshot.profile = this->activeProfile;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    this->sequence.store(currentSequence + 2, std::memory_order_relaxed);
+
+    if (this->snapshot.samplesCount == 1) {
+        xEventGroupSetBits(this->eventGroup, SENSOR_SAMPLER_FIRST_SAMPLE_BIT);
+    }
+}
+
+/**
+ * Lock-free, retries only if sampler was publishing at the same time
+ */
+SensorSnapshot SensorSampler::getSnapshot() {
+    SensorSnapshot result;
+    uint32_t sequenceBefore;
+    uint32_t sequenceAfter;
+
+    do {
+        sequenceBefore = this->sequence.load(std::memory_order_acquire);
+
+        if (sequenceBefore & 1) {
+            continue;
+        }
+
+        result = this->snapshot;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        sequenceAfter = this->sequence.load(std::memory_order_relaxed);
+    } while ((sequenceBefore & 1) || sequenceBefore != sequenceAfter);
+
+    return result;
+}
+
+bool SensorSampler::waitForFirstSample(TickType_t timeoutTicks) {
+    if (this->eventGroup == nullptr) {
+        return false;
+    }
+
+    EventBits_t bits = xEventGroupWaitBits(this->eventGroup, SENSOR_SAMPLER_FIRST_SAMPLE_BIT, pdFALSE, pdTRUE, timeoutTicks);
+
+    return (bits & SENSOR_SAMPLER_FIRST_SAMPLE_BIT) != 0;
+}
+
+/**
+ * Stored in memory, applied by sampler task
+ */
+bool SensorSampler::setProfile(int profile) {
+    if (!isValidSensorProfile(profile)) {
+        return false;
+    }
+
+    this->sensorProfileMemory->setValue(profile);
+    this->requestedProfile = profile;
+
+    if (this->taskHandle != nullptr) {
+        xTaskNotifyGive(this->taskHandle);
+    }
+
+    return true;
+}
+
+SensorProfile SensorSampler::getProfile() {
+    return (SensorProfile) this->activeProfile.load();
+}
+
+void SensorSampler::requestCalibration() {
+    this->isCalibrationRequested = true;
+
+    if (this->taskHandle != nullptr) {
+        xTaskNotifyGive(this->taskHandle);
+    }
+}
+
+SensorProfileCalibration SensorSampler::getCalibration(uint8_t profile) {
+    return this->calibrations[profile];
+}
+
+/**
+ * Before initialize(), calibration measured before deep sleep
+ */
+void SensorSampler::restoreCalibration(uint8_t profile, const SensorProfileCalibration& calibration) {
+    if (isValidSensorProfile(profile)) {
+        this->calibrations[profile] = calibration;
+    }
+}
+
+TaskHandle_t SensorSampler::getTaskHandle() {
+    return this->taskHandle;
+}
\ No newline at end of file
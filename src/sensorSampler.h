@@ -0,0 +1,83 @@
+#ifndef SENSOR_SAMPLER_H
+#define SENSOR_SAMPLER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+
+#include <bme280Sensor.h>
+#include <sensorProfiles.h>
+#include <memoryValue.h>
+#include <signalFilters.h>
+
+const EventBits_t SENSOR_SAMPLER_FIRST_SAMPLE_BIT = BIT0;
+const uint8_t SENSOR_CALIBRATION_SAMPLES_COUNT = 16;
+
+// Temperature filter variances [C^2], measurement noise is replaced by calibrated one when available
+const float TEMPERATURE_DRIFT_VARIANCE_PER_SECOND = 0.0001;
+const float TEMPERATURE_DEFAULT_MEASUREMENT_NOISE = 0.01;
+
+struct SensorSnapshot {
+    Bme280Reading reading;
+    unsigned long timestampMillis; // When measurement was taken
+    uint32_t samplesCount; // 0 - no sample yet
+    uint8_t profile;
+};
+
+// Noise of back-to-back samples (sensor in stable conditions)
+struct SensorProfileCalibration {
+    bool isCalibrated;
+    float temperatureStddev;
+    float pressureStddev;
+    float humidityStddev;
+};
+
+/**
+ * Only owner of BME280 (and its I2C bus)
+ * Measures according to selected profile and publishes snapshot protected by seqlock,
+ * readers never touch I2C and never block the sampler
+ * Profile changes and calibration requests are executed by sampler task too
+ */
+class SensorSampler {
+    private:
+        Bme280Sensor& bme;
+        MemoryValue* sensorProfileMemory;
+        TaskHandle_t taskHandle;
+        EventGroupHandle_t eventGroup;
+
+        std::atomic<uint8_t> activeProfile;
+        std::atomic<uint8_t> requestedProfile;
+        std::atomic<bool> isCalibrationRequested;
+        SensorProfileCalibration calibrations[SENSOR_PROFILES_COUNT];
+        KalmanFilter<float> temperatureFilter;
+
+        std::atomic<uint32_t> sequence;
+        SensorSnapshot snapshot;
+
+        static void taskFunction(void* param);
+        static void measurementReadyCallback(void* context);
+        bool hasPendingRequests();
+        void run();
+        void applyProfile(uint8_t profile);
+        void configureTemperatureFilter(uint8_t profile);
+        bool measure(Bme280Reading& reading);
+        void sample();
+        void calibrate();
+        void publish(const Bme280Reading& reading, unsigned long timestampMillis);
+
+    public:
+        SensorSampler(Bme280Sensor& bme, MemoryValue* sensorProfileMemory);
+        void initialize(uint32_t stackSize);
+        bool setProfile(int profile);
+        SensorProfile getProfile();
+        void requestCalibration();
+        SensorProfileCalibration getCalibration(uint8_t profile);
+        void restoreCalibration(uint8_t profile, const SensorProfileCalibration& calibration);
+        SensorSnapshot getSnapshot();
+        bool waitForFirstSample(TickType_t timeoutTicks);
+        TaskHandle_t getTaskHandle();
+};
+
+#endif
\ No newline at end of file
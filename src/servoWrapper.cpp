@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <ESP32Servo.h>
 #include <servoWrapper.h>
+#include <config.h>
 
 const uint8_t moveSpeedDelay = 5; // miliseconds
 
@@ -9,9 +10,33 @@ ServoWrapper::ServoWrapper(byte servoGpio, Servo& servo, MemoryValue& minMemoryV
     this->servoGpio = servoGpio;
     this->min = 0;
     this->max = 180;
+    this->commandedMicrosecondsFixed = translateDegreesToMicroseconds(90) * (1 << COMMANDED_POSITION_FRACTION_BITS);
+    this->previousMicrosecondsFixed = this->commandedMicrosecondsFixed;
+    this->commandedAtMillis = 0;
 };
 
 void ServoWrapper::initialize(int timerNumber) {
+    this->attach(timerNumber);
+
+    uint8_t middlePosition = abs(this->max - this->min) / 2;
+    this->moveTo(middlePosition);
+}
+
+/**
+ * After deep sleep servo is still where it was left, it is neither moved nor powered
+ */
+void ServoWrapper::initialize(int timerNumber, uint8_t resumedPosition) {
+    this->attach(timerNumber);
+
+    float positionMicroseconds = translateFrom100ToMicroseconds(resumedPosition);
+    servo.writeMicroseconds(round(positionMicroseconds));
+
+    this->commandedMicrosecondsFixed = lroundf(positionMicroseconds * (1 << COMMANDED_POSITION_FRACTION_BITS));
+    this->previousMicrosecondsFixed = this->commandedMicrosecondsFixed;
+    this->commandedAtMillis = millis();
+}
+
+void ServoWrapper::attach(int timerNumber) {
     ESP32PWM::allocateTimer(timerNumber);
     servo.setPeriodHertz(50);
     servo.attach(servoGpio);
@@ -25,9 +50,6 @@ void ServoWrapper::initialize(int timerNumber) {
         uint8_t maxValue = maxMemoryValue.readValue();
         this->setMax(maxValue);
     }
-
-    uint8_t middlePosition = abs(this->max - this->min) / 2;
-    this->moveTo(middlePosition);
 }
 
 void ServoWrapper::setMin(uint8_t newMin) {
@@ -43,23 +65,23 @@ void ServoWrapper::setMax(uint8_t newMax) {
 }
 
 void ServoWrapper::write(uint8_t newPositionDegrees) {
-    this->servosPowerSupply.turnOn();
+    this->command(translateDegreesToMicroseconds(newPositionDegrees));
+}
 
-    servo.write(newPositionDegrees);
-    
-    this->servosPowerSupply.turnOffDelayed();
+void ServoWrapper::writeMicroseconds(uint16_t newPositionMicroseconds) {
+    this->command(newPositionMicroseconds);
 }
 
-uint8_t ServoWrapper::readFromServo() {
-    int value = servo.read();
+void ServoWrapper::command(float positionMicroseconds) {
+    this->servosPowerSupply.turnOn();
 
-    if (value < 0) {
-        return 0;
-    } else if (value > 180) {
-        return 180;
-    }
+    servo.writeMicroseconds(round(positionMicroseconds));
+
+    this->servosPowerSupply.turnOffDelayed();
 
-    return value;
+    this->previousMicrosecondsFixed = this->getEstimatedMicroseconds() * (1 << COMMANDED_POSITION_FRACTION_BITS);
+    this->commandedMicrosecondsFixed = lroundf(positionMicroseconds * (1 << COMMANDED_POSITION_FRACTION_BITS));
+    this->commandedAtMillis = millis();
 }
 
 /**
@@ -72,30 +94,40 @@ void ServoWrapper::moveTo(uint8_t newPosition) {
 }
 
 void ServoWrapper::moveSmoothly() {
-    if (this->movingSmoothlyCurrentPosition == this->movingSmoothlyTarget) {
-        this->isMovingSmoothly = false;
+    long elapsedMiliseconds = (long) (millis() - this->movingSmoothlyStartMillis);
+
+    // Delayed start
+    if (elapsedMiliseconds < 0) {
         return;
     }
 
-    if (this->movingSmoothlyCurrentPosition > this->movingSmoothlyTarget) {
-        this->movingSmoothlyCurrentPosition--;
-    } else {
-        this->movingSmoothlyCurrentPosition++;
-    }
+    this->command(this->motionProfile.positionAt(elapsedMiliseconds));
 
-    this->moveTo(this->movingSmoothlyCurrentPosition);
+    if ((unsigned long) elapsedMiliseconds >= this->motionProfile.getDurationMiliseconds()) {
+        this->isMovingSmoothly = false;
+    }
 }
 
-void ServoWrapper::setMovingSmoothlyTarget(uint8_t newPosition) {
-    uint8_t currentPosition = getCurrentPosition();
-
-    this->movingSmoothlyTarget = newPosition;
-    this->movingSmoothlyCurrentPosition = currentPosition;
+/**
+ * Plans whole trajectory once, moveSmoothly() only evaluates it
+ */
+void ServoWrapper::setMovingSmoothlyTarget(uint8_t newPosition, uint16_t startDelayMiliseconds) {
+    float currentPositionMicroseconds = this->getCommandedMicroseconds();
+    float targetPositionMicroseconds = translateFrom100ToMicroseconds(newPosition);
 
-    if (this->movingSmoothlyTarget == this->movingSmoothlyCurrentPosition) {
+    if (round(currentPositionMicroseconds) == round(targetPositionMicroseconds)) {
+        this->isMovingSmoothly = false;
         return;
     }
 
+    // Limits are given in % of calibrated range
+    float rangeMicroseconds = abs(translateFrom100ToMicroseconds(100) - translateFrom100ToMicroseconds(0));
+    float maxVelocity = rangeMicroseconds * MOVE_SMOOTHLY_MAX_VELOCITY / 100;
+    float maxAcceleration = rangeMicroseconds * MOVE_SMOOTHLY_MAX_ACCELERATION / 100;
+
+    this->motionProfile.plan(currentPositionMicroseconds, targetPositionMicroseconds, maxVelocity, maxAcceleration, MOVE_SMOOTHLY_PROFILE_SHAPE);
+    this->movingSmoothlyStartMillis = millis() + startDelayMiliseconds;
+
     this->isMovingSmoothly = true;
 }
 
@@ -112,45 +144,79 @@ uint8_t ServoWrapper::translateFrom100ToDegrees(uint8_t position) {
     }
 }
 
-uint8_t ServoWrapper::translateFromDegreesTo100(uint8_t positionInDegrees) {
+/**
+ * Sub-degree resolution, same mapping as ESP32Servo uses for degrees
+ */
+float ServoWrapper::translateFrom100ToMicroseconds(float position) {
+    float degrees = min + ((float) max - min) * position / 100;
+
+    return translateDegreesToMicroseconds(degrees);
+}
+
+float ServoWrapper::translateDegreesToMicroseconds(float positionDegrees) {
+    return DEFAULT_uS_LOW + positionDegrees * (DEFAULT_uS_HIGH - DEFAULT_uS_LOW) / 180;
+}
+
+float ServoWrapper::translateMicrosecondsTo100(float positionMicroseconds) {
     // Should not happen
     if (min == max) {
         return 100;
     }
 
-    uint8_t distance;
-    uint8_t positionDiff;
+    float minMicroseconds = translateDegreesToMicroseconds(min);
+    float maxMicroseconds = translateDegreesToMicroseconds(max);
 
-    if (max > min) {
-        if (positionInDegrees < min) {
-            positionInDegrees = min;
-        }
+    float position = (positionMicroseconds - minMicroseconds) * 100 / (maxMicroseconds - minMicroseconds);
+
+    if (position < 0) {
+        return 0;
+    } else if (position > 100) {
+        return 100;
+    }
 
-        if (positionInDegrees > max) {
-            positionInDegrees = max;
-        }
+    return position;
+}
 
-        distance = max - min;
-        positionDiff = positionInDegrees - min;
-    } else {
-        if (positionInDegrees > min) {
-            positionInDegrees = min;
-        }
+float ServoWrapper::getCommandedMicroseconds() {
+    return (float) this->commandedMicrosecondsFixed / (1 << COMMANDED_POSITION_FRACTION_BITS);
+}
 
-        if (positionInDegrees < max) {
-            positionInDegrees = max;
-        }
+/**
+ * Profiled move: servo follows the profile with response lag
+ * Direct write: servo slews from previous estimated position with nominal speed
+ */
+float ServoWrapper::getEstimatedMicroseconds() {
+    if (this->isMovingSmoothly) {
+        long elapsedMiliseconds = (long) (millis() - this->movingSmoothlyStartMillis) - SERVO_RESPONSE_LAG_MILISECONDS;
 
-        distance = min - max;
-        positionDiff = min - positionInDegrees;
+        return this->motionProfile.positionAt(elapsedMiliseconds > 0 ? elapsedMiliseconds : 0);
     }
 
-    return positionDiff * 100 / distance;
+    float commandedMicroseconds = this->getCommandedMicroseconds();
+    float previousMicroseconds = (float) this->previousMicrosecondsFixed / (1 << COMMANDED_POSITION_FRACTION_BITS);
+
+    float nominalSpeedMicroseconds = translateDegreesToMicroseconds(SERVO_NOMINAL_SPEED_DEGREES_PER_SECOND) - DEFAULT_uS_LOW;
+    float maxTravelMicroseconds = nominalSpeedMicroseconds * (millis() - this->commandedAtMillis) / 1000;
+
+    if (fabsf(commandedMicroseconds - previousMicroseconds) <= maxTravelMicroseconds) {
+        return commandedMicroseconds;
+    }
+
+    return previousMicroseconds + (commandedMicroseconds > previousMicroseconds ? maxTravelMicroseconds : -maxTravelMicroseconds);
 }
 
 uint8_t ServoWrapper::getCurrentPosition() {
-    uint8_t currentPositionInDegrees = readFromServo();
-    uint8_t currentPosition = translateFromDegreesTo100(currentPositionInDegrees);
+    return round(translateMicrosecondsTo100(this->getCommandedMicroseconds()));
+}
+
+float ServoWrapper::getEstimatedPosition() {
+    return translateMicrosecondsTo100(this->getEstimatedMicroseconds());
+}
+
+uint8_t ServoWrapper::getTargetPosition() {
+    if (this->isMovingSmoothly) {
+        return round(translateMicrosecondsTo100(this->motionProfile.getTargetPosition()));
+    }
 
-    return currentPosition;
+    return this->getCurrentPosition();
 }
\ No newline at end of file
@@ -5,6 +5,12 @@
 #include <ESP32Servo.h>
 #include <memoryValue.h>
 #include <servosPowerSupply.h>
+#include <motionProfile.h>
+
+const uint8_t COMMANDED_POSITION_FRACTION_BITS = 8; // Commanded microseconds stored as Q.8 fixed point
+const uint16_t SERVO_RESPONSE_LAG_MILISECONDS = 60; // Servo follows commanded trajectory with this delay
+const float SERVO_NOMINAL_SPEED_DEGREES_PER_SECOND = 300; // Unloaded speed for direct (not profiled) writes
+
 class ServoWrapper {
     private:
         byte servoGpio;
@@ -12,11 +18,21 @@ class ServoWrapper {
         MemoryValue& minMemoryValue;
         MemoryValue& maxMemoryValue;
         ServosPowerSupply& servosPowerSupply;
-        uint8_t readFromServo();
         uint8_t translateFrom100ToDegrees(uint8_t position);
-        uint8_t translateFromDegreesTo100(uint8_t position);
-        uint8_t movingSmoothlyTarget;
-        uint8_t movingSmoothlyCurrentPosition;
+        float translateFrom100ToMicroseconds(float position);
+        float translateMicrosecondsTo100(float positionMicroseconds);
+        float translateDegreesToMicroseconds(float positionDegrees);
+        MotionProfile motionProfile; // Planned once per move (in microseconds)
+        unsigned long movingSmoothlyStartMillis;
+        void attach(int timerNumber);
+
+        // Commanded position is tracked instead of reading PWM duty back from Servo
+        int32_t commandedMicrosecondsFixed;
+        int32_t previousMicrosecondsFixed; // Estimated position when last command was issued
+        unsigned long commandedAtMillis;
+        void command(float positionMicroseconds);
+        float getCommandedMicroseconds();
+        float getEstimatedMicroseconds();
 
     public:
         bool isMovingSmoothly = false;
@@ -25,13 +41,17 @@ class ServoWrapper {
 
         ServoWrapper(byte servoGpio, Servo& servo, MemoryValue& minMemoryValue, MemoryValue& maxMemoryValue, ServosPowerSupply& servosPowerSupply);
         void initialize(int timerNumber);
+        void initialize(int timerNumber, uint8_t resumedPosition); // 0 - 100, fast resume after deep sleep
         void setMin(uint8_t newMin);
         void setMax(uint8_t newMax);
         void write(uint8_t newPositionDegrees); // Degrees 0 - 180
+        void writeMicroseconds(uint16_t newPositionMicroseconds);
         void moveTo(uint8_t newPosition); // 0 - 100
         void moveSmoothly();
-        void setMovingSmoothlyTarget(uint8_t newPosition); // 0 - 100
-        uint8_t getCurrentPosition(); // 0-100
+        void setMovingSmoothlyTarget(uint8_t newPosition, uint16_t startDelayMiliseconds = 0); // 0 - 100
+        uint8_t getCurrentPosition(); // 0-100 (commanded)
+        float getEstimatedPosition(); // 0-100 (where servo physically is expected to be)
+        uint8_t getTargetPosition(); // 0-100 (end of current move)
 
 };
 
@@ -1,4 +1,5 @@
 #include "servosPowerSupply.h"
+#include "config.h"
 
 const int POWER_ON = LOW;
 const int POWER_OFF = HIGH;
@@ -6,45 +7,241 @@ const int POWER_OFF = HIGH;
 ServosPowerSupply::ServosPowerSupply(byte servosPowerSupplyGpio) {
     this->servosPowerSupplyGpio = servosPowerSupplyGpio;
     this->currentState = POWER_OFF;
-    this->targetState = POWER_OFF;
-    this->turningOffCommandTime = 0;
+    this->poweredOnMillis = 0;
+    this->poweredOffMillis = 0;
+    this->moveStartMillis = 0;
+    this->isMoveActive = false;
+    this->statistics = ServosPowerStatistics{};
+
+#ifdef ESP_PLATFORM
+    this->mux = portMUX_INITIALIZER_UNLOCKED;
+    this->holdTimer = nullptr;
+#endif
 }
 
 void ServosPowerSupply::initialize() {
     pinMode(servosPowerSupplyGpio, OUTPUT);
     digitalWrite(servosPowerSupplyGpio, this->currentState);
+
+#ifdef ESP_PLATFORM
+    // Level could be still held after deep sleep
+    gpio_hold_dis((gpio_num_t) this->servosPowerSupplyGpio);
+
+    // One-shot, power is dropped from timer service task (no loop polling)
+    this->holdTimer = xTimerCreate("ServosPowerHoldTimer", pdMS_TO_TICKS(SERVO_POWER_SUPPLY_DELAY), pdFALSE, this, ServosPowerSupply::holdTimerCallback);
+#endif
 }
 
-void ServosPowerSupply::turnOn() {
-    if (this->currentState == POWER_OFF) {
+#ifdef ESP_PLATFORM
+void ServosPowerSupply::holdTimerCallback(TimerHandle_t timer) {
+    static_cast<ServosPowerSupply*>(pvTimerGetTimerID(timer))->handleHoldTimeout();
+}
+#endif
+
+void ServosPowerSupply::lock() {
+#ifdef ESP_PLATFORM
+    portENTER_CRITICAL(&this->mux);
+#endif
+}
+
+void ServosPowerSupply::unlock() {
+#ifdef ESP_PLATFORM
+    portEXIT_CRITICAL(&this->mux);
+#endif
+}
+
+void ServosPowerSupply::armHoldTimer() {
+#ifdef ESP_PLATFORM
+    if (this->holdTimer != nullptr) {
+        xTimerReset(this->holdTimer, 0);
+    }
+#endif
+}
+
+void ServosPowerSupply::disarmHoldTimer() {
+#ifdef ESP_PLATFORM
+    if (this->holdTimer != nullptr) {
+        xTimerStop(this->holdTimer, 0);
+    }
+#endif
+}
+
+/**
+ * Powers up once per planned move, returns remaining settle time
+ * Move is marked active under the same lock hold timeout checks it, so already running timeout can't drop power afterwards
+ */
+uint16_t ServosPowerSupply::beginMove() {
+    this->lock();
+    if (!this->isMoveActive) {
+        this->isMoveActive = true;
+        this->moveStartMillis = millis();
+    }
+
+    bool isSwitchedOn = this->switchOn();
+    unsigned long poweredOnFor = millis() - this->poweredOnMillis;
+    this->unlock();
+
+    this->disarmHoldTimer();
+
+    if (isSwitchedOn) {
         Serial.println("Turning ON servos power supply");
     }
 
-    this->targetState = POWER_ON;
+    if (poweredOnFor >= SERVO_POWER_SUPPLY_SETTLE_DELAY) {
+        return 0;
+    }
+
+    return SERVO_POWER_SUPPLY_SETTLE_DELAY - poweredOnFor;
+}
+
+void ServosPowerSupply::endMove() {
+    this->lock();
+    bool wasMoveActive = this->isMoveActive;
+    ServosPowerStatistics statistics = this->statistics;
+
+    if (wasMoveActive) {
+        this->isMoveActive = false;
+
+        uint32_t moveOnTime = millis() - this->moveStartMillis;
+
+        this->statistics.movesCount++;
+        this->statistics.lastMoveOnTimeMiliseconds = moveOnTime;
+        this->statistics.lastMoveEnergyJoules = this->estimateEnergyJoules(moveOnTime);
+        statistics = this->statistics;
+    }
+    this->unlock();
+
+    if (wasMoveActive) {
+        Serial.print("Servos move finished, on time [ms]: ");
+        Serial.print(statistics.lastMoveOnTimeMiliseconds);
+        Serial.print(", energy [J]: ");
+        Serial.println(statistics.lastMoveEnergyJoules);
+    }
+
+    this->armHoldTimer();
+}
+
+bool ServosPowerSupply::switchOn() {
+    if (this->currentState != POWER_OFF) {
+        return false;
+    }
+
+    this->poweredOnMillis = millis();
     this->currentState = POWER_ON;
     digitalWrite(servosPowerSupplyGpio, this->currentState);
+
+    return true;
 }
 
-void ServosPowerSupply::turnOff() {
-    Serial.println("Turning OFF servos power supply");
+void ServosPowerSupply::switchOff() {
+    uint32_t onTime = millis() - this->poweredOnMillis;
 
+    this->statistics.totalOnTimeMiliseconds += onTime;
+    this->statistics.totalEnergyJoules += this->estimateEnergyJoules(onTime);
+
+    this->poweredOffMillis = millis();
     this->currentState = POWER_OFF;
     digitalWrite(servosPowerSupplyGpio, this->currentState);
 }
 
-void ServosPowerSupply::turnOffDelayed() {
-    this->targetState = POWER_OFF;
-    this->turningOffCommandTime = millis();
+void ServosPowerSupply::turnOn() {
+    this->lock();
+    bool isSwitchedOn = this->switchOn();
+    this->unlock();
+
+    if (isSwitchedOn) {
+        Serial.println("Turning ON servos power supply");
+    }
 }
 
-void ServosPowerSupply::checkTargetState() {
-    if (this->currentState == this->targetState) {
+void ServosPowerSupply::turnOffDelayed() {
+    this->lock();
+    bool isMoveActive = this->isMoveActive;
+    this->unlock();
+
+    // Planned move keeps power until it ends
+    if (isMoveActive) {
         return;
     }
 
-    if (this->targetState == POWER_OFF) {
-        if (millis() - this->turningOffCommandTime > SERVO_POWER_SUPPLY_DELAY) {
-            this->turnOff();
-        }
+    this->armHoldTimer();
+}
+
+/**
+ * Called by one-shot hold timer, move could have started on the other core since timer fired
+ */
+void ServosPowerSupply::handleHoldTimeout() {
+    this->lock();
+    bool isTurningOff = !this->isMoveActive && this->currentState == POWER_ON;
+
+    if (isTurningOff) {
+        this->switchOff();
+    }
+    this->unlock();
+
+    if (isTurningOff) {
+        Serial.println("Turning OFF servos power supply");
+    }
+}
+
+/**
+ * Pads float in deep sleep, power supply stays off only while its level is held
+ */
+void ServosPowerSupply::holdOffDuringDeepSleep() {
+    this->disarmHoldTimer();
+
+    this->lock();
+    bool isTurningOff = this->currentState == POWER_ON;
+
+    if (isTurningOff) {
+        this->switchOff();
     }
+    this->unlock();
+
+    if (isTurningOff) {
+        Serial.println("Turning OFF servos power supply");
+    }
+
+#ifdef ESP_PLATFORM
+    gpio_hold_en((gpio_num_t) this->servosPowerSupplyGpio);
+    gpio_deep_sleep_hold_en();
+#endif
+}
+
+bool ServosPowerSupply::isPoweredOn() {
+    this->lock();
+    bool isPoweredOn = this->currentState == POWER_ON;
+    this->unlock();
+
+    return isPoweredOn;
+}
+
+/**
+ * Battery voltage recovers for a while after load is released
+ */
+unsigned long ServosPowerSupply::getMilisecondsSincePowerOff() {
+    this->lock();
+    bool isPoweredOn = this->currentState == POWER_ON;
+    unsigned long poweredOffMillis = this->poweredOffMillis;
+    this->unlock();
+
+    if (isPoweredOn) {
+        return 0;
+    }
+
+    return millis() - poweredOffMillis;
+}
+
+float ServosPowerSupply::estimateEnergyJoules(uint32_t onTimeMiliseconds) {
+    float voltage = lastReadBatteryVoltageServos > 0 ? lastReadBatteryVoltageServos : BATTERY_VOLTAGE_100_REFERENCE;
+
+    return voltage * SERVOS_ESTIMATED_CURRENT_MILIAMPERES / 1000.0f * onTimeMiliseconds / 1000.0f;
+}
+
+ServosPowerStatistics ServosPowerSupply::getStatistics() {
+    this->lock();
+    ServosPowerStatistics statistics = this->statistics;
+    this->unlock();
+
+    return statistics;
 }
\ No newline at end of file
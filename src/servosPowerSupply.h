@@ -3,23 +3,68 @@
 
 #include <Arduino.h>
 
-const uint16_t SERVO_POWER_SUPPLY_DELAY = 2000;
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+#include <driver/gpio.h>
+#endif
 
+const uint16_t SERVO_POWER_SUPPLY_DELAY = 2000; // Idle hold before power is dropped
+const uint16_t SERVO_POWER_SUPPLY_SETTLE_DELAY = 100; // After powering up, before first pulse of a planned move
+const uint16_t SERVOS_ESTIMATED_CURRENT_MILIAMPERES = 500; // Both servos, used for energy estimate
+
+struct ServosPowerStatistics {
+    uint32_t movesCount;
+    uint32_t totalOnTimeMiliseconds;
+    float totalEnergyJoules;
+    uint32_t lastMoveOnTimeMiliseconds;
+    float lastMoveEnergyJoules;
+};
+
+/**
+ * Used from loop task (direct writes), motion executor task (planned moves) and timer service task (hold timeout)
+ * State, move flag and statistics are guarded by one mux, logging and timer commands happen outside of it
+ */
 class ServosPowerSupply {
     private:
         byte servosPowerSupplyGpio;
-        byte targetState;
-        void turnOff();
-        void setState(byte state);
-        unsigned long turningOffCommandTime;
+        byte currentState;
+        bool switchOn(); // Mux has to be held, returns true when power was off
+        void switchOff(); // Mux has to be held
+        void armHoldTimer();
+        void disarmHoldTimer();
+        void lock();
+        void unlock();
+        float estimateEnergyJoules(uint32_t onTimeMiliseconds);
+        unsigned long poweredOnMillis;
+        unsigned long poweredOffMillis;
+        unsigned long moveStartMillis;
+        bool isMoveActive;
+        ServosPowerStatistics statistics;
+
+#ifdef ESP_PLATFORM
+        portMUX_TYPE mux;
+        TimerHandle_t holdTimer;
+        static void holdTimerCallback(TimerHandle_t timer);
+#endif
 
     public:
-        byte currentState;
         ServosPowerSupply(byte servoGpio);
         void initialize();
+
+        // Planned moves
+        uint16_t beginMove(); // Returns how long to wait before first pulse (settle time)
+        void endMove();
+
+        // Direct writes (manual control)
         void turnOn();
         void turnOffDelayed();
-        void checkTargetState();
+
+        void handleHoldTimeout();
+        void holdOffDuringDeepSleep();
+        bool isPoweredOn();
+        unsigned long getMilisecondsSincePowerOff(); // 0 while powered on
+        ServosPowerStatistics getStatistics();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,230 @@
+#ifndef SIGNAL_FILTERS_H
+#define SIGNAL_FILTERS_H
+
+#include <Arduino.h>
+#include <type_traits>
+
+/**
+ * Allocation-free filters, each instance owns state of exactly one signal
+ * All of them have update(sample) returning filtered value and reset(),
+ * first sample after reset passes through and seeds the state
+ * Filters can be chained in FilterPipeline
+ */
+
+template <typename T>
+inline T castFilterValue(float value) {
+    return std::is_integral<T>::value ? (T) roundf(value) : (T) value;
+}
+
+template <typename T>
+inline T absoluteDifference(T first, T second) {
+    return first > second ? first - second : second - first;
+}
+
+/**
+ * Exponential moving average, alpha 0 - 1 (1 passes samples through)
+ */
+template <typename T>
+class EmaFilter {
+    private:
+        float alpha;
+        float value;
+        bool isInitialized;
+
+    public:
+        EmaFilter(float alpha): alpha(alpha), value(0), isInitialized(false) {}
+
+        T update(T sample) {
+            if (!this->isInitialized) {
+                this->value = sample;
+                this->isInitialized = true;
+            } else {
+                this->value += this->alpha * ((float) sample - this->value);
+            }
+
+            return castFilterValue<T>(this->value);
+        }
+
+        void reset() {
+            this->isInitialized = false;
+        }
+};
+
+/**
+ * Median of last N samples, removes single spikes without smearing them
+ */
+template <typename T, uint8_t N>
+class MedianFilter {
+    static_assert(N % 2 == 1, "Median window has to be odd");
+
+    private:
+        T samples[N];
+        uint8_t samplesCount;
+        uint8_t nextIndex;
+
+    public:
+        MedianFilter(): samplesCount(0), nextIndex(0) {}
+
+        T update(T sample) {
+            this->samples[this->nextIndex] = sample;
+            this->nextIndex = (this->nextIndex + 1) % N;
+
+            if (this->samplesCount < N) {
+                this->samplesCount++;
+            }
+
+            // Insertion sort of a copy, N is small
+            T sorted[N];
+
+            for (uint8_t i = 0; i < this->samplesCount; i++) {
+                T value = this->samples[i];
+                int8_t j = i - 1;
+
+                while (j >= 0 && sorted[j] > value) {
+                    sorted[j + 1] = sorted[j];
+                    j--;
+                }
+
+                sorted[j + 1] = value;
+            }
+
+            return sorted[this->samplesCount / 2];
+        }
+
+        void reset() {
+            this->samplesCount = 0;
+            this->nextIndex = 0;
+        }
+};
+
+/**
+ * Output follows input only when it moves further than threshold (dead band)
+ * With rails, samples within half of threshold from a rail snap to it (dead band alone would stop output short of the rail)
+ */
+template <typename T>
+class HysteresisFilter {
+    private:
+        T threshold;
+        T output;
+        bool isInitialized;
+        bool hasRails;
+        T minValue;
+        T maxValue;
+
+    public:
+        HysteresisFilter(T threshold): threshold(threshold), output(0), isInitialized(false), hasRails(false), minValue(0), maxValue(0) {}
+        HysteresisFilter(T threshold, T minValue, T maxValue): threshold(threshold), output(0), isInitialized(false), hasRails(true), minValue(minValue), maxValue(maxValue) {}
+
+        T update(T sample) {
+            bool isOnRail = false;
+
+            if (this->hasRails && sample <= this->minValue + this->threshold / 2) {
+                sample = this->minValue;
+                isOnRail = true;
+            } else if (this->hasRails && sample >= this->maxValue - this->threshold / 2) {
+                sample = this->maxValue;
+                isOnRail = true;
+            }
+
+            if (!this->isInitialized || isOnRail || absoluteDifference(sample, this->output) > this->threshold) {
+                this->output = sample;
+                this->isInitialized = true;
+            }
+
+            return this->output;
+        }
+
+        void reset() {
+            this->isInitialized = false;
+        }
+};
+
+/**
+ * Scalar Kalman filter for slowly drifting value (random walk model)
+ * Noises are variances: process noise per update, measurement noise of single sample
+ */
+template <typename T>
+class KalmanFilter {
+    private:
+        float processNoise;
+        float measurementNoise;
+        float estimate;
+        float errorCovariance;
+        bool isInitialized;
+
+    public:
+        KalmanFilter(float processNoise, float measurementNoise): processNoise(processNoise), measurementNoise(measurementNoise), estimate(0), errorCovariance(0), isInitialized(false) {}
+
+        T update(T sample) {
+            if (!this->isInitialized) {
+                this->estimate = sample;
+                this->errorCovariance = this->measurementNoise;
+                this->isInitialized = true;
+
+                return sample;
+            }
+
+            this->errorCovariance += this->processNoise;
+
+            float gain = this->errorCovariance / (this->errorCovariance + this->measurementNoise);
+
+            this->estimate += gain * ((float) sample - this->estimate);
+            this->errorCovariance *= 1 - gain;
+
+            return castFilterValue<T>(this->estimate);
+        }
+
+        void reset() {
+            this->isInitialized = false;
+        }
+
+        void setProcessNoise(float processNoise) {
+            this->processNoise = processNoise;
+        }
+
+        void setMeasurementNoise(float measurementNoise) {
+            this->measurementNoise = measurementNoise;
+        }
+
+        float getErrorCovariance() {
+            return this->errorCovariance;
+        }
+};
+
+/**
+ * Stages are applied in order, all of them filter values of type T
+ * Whole pipeline is a value type, no virtual calls nor heap
+ */
+template <typename T, typename... Stages>
+class FilterPipeline;
+
+template <typename T>
+class FilterPipeline<T> {
+    public:
+        T update(T sample) {
+            return sample;
+        }
+
+        void reset() {}
+};
+
+template <typename T, typename First, typename... Rest>
+class FilterPipeline<T, First, Rest...> {
+    private:
+        First first;
+        FilterPipeline<T, Rest...> rest;
+
+    public:
+        FilterPipeline(First first, Rest... rest): first(first), rest(rest...) {}
+
+        T update(T sample) {
+            return this->rest.update(this->first.update(sample));
+        }
+
+        void reset() {
+            this->first.reset();
+            this->rest.reset();
+        }
+};
+
+#endif
\ No newline at end of file
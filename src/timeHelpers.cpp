@@ -17,22 +17,38 @@ long int getSecondsFromDateString(String date) {
 }
 
 String getCurrentTime() {
-    char buffer[128];
+    char buffer[DATE_STRING_LENGTH];
+
+    if (!formatCurrentTime(buffer, sizeof(buffer))) {
+        return "";
+    }
+
+    return String(buffer);
+}
+
+bool formatCurrentTime(char* buffer, size_t size) {
     struct tm currentTime;
 
     if (!getLocalTime(&currentTime)) {
         Serial.println("Failed to obtain current time");
-        return "";
+        return false;
     }
 
     if (currentTime.tm_year < 70) { 
         Serial.println("Invalid time data");
-        return "";
+        return false;
     }
 
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &currentTime);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &currentTime);
 
-    return String(buffer);
+    return true;
+}
+
+void formatDate(time_t seconds, char* buffer, size_t size) {
+    struct tm localTime;
+
+    localtime_r(&seconds, &localTime);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &localTime);
 }
 
 /**
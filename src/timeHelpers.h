@@ -4,7 +4,11 @@
 #include <Arduino.h>
 #include <time.h>
 
+const size_t DATE_STRING_LENGTH = 20; // "YYYY-MM-DD HH:MM:SS" with terminator
+
 String getCurrentTime();
+bool formatCurrentTime(char* buffer, size_t size); // Same as getCurrentTime() without heap, false if time is not set
+void formatDate(time_t seconds, char* buffer, size_t size); // Same format as getCurrentTime()
 long int getSecondsFromDateString(String date);
 float calculateHoursAhead(String dateToCompare); //From current time
 
@@ -0,0 +1,132 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <adcDecimator.h>
+
+const uint8_t POTENTIOMETER_CHANNEL = 6; // GPIO 34
+const uint8_t BOX_CHANNEL = 4; // GPIO 32
+const uint16_t OVERSAMPLING_FACTOR = 256;
+
+void setUp() {
+    srand(1);
+}
+
+void tearDown() {}
+
+/**
+ * Uniform noise in range +- amplitude
+ */
+int16_t noise(int16_t amplitude) {
+    return rand() % (2 * amplitude + 1) - amplitude;
+}
+
+void appendWord(uint8_t* buffer, uint32_t& length, uint8_t adcChannel, uint16_t rawValue) {
+    uint16_t word = (adcChannel << 12) | (rawValue & 0x0FFF);
+
+    buffer[length++] = word & 0xFF;
+    buffer[length++] = word >> 8;
+}
+
+void test_gpioToAdc1Channel() {
+    TEST_ASSERT_EQUAL(6, getAdc1Channel(34));
+    TEST_ASSERT_EQUAL(4, getAdc1Channel(32));
+    TEST_ASSERT_EQUAL(5, getAdc1Channel(33));
+    TEST_ASSERT_EQUAL(0, getAdc1Channel(36));
+    TEST_ASSERT_EQUAL(-1, getAdc1Channel(25)); // ADC2, unusable with WiFi
+}
+
+void test_noOutputBeforeFullWindow() {
+    AdcDecimator decimator(OVERSAMPLING_FACTOR);
+    decimator.addChannel(POTENTIOMETER_CHANNEL);
+
+    for (uint16_t i = 0; i < OVERSAMPLING_FACTOR - 1; i++) {
+        decimator.addSample(POTENTIOMETER_CHANNEL, 1000);
+    }
+
+    TEST_ASSERT_EQUAL(0, decimator.getOutputsCount(0));
+
+    decimator.addSample(POTENTIOMETER_CHANNEL, 1000);
+
+    TEST_ASSERT_EQUAL(1, decimator.getOutputsCount(0));
+    TEST_ASSERT_EQUAL(1000, decimator.getOutput(0));
+}
+
+void test_noisyTraceIsSmoothed() {
+    const uint16_t SIGNAL = 2048;
+    const int16_t NOISE_AMPLITUDE = 60;
+    const uint8_t OUTPUTS = 50;
+
+    AdcDecimator decimator(OVERSAMPLING_FACTOR);
+    decimator.addChannel(POTENTIOMETER_CHANNEL);
+
+    uint16_t maxRawError = 0;
+    uint16_t maxOutputError = 0;
+
+    for (uint8_t output = 0; output < OUTPUTS; output++) {
+        for (uint16_t i = 0; i < OVERSAMPLING_FACTOR; i++) {
+            uint16_t raw = SIGNAL + noise(NOISE_AMPLITUDE);
+            maxRawError = std::max(maxRawError, (uint16_t) abs(raw - SIGNAL));
+
+            decimator.addSample(POTENTIOMETER_CHANNEL, raw);
+        }
+
+        maxOutputError = std::max(maxOutputError, (uint16_t) abs(decimator.getOutput(0) - SIGNAL));
+    }
+
+    char message[80];
+    sprintf(message, "Max error raw: %d, decimated: %d", maxRawError, maxOutputError);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL(OUTPUTS, decimator.getOutputsCount(0));
+    TEST_ASSERT_LESS_OR_EQUAL(8, maxOutputError);
+    TEST_ASSERT_LESS_THAN(maxRawError / 4, maxOutputError);
+}
+
+void test_interleavedFrameIsSplitByChannel() {
+    uint8_t buffer[1024];
+    uint32_t length = 0;
+
+    AdcDecimator decimator(4);
+    decimator.addChannel(POTENTIOMETER_CHANNEL);
+    decimator.addChannel(BOX_CHANNEL);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        appendWord(buffer, length, POTENTIOMETER_CHANNEL, 100 + i); // 100..103
+        appendWord(buffer, length, BOX_CHANNEL, 3000);
+        appendWord(buffer, length, 7, 4095); // Not registered, ignored
+    }
+
+    decimator.addFrame(buffer, length);
+
+    TEST_ASSERT_EQUAL(1, decimator.getOutputsCount(0));
+    TEST_ASSERT_EQUAL(1, decimator.getOutputsCount(1));
+    TEST_ASSERT_EQUAL(102, decimator.getOutput(0)); // 101.5 rounded
+    TEST_ASSERT_EQUAL(3000, decimator.getOutput(1));
+}
+
+void test_channelsAreLimited() {
+    AdcDecimator decimator(1);
+
+    for (uint8_t i = 0; i < ADC_DECIMATOR_MAX_CHANNELS; i++) {
+        TEST_ASSERT_EQUAL(i, decimator.addChannel(i));
+    }
+
+    TEST_ASSERT_EQUAL(2, decimator.addChannel(2)); // Already added
+    TEST_ASSERT_EQUAL(-1, decimator.addChannel(8));
+    TEST_ASSERT_EQUAL(ADC_DECIMATOR_MAX_CHANNELS, decimator.getChannelsCount());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_gpioToAdc1Channel);
+    RUN_TEST(test_noOutputBeforeFullWindow);
+    RUN_TEST(test_noisyTraceIsSmoothed);
+    RUN_TEST(test_interleavedFrameIsSplitByChannel);
+    RUN_TEST(test_channelsAreLimited);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+
+#include <ArduinoJson.h>
+
+#include <allocationTracker.h>
+#include <bleDiagnostics.h>
+#include <bleResponseQueue.h>
+
+using namespace fakeit;
+
+const void* FIRST_SITE = (const void*) 0x400d1000;
+const void* SECOND_SITE = (const void*) 0x400d2000;
+
+// Too big for stack of test runner
+AllocationTracker tracker;
+
+void setUp() {
+    ArduinoFakeReset();
+
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(unsigned int, int))).AlwaysReturn(0);
+
+    tracker.reset();
+}
+
+void tearDown() {}
+
+void test_allocationAndFree() {
+    tracker.recordAllocation((void*) 0x3ffb0000, 100, FIRST_SITE);
+    tracker.recordAllocation((void*) 0x3ffb0100, 20, FIRST_SITE);
+    tracker.recordFree((void*) 0x3ffb0000);
+
+    AllocationTotals totals = tracker.getTotals();
+
+    TEST_ASSERT_EQUAL(2, totals.allocationsCount);
+    TEST_ASSERT_EQUAL(1, totals.freesCount);
+    TEST_ASSERT_EQUAL(120, totals.allocatedBytes);
+    TEST_ASSERT_EQUAL(20, totals.bytesInFlight);
+    TEST_ASSERT_EQUAL(120, totals.peakBytesInFlight);
+}
+
+void test_unknownAndNullFreesAreIgnored() {
+    tracker.recordFree(nullptr);
+    tracker.recordFree((void*) 0x3ffb0000);
+    tracker.recordAllocation(nullptr, 100, FIRST_SITE);
+
+    AllocationTotals totals = tracker.getTotals();
+
+    TEST_ASSERT_EQUAL(0, totals.allocationsCount);
+    TEST_ASSERT_EQUAL(0, totals.freesCount);
+    TEST_ASSERT_EQUAL(0, totals.bytesInFlight);
+}
+
+void test_perSiteCounters() {
+    tracker.recordAllocation((void*) 0x3ffb0000, 16, FIRST_SITE);
+    tracker.recordAllocation((void*) 0x3ffb0100, 16, FIRST_SITE);
+    tracker.recordAllocation((void*) 0x3ffb0200, 200, SECOND_SITE);
+    tracker.recordFree((void*) 0x3ffb0100);
+
+    AllocationSite sites[4];
+    uint16_t count = tracker.getTopSites(sites, 4);
+
+    TEST_ASSERT_EQUAL(2, count);
+
+    TEST_ASSERT_EQUAL((uintptr_t) SECOND_SITE, sites[0].callSite);
+    TEST_ASSERT_EQUAL(1, sites[0].allocationsCount);
+    TEST_ASSERT_EQUAL(200, sites[0].bytesInFlight);
+
+    TEST_ASSERT_EQUAL((uintptr_t) FIRST_SITE, sites[1].callSite);
+    TEST_ASSERT_EQUAL(2, sites[1].allocationsCount);
+    TEST_ASSERT_EQUAL(32, sites[1].allocatedBytes);
+    TEST_ASSERT_EQUAL(1, sites[1].liveCount);
+    TEST_ASSERT_EQUAL(16, sites[1].bytesInFlight);
+}
+
+void test_reallocationMovesBlock() {
+    tracker.recordAllocation((void*) 0x3ffb0000, 16, FIRST_SITE);
+    tracker.recordReallocation((void*) 0x3ffb0000, (void*) 0x3ffb0400, 64, SECOND_SITE);
+
+    AllocationTotals totals = tracker.getTotals();
+
+    TEST_ASSERT_EQUAL(64, totals.bytesInFlight);
+
+    tracker.recordFree((void*) 0x3ffb0400);
+
+    TEST_ASSERT_EQUAL(0, tracker.getTotals().bytesInFlight);
+}
+
+void test_failedReallocationKeepsBlock() {
+    tracker.recordAllocation((void*) 0x3ffb0000, 16, FIRST_SITE);
+    tracker.recordReallocation((void*) 0x3ffb0000, nullptr, 100000, SECOND_SITE);
+
+    TEST_ASSERT_EQUAL(16, tracker.getTotals().bytesInFlight);
+}
+
+void test_freesAfterCollisionsAreMatched() {
+    // Same slot in live allocations table, removal must keep the rest reachable
+    for (uintptr_t i = 0; i < 32; i++) {
+        tracker.recordAllocation((void*) (0x3ffb0000 + i * 4 * ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS), 10, FIRST_SITE);
+    }
+
+    for (uintptr_t i = 0; i < 32; i += 2) {
+        tracker.recordFree((void*) (0x3ffb0000 + i * 4 * ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS));
+    }
+
+    for (uintptr_t i = 1; i < 32; i += 2) {
+        tracker.recordFree((void*) (0x3ffb0000 + i * 4 * ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS));
+    }
+
+    AllocationTotals totals = tracker.getTotals();
+
+    TEST_ASSERT_EQUAL(32, totals.freesCount);
+    TEST_ASSERT_EQUAL(0, totals.bytesInFlight);
+}
+
+void test_fullLiveAllocationsTable() {
+    // One slot more than the table has, last one is not tracked
+    for (uintptr_t i = 0; i < ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS; i++) {
+        tracker.recordAllocation((void*) (0x3ffb0000 + i * 16), 8, FIRST_SITE);
+    }
+
+    AllocationTotals totals = tracker.getTotals();
+
+    TEST_ASSERT_EQUAL(ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS, totals.allocationsCount);
+    TEST_ASSERT_EQUAL(1, totals.untrackedCount);
+    TEST_ASSERT_EQUAL((ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS - 1) * 8, totals.bytesInFlight);
+
+    for (uintptr_t i = 0; i < ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS; i++) {
+        tracker.recordFree((void*) (0x3ffb0000 + i * 16));
+    }
+
+    totals = tracker.getTotals();
+
+    TEST_ASSERT_EQUAL(ALLOCATION_TRACKER_MAX_LIVE_ALLOCATIONS - 1, totals.freesCount);
+    TEST_ASSERT_EQUAL(0, totals.bytesInFlight);
+
+    // Freed slots are reused
+    tracker.recordAllocation((void*) 0x3ffb0000, 8, FIRST_SITE);
+
+    TEST_ASSERT_EQUAL(1, tracker.getTotals().untrackedCount);
+    TEST_ASSERT_EQUAL(8, tracker.getTotals().bytesInFlight);
+}
+
+void test_sitesOverflow() {
+    for (uintptr_t i = 0; i < ALLOCATION_TRACKER_MAX_SITES + 10; i++) {
+        tracker.recordAllocation((void*) (0x3ffb0000 + i * 16), 8, (void*) (0x400d0000 + i * 4));
+    }
+
+    AllocationSite sites[ALLOCATION_TRACKER_MAX_SITES];
+    uint16_t count = tracker.getTopSites(sites, ALLOCATION_TRACKER_MAX_SITES);
+
+    TEST_ASSERT_EQUAL(ALLOCATION_TRACKER_MAX_SITES, count);
+
+    uint32_t allocationsCount = 0;
+    bool hasOverflowSite = false;
+
+    for (uint16_t i = 0; i < count; i++) {
+        allocationsCount += sites[i].allocationsCount;
+        hasOverflowSite = hasOverflowSite || sites[i].callSite == 0;
+    }
+
+    TEST_ASSERT_EQUAL(ALLOCATION_TRACKER_MAX_SITES + 10, allocationsCount);
+    TEST_ASSERT_TRUE(hasOverflowSite);
+}
+
+void test_fragmentationRatio() {
+    TEST_ASSERT_EQUAL_FLOAT(0, calculateFragmentationRatio(0, 0));
+    TEST_ASSERT_EQUAL_FLOAT(0, calculateFragmentationRatio(1000, 1000));
+    TEST_ASSERT_EQUAL_FLOAT(0.75, calculateFragmentationRatio(1000, 250));
+}
+
+void test_allocationsMessageFitsIntoBleQueue() {
+    // Largest possible numbers everywhere
+    HeapSnapshot heap = HeapSnapshot{ freeHeap: UINT32_MAX, minimumFreeHeap: UINT32_MAX, largestFreeBlock: 12345 };
+    AllocationTotals totals = AllocationTotals{ UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+    AllocationSite sites[ALLOCATIONS_MESSAGE_MAX_SITES];
+
+    for (uint8_t i = 0; i < ALLOCATIONS_MESSAGE_MAX_SITES; i++) {
+        sites[i] = AllocationSite{ callSite: 0x400dffff, allocationsCount: UINT32_MAX, allocatedBytes: UINT32_MAX, liveCount: UINT32_MAX, bytesInFlight: UINT32_MAX };
+    }
+
+    JsonDocument jsonDoc;
+    writeAllocationsMessage(heap, &totals, sites, ALLOCATIONS_MESSAGE_MAX_SITES, jsonDoc);
+
+    TEST_ASSERT_EQUAL(ALLOCATIONS_MESSAGE_MAX_SITES, jsonDoc["sites"].size());
+    TEST_ASSERT_EQUAL_STRING("0x400dffff", jsonDoc["sites"][0][0].as<const char*>());
+    TEST_ASSERT_LESS_THAN(BLE_QUEUE_MESSAGE_MAX_LENGTH, measureJson(jsonDoc));
+
+    String data;
+    serializeJson(jsonDoc, data);
+
+    // Envelope escapes quotes of the response
+    StaticJsonArena<8192> arena;
+    BleResponseQueue queue(arena);
+
+    TEST_ASSERT_TRUE(queue.push("GET_ALLOCATIONS", data.c_str()));
+}
+
+#ifdef ALLOCATION_TRACKING
+void test_hooksRecordNewAndMalloc() {
+    resetAllocationTracking();
+
+    int* value = new int(5);
+    void* buffer = malloc(100);
+
+    AllocationTotals totals = getAllocationTotals();
+
+    TEST_ASSERT_EQUAL(2, totals.allocationsCount);
+    TEST_ASSERT_EQUAL(sizeof(int) + 100, totals.bytesInFlight);
+
+    delete value;
+    free(buffer);
+
+    TEST_ASSERT_EQUAL(0, getAllocationTotals().bytesInFlight);
+}
+#endif
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_allocationAndFree);
+    RUN_TEST(test_unknownAndNullFreesAreIgnored);
+    RUN_TEST(test_perSiteCounters);
+    RUN_TEST(test_reallocationMovesBlock);
+    RUN_TEST(test_failedReallocationKeepsBlock);
+    RUN_TEST(test_freesAfterCollisionsAreMatched);
+    RUN_TEST(test_fullLiveAllocationsTable);
+    RUN_TEST(test_sitesOverflow);
+    RUN_TEST(test_fragmentationRatio);
+    RUN_TEST(test_allocationsMessageFitsIntoBleQueue);
+#ifdef ALLOCATION_TRACKING
+    RUN_TEST(test_hooksRecordNewAndMalloc);
+#endif
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <backendAppLogJson.h>
+#include <chunkedPrint.h>
+#include <allocationTracker.h>
+
+using namespace fakeit;
+
+/**
+ * Collects output in fixed buffer, counts writes reaching it
+ */
+class CapturePrint : public Print {
+    public:
+        char text[2048];
+        size_t length = 0;
+        size_t writesCount = 0;
+
+        size_t write(uint8_t character) override {
+            return this->write(&character, 1);
+        }
+
+        size_t write(const uint8_t* buffer, size_t size) override {
+            memcpy(this->text + this->length, buffer, size);
+            this->length += size;
+            this->text[this->length] = '\0';
+            this->writesCount++;
+
+            return size;
+        }
+};
+
+double outsideTemperature = 12.5;
+double pm25 = 8;
+double pm10 = 21.25;
+double outsideTemperatureTermValue = 1.23456;
+double airPollutionTermValue = -0.987;
+
+BackendAppLog createLog(bool withOptionalValues) {
+    BackendAppLog log{};
+
+    log.windowOpening = 45;
+    log.deltaTemporaryWindowOpening = -12;
+    log.deltaFinalWindowOpening = 0;
+    log.insideTemperature = 22.75;
+    log.config.pm25Norm = 15;
+    log.config.pm10Norm = 45;
+    log.config.optimalTemperature = 22;
+    log.config.oTermNegative = 0.2;
+    log.config.changeDiffThreshold = 20;
+    log.partialData.proportionalTermValue = 18.75;
+    log.partialData.integralTermValue = -3.5;
+
+    if (withOptionalValues) {
+        log.outsideTemperature = &outsideTemperature;
+        log.pm25 = &pm25;
+        log.pm10 = &pm10;
+        log.partialData.outsideTemperatureTermValue = &outsideTemperatureTermValue;
+        log.partialData.airPollutionTermValue = &airPollutionTermValue;
+    }
+
+    return log;
+}
+
+void setUp() {
+    ArduinoFakeReset();
+}
+
+void tearDown() {}
+
+void test_measuredLengthMatchesWrittenOutput() {
+    BackendAppLog log = createLog(true);
+    CapturePrint output;
+
+    size_t writtenLength = writeBackendAppLogJson(output, log);
+
+    TEST_ASSERT_EQUAL(output.length, writtenLength);
+    TEST_ASSERT_EQUAL(writtenLength, measureBackendAppLogJson(log));
+}
+
+void test_outputIsValidJsonWithAllValues() {
+    BackendAppLog log = createLog(true);
+    CapturePrint output;
+
+    writeBackendAppLogJson(output, log);
+
+    JsonDocument doc;
+
+    TEST_ASSERT_FALSE(deserializeJson(doc, output.text));
+    TEST_ASSERT_EQUAL(45, doc["windowOpening"].as<int>());
+    TEST_ASSERT_EQUAL(-12, doc["deltaTemporaryWindowOpening"].as<int>());
+    TEST_ASSERT_EQUAL_FLOAT(22.75, doc["insideTemperature"].as<double>());
+    TEST_ASSERT_EQUAL_FLOAT(21.25, doc["pm10"].as<double>());
+    TEST_ASSERT_EQUAL_FLOAT(0.2, doc["config"]["oTermNegative"].as<double>());
+    TEST_ASSERT_EQUAL_FLOAT(20, doc["config"]["changeDiffThreshold"].as<double>());
+    TEST_ASSERT_EQUAL_FLOAT(-3.5, doc["partialData"]["integralTermValue"].as<double>());
+    TEST_ASSERT_EQUAL_FLOAT(1.23, doc["partialData"]["outsideTemperatureTermValue"].as<double>());
+    TEST_ASSERT_EQUAL_FLOAT(-0.99, doc["partialData"]["airPollutionTermValue"].as<double>());
+    TEST_ASSERT_EQUAL(17, doc["config"].size());
+}
+
+void test_missingOptionalValuesAreOmitted() {
+    BackendAppLog log = createLog(false);
+    CapturePrint output;
+
+    writeBackendAppLogJson(output, log);
+
+    JsonDocument doc;
+
+    TEST_ASSERT_FALSE(deserializeJson(doc, output.text));
+    TEST_ASSERT_FALSE(doc["outsideTemperature"].is<double>());
+    TEST_ASSERT_FALSE(doc["pm25"].is<double>());
+    TEST_ASSERT_FALSE(doc["partialData"]["airPollutionTermValue"].is<double>());
+    TEST_ASSERT_EQUAL(4, doc["partialData"].size());
+}
+
+void test_nonFiniteValuesAreWrittenAsNull() {
+    BackendAppLog log = createLog(false);
+    log.insideTemperature = NAN;
+    CapturePrint output;
+
+    writeBackendAppLogJson(output, log);
+
+    JsonDocument doc;
+
+    TEST_ASSERT_FALSE(deserializeJson(doc, output.text));
+    TEST_ASSERT_TRUE(doc["insideTemperature"].isNull());
+}
+
+void test_chunkedOutputIsSameAndBatched() {
+    BackendAppLog log = createLog(true);
+    CapturePrint direct;
+    CapturePrint chunked;
+    ChunkedPrint<64> chunkedPrint(chunked);
+
+    writeBackendAppLogJson(direct, log);
+    writeBackendAppLogJson(chunkedPrint, log);
+    chunkedPrint.flush();
+
+    TEST_ASSERT_EQUAL_STRING(direct.text, chunked.text);
+    TEST_ASSERT_EQUAL((direct.length + 63) / 64, chunked.writesCount);
+    TEST_ASSERT_FALSE(chunkedPrint.isFailed());
+}
+
+void test_writingDoesNotAllocate() {
+    BackendAppLog log = createLog(true);
+    CapturePrint output;
+    ChunkedPrint<64> chunkedPrint(output);
+
+    AllocationTotals before = getAllocationTotals();
+
+    measureBackendAppLogJson(log);
+    writeBackendAppLogJson(chunkedPrint, log);
+    chunkedPrint.flush();
+
+    AllocationTotals after = getAllocationTotals();
+
+    TEST_ASSERT_EQUAL(before.allocationsCount, after.allocationsCount);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_measuredLengthMatchesWrittenOutput);
+    RUN_TEST(test_outputIsValidJsonWithAllValues);
+    RUN_TEST(test_missingOptionalValuesAreOmitted);
+    RUN_TEST(test_nonFiniteValuesAreWrittenAsNull);
+    RUN_TEST(test_chunkedOutputIsSameAndBatched);
+    RUN_TEST(test_writingDoesNotAllocate);
+
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <cstdlib>
+
+#include <batteryStateOfCharge.h>
+
+const uint32_t SAMPLE_INTERVAL_SECONDS = 5; // Battery meter task period
+
+void setUp() {
+    srand(3);
+}
+
+void tearDown() {}
+
+/**
+ * Voltage for given percentage (inverse lookup), with ADC noise up to +-20 mV
+ */
+float voltageForPercentage(float percentage) {
+    float voltage = BATTERY_DISCHARGE_CURVE[BATTERY_DISCHARGE_CURVE_POINTS_COUNT - 1].voltage;
+
+    for (uint8_t i = 1; i < BATTERY_DISCHARGE_CURVE_POINTS_COUNT; i++) {
+        const DischargeCurvePoint& upper = BATTERY_DISCHARGE_CURVE[i - 1];
+        const DischargeCurvePoint& lower = BATTERY_DISCHARGE_CURVE[i];
+
+        if (percentage >= lower.percentage) {
+            voltage = lower.voltage + (percentage - lower.percentage) * (upper.voltage - lower.voltage) / (upper.percentage - lower.percentage);
+            break;
+        }
+    }
+
+    return voltage + (rand() % 41 - 20) / 1000.0f;
+}
+
+/**
+ * Returns timestamp after last sample
+ */
+uint32_t simulateDischarge(BatteryStateOfCharge& stateOfCharge, uint32_t startSeconds, float startPercentage, float ratePerHour, float hours) {
+    uint32_t samplesCount = hours * 3600 / SAMPLE_INTERVAL_SECONDS;
+    uint32_t timestamp = startSeconds;
+
+    for (uint32_t i = 0; i < samplesCount; i++) {
+        float elapsedHours = (float) i * SAMPLE_INTERVAL_SECONDS / 3600;
+
+        stateOfCharge.addSample(voltageForPercentage(startPercentage - ratePerHour * elapsedHours), timestamp);
+        timestamp += SAMPLE_INTERVAL_SECONDS;
+    }
+
+    return timestamp;
+}
+
+void test_curveLookup() {
+    TEST_ASSERT_EQUAL_FLOAT(100, lookupDischargeCurve(8.45));
+    TEST_ASSERT_EQUAL_FLOAT(100, lookupDischargeCurve(8.40));
+    TEST_ASSERT_EQUAL_FLOAT(50, lookupDischargeCurve(7.68));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 45, lookupDischargeCurve(7.64));
+    TEST_ASSERT_EQUAL_FLOAT(0, lookupDischargeCurve(6.54));
+    TEST_ASSERT_EQUAL_FLOAT(0, lookupDischargeCurve(5.0));
+
+    // Flat middle of the curve, linear mapping between 6.5 V and 8.45 V would show ~60%
+    TEST_ASSERT_LESS_THAN(50, lookupDischargeCurve(7.65));
+}
+
+void test_timeToEmptyUnknownWithoutHistory() {
+    BatteryStateOfCharge stateOfCharge;
+
+    TEST_ASSERT_FALSE(stateOfCharge.isKnown());
+    TEST_ASSERT_EQUAL(BATTERY_TIME_TO_EMPTY_UNKNOWN, stateOfCharge.getTimeToEmptyMinutes());
+
+    // Only two history points in 6 minutes
+    simulateDischarge(stateOfCharge, 0, 80, 10, 0.1);
+
+    TEST_ASSERT_TRUE(stateOfCharge.isKnown());
+    TEST_ASSERT_EQUAL(2, stateOfCharge.getHistoryCount());
+    TEST_ASSERT_EQUAL(BATTERY_TIME_TO_EMPTY_UNKNOWN, stateOfCharge.getTimeToEmptyMinutes());
+}
+
+void test_timeToEmptyFromDischargeTrend() {
+    BatteryStateOfCharge stateOfCharge;
+
+    // 10% per hour, 80% -> 50% in 3 hours
+    simulateDischarge(stateOfCharge, 0, 80, 10, 3);
+
+    int32_t timeToEmptyMinutes = stateOfCharge.getTimeToEmptyMinutes();
+
+    char message[64];
+    sprintf(message, "Rate: %.2f %%/h, time to empty: %d min", stateOfCharge.getDischargeRatePerHour(), (int) timeToEmptyMinutes);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_FLOAT_WITHIN(1.5, 10, stateOfCharge.getDischargeRatePerHour());
+    TEST_ASSERT_INT_WITHIN(45, 300, timeToEmptyMinutes);
+}
+
+void test_historyWindowFollowsRecentTrend() {
+    BatteryStateOfCharge stateOfCharge;
+
+    // Idle for 4 hours, then servos heavy day draining 20% per hour
+    uint32_t timestamp = simulateDischarge(stateOfCharge, 0, 90, 1, 4);
+    simulateDischarge(stateOfCharge, timestamp, 86, 20, 4);
+
+    TEST_ASSERT_EQUAL(BATTERY_HISTORY_SIZE, stateOfCharge.getHistoryCount());
+    TEST_ASSERT_FLOAT_WITHIN(3, 20, stateOfCharge.getDischargeRatePerHour());
+}
+
+void test_chargingHasNoTimeToEmpty() {
+    BatteryStateOfCharge stateOfCharge;
+
+    simulateDischarge(stateOfCharge, 0, 40, -15, 2);
+
+    TEST_ASSERT_EQUAL(BATTERY_TIME_TO_EMPTY_UNKNOWN, stateOfCharge.getTimeToEmptyMinutes());
+}
+
+void test_clockJumpStartsHistoryOver() {
+    BatteryStateOfCharge stateOfCharge;
+
+    // Unsynchronized clock starts at 0, NTP sync moves it to 2024
+    simulateDischarge(stateOfCharge, 0, 80, 10, 1);
+    simulateDischarge(stateOfCharge, 1700000000, 70, 10, 0.25);
+
+    TEST_ASSERT_EQUAL(3, stateOfCharge.getHistoryCount());
+
+    // Clock set back
+    simulateDischarge(stateOfCharge, 1600000000, 67, 10, 0.05);
+
+    TEST_ASSERT_EQUAL(1, stateOfCharge.getHistoryCount());
+}
+
+void test_historyRestoredAfterDeepSleep() {
+    BatteryStateOfCharge beforeSleep;
+    uint32_t timestamp = simulateDischarge(beforeSleep, 1700000000, 80, 10, 2);
+
+    // RTC memory keeps plain copy, RAM object is constructed again after wake up
+    BatteryHistory rtcHistory = beforeSleep.getHistory();
+    BatteryStateOfCharge afterWakeUp;
+
+    afterWakeUp.restoreHistory(rtcHistory);
+
+    TEST_ASSERT_FALSE(afterWakeUp.isKnown());
+    TEST_ASSERT_EQUAL(beforeSleep.getHistoryCount(), afterWakeUp.getHistoryCount());
+
+    // 30 minutes of deep sleep, discharge continues from where it was
+    simulateDischarge(afterWakeUp, timestamp + 30 * 60, 55, 10, 0.5);
+
+    TEST_ASSERT_TRUE(afterWakeUp.isKnown());
+    TEST_ASSERT_EQUAL(beforeSleep.getHistoryCount() + 6, afterWakeUp.getHistoryCount());
+    TEST_ASSERT_FLOAT_WITHIN(1.5, 10, afterWakeUp.getDischargeRatePerHour());
+    TEST_ASSERT_GREATER_THAN(0, afterWakeUp.getTimeToEmptyMinutes());
+}
+
+void test_sleepLongerThanHistoryStartsOver() {
+    BatteryStateOfCharge beforeSleep;
+    uint32_t timestamp = simulateDischarge(beforeSleep, 1700000000, 80, 10, 2);
+
+    BatteryStateOfCharge afterWakeUp;
+    afterWakeUp.restoreHistory(beforeSleep.getHistory());
+
+    simulateDischarge(afterWakeUp, timestamp + 5 * 3600, 60, 10, 0.05);
+
+    TEST_ASSERT_EQUAL(1, afterWakeUp.getHistoryCount());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_curveLookup);
+    RUN_TEST(test_timeToEmptyUnknownWithoutHistory);
+    RUN_TEST(test_timeToEmptyFromDischargeTrend);
+    RUN_TEST(test_historyWindowFollowsRecentTrend);
+    RUN_TEST(test_chargingHasNoTimeToEmpty);
+    RUN_TEST(test_clockJumpStartsHistoryOver);
+    RUN_TEST(test_historyRestoredAfterDeepSleep);
+    RUN_TEST(test_sleepLongerThanHistoryStartsOver);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
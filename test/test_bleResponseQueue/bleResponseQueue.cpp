@@ -0,0 +1,106 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <bleResponseQueue.h>
+#include <allocationTracker.h>
+
+using namespace fakeit;
+
+// Pool of 64-bit build takes 4 kB
+StaticJsonArena<8192> arena;
+
+// Same shape as single GET_LOGS response
+const char* LOG_RESPONSE = "{\"logs\":[{\"date\":\"2024-05-01 12:00:00\",\"temperature\":22.5,\"windowOpening\":40,\"deltaTemporaryWindowOpening\":-5}]}";
+
+char longResponse[BLE_QUEUE_MESSAGE_MAX_LENGTH + 1];
+
+void setUp() {
+    ArduinoFakeReset();
+
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(unsigned int, int))).AlwaysReturn(0);
+
+    arena.reset();
+}
+
+void tearDown() {}
+
+void test_logsBurstFitsIntoQueue() {
+    BleResponseQueue queue(arena);
+
+    for (int i = 0; i < MAX_LOGS; i++) {
+        TEST_ASSERT_TRUE(queue.push("GET_LOGS", LOG_RESPONSE));
+    }
+
+    TEST_ASSERT_EQUAL(MAX_LOGS, queue.size());
+    TEST_ASSERT_EQUAL(0, queue.getDroppedCount());
+}
+
+void test_messageIsEnvelopeOfResponse() {
+    BleResponseQueue queue(arena);
+
+    queue.push("GET_LOGS", LOG_RESPONSE);
+
+    JsonDocument doc;
+
+    TEST_ASSERT_FALSE(deserializeJson(doc, queue.front()));
+    TEST_ASSERT_EQUAL_STRING("GET_LOGS", doc[0]["commandType"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING(LOG_RESPONSE, doc[0]["data"].as<const char*>());
+
+    queue.pop();
+
+    TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+void test_dropsAreCounted() {
+    BleResponseQueue queue(arena);
+
+    memset(longResponse, 'x', BLE_QUEUE_MESSAGE_MAX_LENGTH);
+    longResponse[BLE_QUEUE_MESSAGE_MAX_LENGTH] = '\0';
+
+    TEST_ASSERT_FALSE(queue.push("GET_LOGS", longResponse));
+
+    for (int i = 0; i < BLE_QUEUE_CAPACITY; i++) {
+        queue.push("GET_LOGS", LOG_RESPONSE);
+    }
+
+    TEST_ASSERT_FALSE(queue.push("GET_LOGS", LOG_RESPONSE));
+    TEST_ASSERT_EQUAL(BLE_QUEUE_CAPACITY, queue.size());
+    TEST_ASSERT_EQUAL(2, queue.getDroppedCount());
+}
+
+void test_queueAndEnvelopeDoNotAllocate() {
+    BleResponseQueue queue(arena);
+
+    resetAllocationTracking();
+
+    // Many GET_LOGS bursts, each notified one by one like checkQueue() does
+    for (int burst = 0; burst < 100; burst++) {
+        for (int i = 0; i < MAX_LOGS; i++) {
+            queue.push("GET_LOGS", LOG_RESPONSE);
+        }
+
+        while (!queue.isEmpty()) {
+            queue.pop();
+        }
+    }
+
+    TEST_ASSERT_EQUAL(0, queue.getDroppedCount());
+
+#ifdef ALLOCATION_TRACKING
+    TEST_ASSERT_EQUAL(0, getAllocationTotals().allocationsCount);
+#endif
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_logsBurstFitsIntoQueue);
+    RUN_TEST(test_messageIsEnvelopeOfResponse);
+    RUN_TEST(test_dropsAreCounted);
+    RUN_TEST(test_queueAndEnvelopeDoNotAllocate);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <ArduinoFake.h>
+#include <Wire.h>
+
+#include <bme280Compensation.h>
+#include <bme280Sensor.h>
+
+using namespace fakeit;
+
+// Calibration from Bosch datasheet example (T, P) and a real sensor (H)
+const Bme280Calibration CALIBRATION = Bme280Calibration{
+    digT1: 27504, digT2: 26435, digT3: -1000,
+    digP1: 36477, digP2: -10685, digP3: 3024, digP4: 2855, digP5: 140, digP6: -7, digP7: 15500, digP8: -14600, digP9: 6000,
+    digH1: 75, digH2: 362, digH3: 0, digH4: 313, digH5: 50, digH6: 30
+};
+
+// Recorded bursts of registers 0xF7 - 0xFE
+const uint8_t RECORDED_SAMPLES[][BME280_DATA_BURST_LENGTH] = {
+    { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x6E, 0x8F },
+    { 0x51, 0x3C, 0x70, 0x82, 0x1F, 0x40, 0x71, 0x04 },
+    { 0x52, 0x0A, 0x10, 0x7C, 0x98, 0xA0, 0x5F, 0xE2 },
+    { 0x53, 0xF1, 0xB0, 0x6A, 0x44, 0x30, 0x82, 0x3A },
+    { 0x50, 0x8E, 0x20, 0x8B, 0x30, 0x10, 0x48, 0x77 }
+};
+
+// Register file of fake sensor, served over fake Wire
+uint8_t registers[256];
+uint8_t registerPointer = 0;
+bool isRegisterPointerSet = false;
+
+void writeRegister16(uint8_t address, uint16_t value) {
+    registers[address] = value & 0xFF;
+    registers[address + 1] = value >> 8;
+}
+
+/**
+ * Calibration registers 0x88 - 0xA1 and 0xE1 - 0xE7 (datasheet 4.2.2), parsed by Adafruit_BME280::readCoefficients
+ */
+void loadCalibrationRegisters(const Bme280Calibration& calibration) {
+    const uint16_t temperatureAndPressure[] = {
+        calibration.digT1, (uint16_t) calibration.digT2, (uint16_t) calibration.digT3,
+        calibration.digP1, (uint16_t) calibration.digP2, (uint16_t) calibration.digP3, (uint16_t) calibration.digP4, (uint16_t) calibration.digP5,
+        (uint16_t) calibration.digP6, (uint16_t) calibration.digP7, (uint16_t) calibration.digP8, (uint16_t) calibration.digP9
+    };
+
+    for (uint8_t i = 0; i < 12; i++) {
+        writeRegister16(0x88 + i * 2, temperatureAndPressure[i]);
+    }
+
+    registers[0xA1] = calibration.digH1;
+    writeRegister16(0xE1, calibration.digH2);
+    registers[0xE3] = calibration.digH3;
+    registers[0xE4] = calibration.digH4 >> 4;
+    registers[0xE5] = (calibration.digH5 & 0x0F) << 4 | (calibration.digH4 & 0x0F);
+    registers[0xE6] = calibration.digH5 >> 4;
+    registers[0xE7] = calibration.digH6;
+}
+
+void loadDataRegisters(const uint8_t* raw) {
+    memcpy(&registers[BME280_REGISTER_PRESSUREDATA], raw, BME280_DATA_BURST_LENGTH);
+}
+
+void writeWireByte(uint8_t value) {
+    // First byte of transaction selects register, following ones are written from there
+    if (!isRegisterPointerSet) {
+        registerPointer = value;
+        isRegisterPointerSet = true;
+        return;
+    }
+
+    // Soft reset and sampling settings must not touch recorded data
+    if (registerPointer >= BME280_REGISTER_CONTROLHUMID && registerPointer <= BME280_REGISTER_CONFIG) {
+        registers[registerPointer] = value;
+    }
+
+    registerPointer++;
+}
+
+void setUp() {
+    ArduinoFakeReset();
+
+    memset(registers, 0, sizeof(registers));
+    registers[BME280_REGISTER_CHIPID] = 0x60;
+    loadCalibrationRegisters(CALIBRATION);
+
+    When(Method(ArduinoFake(), delay)).AlwaysReturn();
+    When(Method(ArduinoFake(), millis)).AlwaysReturn(0);
+
+    When(OverloadedMethod(ArduinoFake(Wire), begin, void(void))).AlwaysReturn();
+    When(OverloadedMethod(ArduinoFake(Wire), setClock, void(uint32_t))).AlwaysReturn();
+    When(OverloadedMethod(ArduinoFake(Wire), beginTransmission, void(uint8_t))).AlwaysDo([](uint8_t address) {
+        isRegisterPointerSet = false;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), write, size_t(uint8_t))).AlwaysDo([](uint8_t value) -> size_t {
+        writeWireByte(value);
+        return 1;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), write, size_t(const uint8_t*, size_t))).AlwaysDo([](const uint8_t* buffer, size_t length) -> size_t {
+        for (size_t i = 0; i < length; i++) {
+            writeWireByte(buffer[i]);
+        }
+
+        return length;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), endTransmission, uint8_t(void))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Wire), endTransmission, uint8_t(bool))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Wire), requestFrom, uint8_t(uint8_t, uint8_t, uint8_t))).AlwaysDo([](uint8_t address, uint8_t length, uint8_t stop) -> uint8_t {
+        return length;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), read, int(void))).AlwaysDo([]() -> int {
+        return registers[registerPointer++];
+    });
+}
+
+void tearDown() {}
+
+void test_datasheetExample() {
+    int32_t tFine;
+    Bme280Reading reading = Bme280Compensation::compensate(RECORDED_SAMPLES[0], CALIBRATION, 0, tFine);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 25.08, reading.temperature);
+    TEST_ASSERT_FLOAT_WITHIN(1, 100653, reading.pressure);
+}
+
+void test_calibrationReadFromSensor() {
+    Bme280Sensor sensor;
+
+    TEST_ASSERT_TRUE(sensor.begin(BME280_ADDRESS, &Wire));
+
+    Bme280Calibration calibration = sensor.getCalibration();
+
+    TEST_ASSERT_EQUAL(CALIBRATION.digT1, calibration.digT1);
+    TEST_ASSERT_EQUAL(CALIBRATION.digT2, calibration.digT2);
+    TEST_ASSERT_EQUAL(CALIBRATION.digT3, calibration.digT3);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP1, calibration.digP1);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP2, calibration.digP2);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP3, calibration.digP3);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP4, calibration.digP4);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP5, calibration.digP5);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP6, calibration.digP6);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP7, calibration.digP7);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP8, calibration.digP8);
+    TEST_ASSERT_EQUAL(CALIBRATION.digP9, calibration.digP9);
+    TEST_ASSERT_EQUAL(CALIBRATION.digH1, calibration.digH1);
+    TEST_ASSERT_EQUAL(CALIBRATION.digH2, calibration.digH2);
+    TEST_ASSERT_EQUAL(CALIBRATION.digH3, calibration.digH3);
+    TEST_ASSERT_EQUAL(CALIBRATION.digH4, calibration.digH4);
+    TEST_ASSERT_EQUAL(CALIBRATION.digH5, calibration.digH5);
+    TEST_ASSERT_EQUAL(CALIBRATION.digH6, calibration.digH6);
+}
+
+/**
+ * Burst read against Adafruit_BME280 per-field reads of the same registers
+ */
+void test_matchesPerFieldReads() {
+    const float temperatureCompensations[] = { 0, 1, -2 };
+
+    Bme280Sensor sensor;
+    TEST_ASSERT_TRUE(sensor.begin(BME280_ADDRESS, &Wire));
+
+    for (float temperatureCompensation : temperatureCompensations) {
+        sensor.setTemperatureCompensation(temperatureCompensation);
+
+        for (const uint8_t* raw : RECORDED_SAMPLES) {
+            loadDataRegisters(raw);
+
+            Bme280Reading reading = sensor.readAll();
+
+            TEST_ASSERT_EQUAL_FLOAT(sensor.readTemperature(), reading.temperature);
+            TEST_ASSERT_EQUAL_FLOAT(sensor.readPressure(), reading.pressure);
+            TEST_ASSERT_EQUAL_FLOAT(sensor.readHumidity(), reading.humidity);
+        }
+    }
+}
+
+void test_disabledMeasurements() {
+    int32_t tFine;
+
+    const uint8_t pressureAndHumidityDisabled[BME280_DATA_BURST_LENGTH] = { 0x80, 0x00, 0x00, 0x7E, 0xED, 0x00, 0x80, 0x00 };
+    Bme280Reading reading = Bme280Compensation::compensate(pressureAndHumidityDisabled, CALIBRATION, 0, tFine);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 25.08, reading.temperature);
+    TEST_ASSERT_TRUE(isnan(reading.pressure));
+    TEST_ASSERT_TRUE(isnan(reading.humidity));
+
+    const uint8_t temperatureDisabled[BME280_DATA_BURST_LENGTH] = { 0x65, 0x5A, 0xC0, 0x80, 0x00, 0x00, 0x6E, 0x8F };
+    reading = Bme280Compensation::compensate(temperatureDisabled, CALIBRATION, 0, tFine);
+
+    TEST_ASSERT_TRUE(isnan(reading.temperature));
+    TEST_ASSERT_TRUE(isnan(reading.pressure));
+    TEST_ASSERT_TRUE(isnan(reading.humidity));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_datasheetExample);
+    RUN_TEST(test_calibrationReadFromSensor);
+    RUN_TEST(test_matchesPerFieldReads);
+    RUN_TEST(test_disabledMeasurements);
+
+    return UNITY_END();
+}
\ No newline at end of file
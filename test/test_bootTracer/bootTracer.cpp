@@ -0,0 +1,177 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+
+#include <ArduinoJson.h>
+
+#include <bootTracer.h>
+#include <bleDiagnostics.h>
+#include <bleResponseQueue.h>
+
+using namespace fakeit;
+
+unsigned long fakeMicros = 0;
+
+void setUp() {
+    ArduinoFakeReset();
+
+    fakeMicros = 0;
+
+    When(Method(ArduinoFake(), micros)).AlwaysDo([]() -> unsigned long { return fakeMicros; });
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(unsigned int, int))).AlwaysReturn(0);
+}
+
+void tearDown() {}
+
+void test_sequentialStages() {
+    BootTracer tracer;
+
+    fakeMicros = 1000;
+    uint8_t eeprom = tracer.begin("eeprom");
+    fakeMicros = 1500;
+    tracer.end(eeprom);
+
+    uint8_t sensor = tracer.begin("sensor");
+    fakeMicros = 121500;
+    tracer.end(sensor);
+
+    TEST_ASSERT_EQUAL(2, tracer.getStagesCount());
+    TEST_ASSERT_EQUAL_STRING("eeprom", tracer.getStage(eeprom).name);
+    TEST_ASSERT_EQUAL(1000, tracer.getStage(eeprom).startMicroseconds);
+    TEST_ASSERT_EQUAL(500, tracer.getStage(eeprom).durationMicroseconds);
+    TEST_ASSERT_EQUAL(120000, tracer.getStage(sensor).durationMicroseconds);
+    TEST_ASSERT_TRUE(tracer.isFinished());
+    TEST_ASSERT_EQUAL(121500, tracer.getBootMicroseconds());
+}
+
+void test_overlappingStages() {
+    BootTracer tracer;
+
+    fakeMicros = 2000;
+    uint8_t ble = tracer.begin("ble");
+    fakeMicros = 3000;
+    uint8_t lcd = tracer.begin("lcd");
+    fakeMicros = 5000;
+    tracer.end(lcd);
+
+    // Boot is not over while BLE is still coming up
+    TEST_ASSERT_FALSE(tracer.isFinished());
+    TEST_ASSERT_EQUAL(5000, tracer.getBootMicroseconds());
+
+    fakeMicros = 400000;
+    tracer.end(ble);
+
+    TEST_ASSERT_TRUE(tracer.isFinished());
+    TEST_ASSERT_EQUAL(398000, tracer.getStage(ble).durationMicroseconds);
+    TEST_ASSERT_EQUAL(400000, tracer.getBootMicroseconds());
+}
+
+void test_recordedStage() {
+    BootTracer tracer;
+
+    tracer.record("preSetup", 0, 35000);
+
+    TEST_ASSERT_EQUAL(1, tracer.getStagesCount());
+    TEST_ASSERT_TRUE(tracer.getStage(0).isFinished);
+    TEST_ASSERT_EQUAL(35000, tracer.getStage(0).durationMicroseconds);
+}
+
+void test_fullBufferIsIgnored() {
+    BootTracer tracer;
+
+    for (uint8_t i = 0; i < BOOT_TRACER_MAX_STAGES; i++) {
+        tracer.end(tracer.begin("stage"));
+    }
+
+    uint8_t overflow = tracer.begin("overflow");
+    tracer.end(overflow);
+    tracer.record("overflow", 0, 1);
+
+    TEST_ASSERT_EQUAL(BOOT_TRACER_NO_STAGE, overflow);
+    TEST_ASSERT_EQUAL(BOOT_TRACER_MAX_STAGES, tracer.getStagesCount());
+    TEST_ASSERT_TRUE(tracer.isFinished());
+}
+
+void test_stageEndsOnlyOnce() {
+    BootTracer tracer;
+
+    uint8_t stage = tracer.begin("wifi");
+    fakeMicros = 100;
+    tracer.end(stage);
+    fakeMicros = 900;
+    tracer.end(stage);
+
+    TEST_ASSERT_EQUAL(100, tracer.getStage(stage).durationMicroseconds);
+}
+
+/**
+ * Every stage has name of maximum length and long duration
+ */
+void fillTracer(BootTracer& tracer) {
+    for (uint8_t i = 0; i < BOOT_TRACER_MAX_STAGES; i++) {
+        fakeMicros = 4000000000UL + i * 10000000UL;
+        uint8_t stage = tracer.begin("longStageName123456");
+        fakeMicros += 9999000;
+        tracer.end(stage);
+    }
+}
+
+void test_fullTraceMessagesFitIntoBleQueue() {
+    BootTracer tracer;
+    fillTracer(tracer);
+
+    StaticJsonArena<8192> arena;
+    BleResponseQueue queue(arena);
+    uint8_t messagesCount = getBootTraceMessagesCount(tracer);
+
+    TEST_ASSERT_EQUAL(3, messagesCount);
+
+    for (uint8_t i = 0; i < messagesCount; i++) {
+        JsonDocument jsonDoc;
+        writeBootTraceMessage(tracer, i, jsonDoc);
+
+        String data;
+        serializeJson(jsonDoc, data);
+
+        TEST_ASSERT_LESS_THAN(BLE_QUEUE_MESSAGE_MAX_LENGTH, measureJson(jsonDoc));
+
+        // Envelope escapes quotes of the response
+        TEST_ASSERT_TRUE(queue.push("GET_BOOT_TRACE", data.c_str()));
+    }
+}
+
+void test_traceMessagesCoverAllStages() {
+    BootTracer tracer;
+
+    fakeMicros = 2500;
+    tracer.record("preSetup", 0, 2500);
+    uint8_t wifi = tracer.begin("wifi");
+
+    JsonDocument jsonDoc;
+    writeBootTraceMessage(tracer, 0, jsonDoc);
+
+    TEST_ASSERT_EQUAL(1, jsonDoc["messagesCount"].as<int>());
+    TEST_ASSERT_FALSE(jsonDoc["isFinished"].as<bool>());
+    TEST_ASSERT_EQUAL(2, jsonDoc["stages"].size());
+    TEST_ASSERT_EQUAL_STRING("preSetup", jsonDoc["stages"][0][0].as<const char*>());
+    TEST_ASSERT_EQUAL(2, jsonDoc["stages"][0][2].as<int>());
+    TEST_ASSERT_EQUAL(2, jsonDoc["stages"][1][1].as<int>());
+    TEST_ASSERT_EQUAL(2, jsonDoc["stages"][1].size()); // Still running
+
+    tracer.end(wifi);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sequentialStages);
+    RUN_TEST(test_overlappingStages);
+    RUN_TEST(test_recordedStage);
+    RUN_TEST(test_fullBufferIsIgnored);
+    RUN_TEST(test_stageEndsOnlyOnce);
+    RUN_TEST(test_fullTraceMessagesFitIntoBleQueue);
+    RUN_TEST(test_traceMessagesCoverAllStages);
+
+    return UNITY_END();
+}
\ No newline at end of file
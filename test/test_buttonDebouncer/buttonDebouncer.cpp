@@ -0,0 +1,140 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <buttonDebouncer.h>
+
+const uint8_t MAX_EVENTS = 8;
+
+ButtonEventType events[MAX_EVENTS];
+uint8_t eventsCount = 0;
+
+void collectEvents(ButtonDebouncer& debouncer, uint32_t nowMiliseconds) {
+    ButtonEventType event;
+
+    while (eventsCount < MAX_EVENTS && debouncer.update(nowMiliseconds, event)) {
+        events[eventsCount++] = event;
+    }
+}
+
+// Contact bounce of a real switch, last edge comes 3 ms after first
+const uint8_t BOUNCE_MILISECONDS = 3;
+
+void bounce(ButtonDebouncer& debouncer, bool isPressed, uint32_t startMiliseconds) {
+    debouncer.handleEdge(isPressed, startMiliseconds);
+    debouncer.handleEdge(!isPressed, startMiliseconds + 1);
+    debouncer.handleEdge(isPressed, startMiliseconds + BOUNCE_MILISECONDS);
+
+    collectEvents(debouncer, startMiliseconds + 10);
+}
+
+// Whole press, debouncer task wakes up at every deadline
+void press(ButtonDebouncer& debouncer, uint32_t pressMiliseconds, uint32_t releaseMiliseconds) {
+    bounce(debouncer, true, pressMiliseconds);
+    collectEvents(debouncer, pressMiliseconds + BOUNCE_MILISECONDS + BUTTON_DEBOUNCE_MILISECONDS);
+
+    uint32_t deadline = debouncer.getMilisecondsUntilDeadline(pressMiliseconds + BOUNCE_MILISECONDS + BUTTON_DEBOUNCE_MILISECONDS);
+
+    if (pressMiliseconds + BOUNCE_MILISECONDS + BUTTON_DEBOUNCE_MILISECONDS + deadline < releaseMiliseconds) {
+        collectEvents(debouncer, pressMiliseconds + BOUNCE_MILISECONDS + BUTTON_DEBOUNCE_MILISECONDS + deadline);
+    }
+
+    bounce(debouncer, false, releaseMiliseconds);
+    collectEvents(debouncer, releaseMiliseconds + BOUNCE_MILISECONDS + BUTTON_DEBOUNCE_MILISECONDS);
+}
+
+void setUp() {
+    eventsCount = 0;
+}
+
+void tearDown() {}
+
+void test_bouncingPressIsOnePress() {
+    ButtonDebouncer debouncer;
+
+    press(debouncer, 1000, 1120);
+
+    TEST_ASSERT_EQUAL(1, eventsCount);
+    TEST_ASSERT_EQUAL(ButtonPress, events[0]);
+    TEST_ASSERT_EQUAL(BUTTON_NO_DEADLINE, debouncer.getMilisecondsUntilDeadline(2000));
+}
+
+// Polling with 100 ms lockout missed second one of these
+void test_quickPressesAreNotMissed() {
+    ButtonDebouncer debouncer;
+
+    press(debouncer, 1000, 1060);
+    press(debouncer, 1110, 1170);
+
+    TEST_ASSERT_EQUAL(2, eventsCount);
+    TEST_ASSERT_EQUAL(ButtonPress, events[0]);
+    TEST_ASSERT_EQUAL(ButtonPress, events[1]);
+}
+
+void test_longPressIsReportedWhileHeld() {
+    ButtonDebouncer debouncer;
+
+    // Held since last edge
+    uint32_t pressedMiliseconds = 1000 + BOUNCE_MILISECONDS;
+
+    bounce(debouncer, true, 1000);
+    collectEvents(debouncer, pressedMiliseconds + BUTTON_LONG_PRESS_MILISECONDS - 1);
+
+    TEST_ASSERT_EQUAL(0, eventsCount);
+    TEST_ASSERT_EQUAL(1, debouncer.getMilisecondsUntilDeadline(pressedMiliseconds + BUTTON_LONG_PRESS_MILISECONDS - 1));
+
+    collectEvents(debouncer, pressedMiliseconds + BUTTON_LONG_PRESS_MILISECONDS);
+    bounce(debouncer, false, 3000);
+    collectEvents(debouncer, 3100);
+
+    // Release after long press is not a press
+    TEST_ASSERT_EQUAL(1, eventsCount);
+    TEST_ASSERT_EQUAL(ButtonLongPress, events[0]);
+}
+
+void test_doublePressOnlyWhenEnabled() {
+    ButtonDebouncer debouncer;
+    debouncer.setDoublePressEnabled(true);
+
+    press(debouncer, 1000, 1080);
+    press(debouncer, 1200, 1280);
+
+    TEST_ASSERT_EQUAL(1, eventsCount);
+    TEST_ASSERT_EQUAL(ButtonDoublePress, events[0]);
+
+    // Single press waits for double press window
+    eventsCount = 0;
+    press(debouncer, 5000, 5080);
+
+    TEST_ASSERT_EQUAL(0, eventsCount);
+
+    collectEvents(debouncer, 5080 + BOUNCE_MILISECONDS + BUTTON_DOUBLE_PRESS_MILISECONDS - 1);
+
+    TEST_ASSERT_EQUAL(0, eventsCount);
+
+    collectEvents(debouncer, 5080 + BOUNCE_MILISECONDS + BUTTON_DOUBLE_PRESS_MILISECONDS);
+
+    TEST_ASSERT_EQUAL(1, eventsCount);
+    TEST_ASSERT_EQUAL(ButtonPress, events[0]);
+}
+
+void test_deadlinesAcrossMillisOverflow() {
+    ButtonDebouncer debouncer;
+    uint32_t start = UINT32_MAX - 20;
+
+    press(debouncer, start, start + 100);
+
+    TEST_ASSERT_EQUAL(1, eventsCount);
+    TEST_ASSERT_EQUAL(ButtonPress, events[0]);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bouncingPressIsOnePress);
+    RUN_TEST(test_quickPressesAreNotMissed);
+    RUN_TEST(test_longPressIsReportedWhileHeld);
+    RUN_TEST(test_doublePressOnlyWhenEnabled);
+    RUN_TEST(test_deadlinesAcrossMillisOverflow);
+
+    return UNITY_END();
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+
+#include <fixedVector.h>
+
+void setUp() {
+    ArduinoFakeReset();
+}
+
+void tearDown() {}
+
+void test_pushBackUntilFull() {
+    FixedVector<int, 3> vector;
+
+    TEST_ASSERT_TRUE(vector.empty());
+    TEST_ASSERT_TRUE(vector.push_back(1));
+    TEST_ASSERT_TRUE(vector.push_back(2));
+    TEST_ASSERT_TRUE(vector.push_back(3));
+    TEST_ASSERT_TRUE(vector.full());
+    TEST_ASSERT_FALSE(vector.push_back(4));
+
+    TEST_ASSERT_EQUAL(3, vector.size());
+    TEST_ASSERT_EQUAL(1, vector.front());
+    TEST_ASSERT_EQUAL(3, vector.back());
+}
+
+void test_insertKeepsOrder() {
+    FixedVector<int, 4> vector;
+
+    vector.push_back(1);
+    vector.push_back(3);
+    vector.insert(1, 2);
+    vector.insert(0, 0);
+
+    for (uint16_t i = 0; i < vector.size(); i++) {
+        TEST_ASSERT_EQUAL(i, vector[i]);
+    }
+
+    TEST_ASSERT_FALSE(vector.insert(0, -1));
+}
+
+void test_insertOutOfRangeFails() {
+    FixedVector<int, 4> vector;
+
+    TEST_ASSERT_FALSE(vector.insert(1, 1));
+    TEST_ASSERT_TRUE(vector.empty());
+}
+
+void test_eraseShiftsRest() {
+    FixedVector<int, 4> vector;
+
+    vector.push_back(1);
+    vector.push_back(2);
+    vector.push_back(3);
+    vector.erase(0);
+    vector.erase(5);
+
+    TEST_ASSERT_EQUAL(2, vector.size());
+    TEST_ASSERT_EQUAL(2, vector[0]);
+    TEST_ASSERT_EQUAL(3, vector[1]);
+
+    int sum = 0;
+
+    for (int value: vector) {
+        sum += value;
+    }
+
+    TEST_ASSERT_EQUAL(5, sum);
+
+    vector.clear();
+
+    TEST_ASSERT_TRUE(vector.empty());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_pushBackUntilFull);
+    RUN_TEST(test_insertKeepsOrder);
+    RUN_TEST(test_insertOutOfRangeFails);
+    RUN_TEST(test_eraseShiftsRest);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
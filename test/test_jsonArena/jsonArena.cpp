@@ -0,0 +1,123 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <jsonArena.h>
+#include <allocationTracker.h>
+
+// Pool of 64-bit build takes 4 kB
+StaticJsonArena<8192> arena;
+
+void setUp() {
+    ArduinoFakeReset();
+
+    arena.reset();
+}
+
+void tearDown() {}
+
+void test_allocationsAreAligned() {
+    void* first = arena.allocate(3);
+    void* second = arena.allocate(5);
+
+    TEST_ASSERT_EQUAL(0, (uintptr_t) first % JSON_ARENA_ALIGNMENT);
+    TEST_ASSERT_EQUAL(0, (uintptr_t) second % JSON_ARENA_ALIGNMENT);
+    TEST_ASSERT_EQUAL(32, arena.getUsed());
+}
+
+void test_newestBlockIsResizedInPlace() {
+    void* first = arena.allocate(16);
+    void* grown = arena.reallocate(first, 100);
+
+    TEST_ASSERT_TRUE(grown == first);
+    TEST_ASSERT_EQUAL(8 + 104, arena.getUsed());
+
+    void* shrunk = arena.reallocate(grown, 8);
+
+    TEST_ASSERT_TRUE(shrunk == first);
+    TEST_ASSERT_EQUAL(16, arena.getUsed());
+}
+
+void test_olderBlockIsMovedOnResize() {
+    uint8_t* first = (uint8_t*) arena.allocate(4);
+    arena.allocate(4);
+
+    memcpy(first, "abc", 4);
+
+    char* moved = (char*) arena.reallocate(first, 32);
+
+    TEST_ASSERT_TRUE((void*) moved != (void*) first);
+    TEST_ASSERT_EQUAL_STRING("abc", moved);
+}
+
+void test_arenaRewindsWhenAllBlocksAreFreed() {
+    void* first = arena.allocate(100);
+    void* second = arena.allocate(100);
+
+    arena.deallocate(second);
+
+    TEST_ASSERT_EQUAL(8 + 104, arena.getUsed());
+
+    arena.deallocate(first);
+
+    TEST_ASSERT_EQUAL(0, arena.getUsed());
+    TEST_ASSERT_EQUAL(2 * (8 + 104), arena.getPeakUsed());
+}
+
+void test_fullArenaReturnsNull() {
+    TEST_ASSERT_NULL(arena.allocate(arena.getCapacity()));
+    TEST_ASSERT_NOT_NULL(arena.allocate(arena.getCapacity() - 8));
+    TEST_ASSERT_NULL(arena.allocate(1));
+}
+
+void test_documentIsSerializedWithoutHeap() {
+    char output[256];
+
+    resetAllocationTracking();
+
+    {
+        JsonDocument doc(&arena);
+
+        doc["insideTemperature"] = 21.5;
+        doc["config"]["optimalTemperature"] = 22;
+        doc["partialData"]["proportionalTermValue"] = -0.25;
+        doc["date"] = String("2024-01-01 12:00:00");
+
+        TEST_ASSERT_FALSE(doc.overflowed());
+
+        serializeJson(doc, output, sizeof(output));
+    }
+
+    TEST_ASSERT_EQUAL_STRING("{\"insideTemperature\":21.5,\"config\":{\"optimalTemperature\":22},\"partialData\":{\"proportionalTermValue\":-0.25},\"date\":\"2024-01-01 12:00:00\"}", output);
+    TEST_ASSERT_EQUAL(0, arena.getUsed());
+
+#ifdef ALLOCATION_TRACKING
+    // Only the String passed as value
+    TEST_ASSERT_EQUAL(0, getAllocationTotals().bytesInFlight);
+    TEST_ASSERT_LESS_OR_EQUAL(1, getAllocationTotals().allocationsCount);
+#endif
+}
+
+void test_smallArenaOverflowsDocument() {
+    StaticJsonArena<64> smallArena;
+    JsonDocument doc(&smallArena);
+
+    doc["insideTemperature"] = 21.5;
+
+    TEST_ASSERT_TRUE(doc.overflowed());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_allocationsAreAligned);
+    RUN_TEST(test_newestBlockIsResizedInPlace);
+    RUN_TEST(test_olderBlockIsMovedOnResize);
+    RUN_TEST(test_arenaRewindsWhenAllBlocksAreFreed);
+    RUN_TEST(test_fullArenaReturnsNull);
+    RUN_TEST(test_documentIsSerializedWithoutHeap);
+    RUN_TEST(test_smallArenaOverflowsDocument);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
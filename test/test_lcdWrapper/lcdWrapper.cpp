@@ -0,0 +1,290 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+#include <Wire.h>
+
+#include <lcdWrapper.h>
+
+using namespace fakeit;
+
+// EEPROM backed setting replaced by plain value
+int scrollSpeedValue = LCD_SCROLL_DEFAULT_CHARACTER_MILISECONDS;
+
+int readScrollSpeed() {
+    return scrollSpeedValue;
+}
+
+uint32_t wireBytesCount = 0;
+uint32_t wireTransactionsCount = 0;
+
+// Expander bytes in order, to compare batched and unbatched streams
+uint8_t wireBytes[2048];
+
+void setUp() {
+    ArduinoFakeReset();
+
+    wireBytesCount = 0;
+    wireTransactionsCount = 0;
+
+    When(Method(ArduinoFake(), millis)).AlwaysReturn(0);
+    When(Method(ArduinoFake(), delay)).AlwaysReturn();
+    When(Method(ArduinoFake(), delayMicroseconds)).AlwaysReturn();
+
+    When(OverloadedMethod(ArduinoFake(Wire), begin, void(void))).AlwaysReturn();
+    When(OverloadedMethod(ArduinoFake(Wire), beginTransmission, void(uint8_t))).AlwaysReturn();
+    When(OverloadedMethod(ArduinoFake(Wire), beginTransmission, void(int))).AlwaysReturn();
+    When(OverloadedMethod(ArduinoFake(Wire), write, size_t(uint8_t))).AlwaysDo([](uint8_t value) -> size_t {
+        if (wireBytesCount < sizeof(wireBytes)) {
+            wireBytes[wireBytesCount] = value;
+        }
+
+        wireBytesCount++;
+        return 1;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), write, size_t(const uint8_t*, size_t))).AlwaysDo([](const uint8_t* buffer, size_t length) -> size_t {
+        for (size_t i = 0; i < length; i++) {
+            if (wireBytesCount < sizeof(wireBytes)) {
+                wireBytes[wireBytesCount] = buffer[i];
+            }
+
+            wireBytesCount++;
+        }
+
+        return length;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), endTransmission, uint8_t(void))).AlwaysDo([]() -> uint8_t {
+        wireTransactionsCount++;
+        return 0;
+    });
+    When(OverloadedMethod(ArduinoFake(Wire), endTransmission, uint8_t(bool))).AlwaysDo([](bool stop) -> uint8_t {
+        wireTransactionsCount++;
+        return 0;
+    });
+}
+
+void tearDown() {}
+
+/**
+ * Previous LcdWrapper::print - clearing changed rows with 32 spaces and printing them again
+ */
+String legacyTopRowText = "";
+String legacyBottomRowText = "";
+
+// Print::print(String) writes character by character
+void legacyWriteText(LiquidCrystal_I2C& lcd, const String& text) {
+    for (unsigned int i = 0; i < text.length(); i++) {
+        lcd.write(text.charAt(i));
+    }
+}
+
+void legacyPrint(LiquidCrystal_I2C& lcd, String topRowText, String bottomRowText) {
+    if (topRowText == legacyTopRowText && bottomRowText == legacyBottomRowText) {
+        return;
+    }
+
+    lcd.home();
+
+    if (topRowText != legacyTopRowText) {
+        lcd.setCursor(0, 0);
+        legacyWriteText(lcd, "                                ");
+        legacyTopRowText = topRowText;
+        lcd.setCursor(0, 0);
+        legacyWriteText(lcd, legacyTopRowText);
+    }
+
+    if (bottomRowText != legacyBottomRowText) {
+        lcd.setCursor(0, 1);
+        legacyWriteText(lcd, "                                ");
+        legacyBottomRowText = bottomRowText;
+        lcd.setCursor(0, 1);
+        legacyWriteText(lcd, legacyBottomRowText);
+    }
+}
+
+// Potentiometer turned while moving servo, then menu changed
+const char* SCREENS[][2] = {
+    { "Move:", "40" },
+    { "Move:", "41" },
+    { "Move:", "42" },
+    { "Move:", "45" },
+    { "Move:", "50" },
+    { "Move:", "100" },
+    { "Move:", "99" },
+    { "Settings:", "Optimal Temp." },
+    { "Settings:", "P Term Positive" },
+    { "Battery Box", "7.95V 74%" },
+    { "Battery Box", "7.94V 74%" }
+};
+
+const uint8_t SCREENS_COUNT = sizeof(SCREENS) / sizeof(SCREENS[0]);
+
+void test_sendsFewerBytesThanLegacyPrint() {
+    LiquidCrystal_I2C legacyLcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    legacyLcd.init();
+    legacyTopRowText = "";
+    legacyBottomRowText = "";
+
+    wireBytesCount = 0;
+    wireTransactionsCount = 0;
+
+    for (uint8_t i = 0; i < SCREENS_COUNT; i++) {
+        legacyPrint(legacyLcd, SCREENS[i][0], SCREENS[i][1]);
+    }
+
+    uint32_t legacyBytes = wireBytesCount;
+    uint32_t legacyTransactions = wireTransactionsCount;
+
+    BatchedLcd lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    LcdWrapper lcdWrapper(&lcd, readScrollSpeed);
+    lcdWrapper.initialize(2048);
+
+    wireBytesCount = 0;
+    wireTransactionsCount = 0;
+
+    for (uint8_t i = 0; i < SCREENS_COUNT; i++) {
+        lcdWrapper.print(SCREENS[i][0], SCREENS[i][1]);
+    }
+
+    char message[120];
+    snprintf(message, sizeof(message), "I2C bytes for %d screens - legacy: %u (%u transactions), framebuffer: %u (%u transactions)", SCREENS_COUNT, legacyBytes, legacyTransactions, wireBytesCount, wireTransactionsCount);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_THAN(legacyBytes / 4, wireBytesCount);
+    TEST_ASSERT_LESS_THAN(legacyTransactions / 100, wireTransactionsCount);
+}
+
+void test_unchangedScreenSendsNothing() {
+    BatchedLcd lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    LcdWrapper lcdWrapper(&lcd, readScrollSpeed);
+    lcdWrapper.initialize(2048);
+    lcdWrapper.print("Move:", "40");
+
+    wireBytesCount = 0;
+    lcdWrapper.print("Move:", "40");
+
+    TEST_ASSERT_EQUAL(0, wireBytesCount);
+}
+
+void test_singleChangedCell() {
+    BatchedLcd lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    LcdWrapper lcdWrapper(&lcd, readScrollSpeed);
+    lcdWrapper.initialize(2048);
+    lcdWrapper.print("Move:", "40");
+
+    wireBytesCount = 0;
+    wireTransactionsCount = 0;
+    lcdWrapper.print("Move:", "41");
+
+    // setCursor command and one character, 6 expander writes each, in one transaction
+    TEST_ASSERT_EQUAL(12, wireBytesCount);
+    TEST_ASSERT_EQUAL(1, wireTransactionsCount);
+}
+
+void test_turnOnRedrawsCurrentScreen() {
+    BatchedLcd lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    LcdWrapper lcdWrapper(&lcd, readScrollSpeed);
+    lcdWrapper.initialize(2048);
+    lcdWrapper.print("Move:", "40");
+    lcdWrapper.turnOff();
+
+    wireBytesCount = 0;
+    lcdWrapper.turnOff();
+
+    TEST_ASSERT_EQUAL(0, wireBytesCount);
+
+    // LCD is cleared by init, both texts (7 characters) are written again
+    lcdWrapper.turnOn();
+
+    TEST_ASSERT_GREATER_THAN(7 * LCD_BYTES_PER_CHARACTER, wireBytesCount);
+}
+
+void test_marqueeIdleForShortText() {
+    LcdMarquee marquee(LCD_COLUMNS);
+    marquee.start(LCD_COLUMNS, 1000);
+
+    TEST_ASSERT_FALSE(marquee.isRunning());
+    TEST_ASSERT_FALSE(marquee.update(100000, LCD_SCROLL_DEFAULT_CHARACTER_MILISECONDS));
+}
+
+void test_marqueeStepsAcrossMillisOverflow() {
+    const uint16_t characterMiliseconds = 300;
+    uint32_t now = UINT32_MAX - 1000;
+
+    // 20 characters, 4 steps to the end
+    LcdMarquee marquee(LCD_COLUMNS);
+    marquee.start(20, now);
+
+    TEST_ASSERT_TRUE(marquee.isRunning());
+    TEST_ASSERT_EQUAL(LCD_SCROLL_START_DELAY_MILISECONDS, marquee.getMilisecondsUntilNextStep(now));
+    TEST_ASSERT_FALSE(marquee.update(now + LCD_SCROLL_START_DELAY_MILISECONDS - 1, characterMiliseconds));
+
+    now += LCD_SCROLL_START_DELAY_MILISECONDS; // Wrapped
+
+    for (uint16_t position = 1; position <= 4; position++) {
+        TEST_ASSERT_TRUE(marquee.update(now, characterMiliseconds));
+        TEST_ASSERT_EQUAL(position, marquee.getPosition());
+        TEST_ASSERT_EQUAL(characterMiliseconds, marquee.getMilisecondsUntilNextStep(now));
+
+        now += characterMiliseconds;
+    }
+
+    // Back to start, waits again before scrolling
+    TEST_ASSERT_TRUE(marquee.update(now, characterMiliseconds));
+    TEST_ASSERT_EQUAL(0, marquee.getPosition());
+    TEST_ASSERT_EQUAL(LCD_SCROLL_START_DELAY_MILISECONDS, marquee.getMilisecondsUntilNextStep(now));
+}
+
+void test_batchedStreamMatchesUnbatched() {
+    const char* text = "Battery Servos 7.95V 74%";
+    uint8_t textLength = strlen(text);
+
+    BatchedLcd lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    lcd.init();
+    lcd.backlight();
+
+    wireBytesCount = 0;
+    wireTransactionsCount = 0;
+    lcd.setCursor(0, 1);
+
+    for (uint8_t i = 0; i < textLength; i++) {
+        lcd.write(text[i]);
+    }
+
+    uint32_t unbatchedBytesCount = wireBytesCount;
+    uint32_t unbatchedTransactionsCount = wireTransactionsCount;
+    uint8_t unbatchedBytes[256];
+    memcpy(unbatchedBytes, wireBytes, unbatchedBytesCount);
+
+    wireBytesCount = 0;
+    wireTransactionsCount = 0;
+    lcd.beginBatch();
+    lcd.setCursor(0, 1);
+
+    for (uint8_t i = 0; i < textLength; i++) {
+        lcd.write(text[i]);
+    }
+
+    lcd.endBatch();
+
+    char message[120];
+    snprintf(message, sizeof(message), "I2C transactions for %d characters - unbatched: %u, batched: %u", textLength, unbatchedTransactionsCount, wireTransactionsCount);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL(unbatchedBytesCount, wireBytesCount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(unbatchedBytes, wireBytes, unbatchedBytesCount);
+    TEST_ASSERT_EQUAL(2, wireTransactionsCount);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sendsFewerBytesThanLegacyPrint);
+    RUN_TEST(test_unchangedScreenSendsNothing);
+    RUN_TEST(test_singleChangedCell);
+    RUN_TEST(test_turnOnRedrawsCurrentScreen);
+    RUN_TEST(test_marqueeIdleForShortText);
+    RUN_TEST(test_marqueeStepsAcrossMillisOverflow);
+    RUN_TEST(test_batchedStreamMatchesUnbatched);
+
+    return UNITY_END();
+}
\ No newline at end of file
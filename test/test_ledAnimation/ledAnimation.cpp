@@ -0,0 +1,75 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <ledAnimation.h>
+
+const LedColor RED = LedColor{ red: 255, green: 0, blue: 0 };
+const LedColor YELLOW = LedColor{ red: 255, green: 255, blue: 0 };
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_solidIsSingleStep() {
+    LedPattern pattern = LedPatterns::solid(RED);
+
+    TEST_ASSERT_EQUAL(1, pattern.keyframesCount);
+    TEST_ASSERT_FALSE(pattern.isLooped);
+    TEST_ASSERT_EQUAL(0, pattern.keyframes[0].fadeMiliseconds);
+    TEST_ASSERT_EQUAL(0, pattern.getDurationMiliseconds());
+}
+
+void test_pulseAndBreathingKeepPeriod() {
+    LedPattern pulse = LedPatterns::pulse(RED, 1000);
+    LedPattern breathing = LedPatterns::breathing(RED, 3001);
+
+    TEST_ASSERT_TRUE(pulse.isLooped);
+    TEST_ASSERT_EQUAL(1000, pulse.getDurationMiliseconds());
+    TEST_ASSERT_EQUAL(255, pulse.keyframes[0].color.red);
+    TEST_ASSERT_EQUAL(0, pulse.keyframes[1].color.red);
+
+    TEST_ASSERT_TRUE(breathing.isLooped);
+    TEST_ASSERT_EQUAL(3001, breathing.getDurationMiliseconds());
+}
+
+void test_colorCycleBlinksEachColor() {
+    const LedColor colors[] = { RED, YELLOW };
+
+    LedPattern pattern = LedPatterns::colorCycle(colors, 2, 1000);
+
+    TEST_ASSERT_TRUE(pattern.isLooped);
+    TEST_ASSERT_EQUAL(4, pattern.keyframesCount);
+    TEST_ASSERT_EQUAL(2000, pattern.getDurationMiliseconds());
+
+    // Color is fully shown for first half, off for second
+    TEST_ASSERT_EQUAL(500, pattern.keyframes[0].fadeMiliseconds + pattern.keyframes[0].holdMiliseconds);
+    TEST_ASSERT_EQUAL(255, pattern.keyframes[2].color.green);
+    TEST_ASSERT_EQUAL(0, pattern.keyframes[3].color.red);
+}
+
+void test_colorCycleIsCappedByKeyframesLimit() {
+    LedColor colors[LED_PATTERN_MAX_KEYFRAMES];
+
+    for (uint8_t i = 0; i < LED_PATTERN_MAX_KEYFRAMES; i++) {
+        colors[i] = RED;
+    }
+
+    LedPattern pattern = LedPatterns::colorCycle(colors, LED_PATTERN_MAX_KEYFRAMES, 1000);
+
+    TEST_ASSERT_EQUAL(LED_PATTERN_MAX_KEYFRAMES, pattern.keyframesCount);
+    TEST_ASSERT_FALSE(pattern.addKeyframe(RED, 0, 0));
+
+    // Ends dark, so looping does not merge two colors
+    TEST_ASSERT_EQUAL(0, pattern.keyframes[LED_PATTERN_MAX_KEYFRAMES - 1].color.red);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_solidIsSingleStep);
+    RUN_TEST(test_pulseAndBreathingKeepPeriod);
+    RUN_TEST(test_colorCycleBlinksEachColor);
+    RUN_TEST(test_colorCycleIsCappedByKeyframesLimit);
+
+    return UNITY_END();
+}
\ No newline at end of file
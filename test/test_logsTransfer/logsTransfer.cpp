@@ -0,0 +1,212 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <logsTransfer.h>
+
+using namespace fakeit;
+
+// Small history ring standing in for logs.cpp
+const uint32_t HISTORY_SIZE = 64;
+LogRecord history[HISTORY_SIZE];
+uint32_t historyNextSequence = 0;
+
+uint32_t getFirstSequence() {
+    return historyNextSequence > HISTORY_SIZE ? historyNextSequence - HISTORY_SIZE : 0;
+}
+
+uint32_t getNextSequence() {
+    return historyNextSequence;
+}
+
+bool readRecord(uint32_t sequence, LogRecord& record) {
+    if (sequence < getFirstSequence() || sequence >= historyNextSequence) {
+        return false;
+    }
+
+    record = history[sequence % HISTORY_SIZE];
+
+    return true;
+}
+
+void addRecords(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        history[historyNextSequence % HISTORY_SIZE] = LogRecord{
+            date: 1700000000 + historyNextSequence * 300,
+            temperature: 21.5,
+            windowOpening: (int16_t) historyNextSequence,
+            deltaTemporaryWindowOpening: 0
+        };
+        historyNextSequence++;
+    }
+}
+
+JsonDocument message;
+
+/**
+ * Parses next message, returns its commandType, "" when there is nothing to send
+ */
+String nextMessage(LogsTransfer& transfer, unsigned long currentMillis) {
+    uint16_t length = transfer.buildNextMessage(currentMillis);
+
+    if (length == 0) {
+        return "";
+    }
+
+    if (length != strlen(transfer.getMessage()) || deserializeJson(message, transfer.getMessage()) != DeserializationError::Ok) {
+        return "INVALID";
+    }
+
+    return message[0]["commandType"].as<String>();
+}
+
+uint32_t chunkOffset() {
+    return message[0]["data"]["offset"];
+}
+
+void setUp() {
+    ArduinoFakeReset();
+
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(unsigned int, int))).AlwaysReturn(0);
+
+    historyNextSequence = 0;
+}
+
+void tearDown() {}
+
+void test_windowWaitsForAcknowledgment() {
+    LogsTransfer transfer(getFirstSequence, getNextSequence, readRecord);
+    addRecords(50);
+
+    TEST_ASSERT_EQUAL(0, transfer.start(0, 0));
+    TEST_ASSERT_EQUAL(50, transfer.getEndOffset());
+
+    for (uint8_t chunk = 0; chunk < LOGS_TRANSFER_WINDOW_CHUNKS; chunk++) {
+        TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 10).c_str());
+        TEST_ASSERT_EQUAL(chunk, message[0]["data"]["seq"].as<uint32_t>());
+        TEST_ASSERT_EQUAL(chunk * LOGS_TRANSFER_RECORDS_PER_CHUNK, chunkOffset());
+        TEST_ASSERT_EQUAL(50, message[0]["data"]["end"].as<uint32_t>());
+        TEST_ASSERT_EQUAL(LOGS_TRANSFER_RECORDS_PER_CHUNK, message[0]["data"]["records"].size());
+    }
+
+    // Window is full
+    TEST_ASSERT_EQUAL_STRING("", nextMessage(transfer, 20).c_str());
+
+    // Acknowledgment slides the window by two chunks
+    transfer.acknowledge(12, 30);
+
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 40).c_str());
+    TEST_ASSERT_EQUAL(24, chunkOffset());
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 40).c_str());
+    TEST_ASSERT_EQUAL(30, chunkOffset());
+    TEST_ASSERT_EQUAL_STRING("", nextMessage(transfer, 40).c_str());
+}
+
+void test_acknowledgmentTimeoutResendsFromLastAcknowledged() {
+    LogsTransfer transfer(getFirstSequence, getNextSequence, readRecord);
+    addRecords(50);
+
+    transfer.start(0, 0);
+
+    while (nextMessage(transfer, 10) != "");
+
+    transfer.acknowledge(6, 100);
+
+    // Acknowledgment beyond what was sent is ignored
+    transfer.acknowledge(48, 200);
+
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 200).c_str());
+    TEST_ASSERT_EQUAL(24, chunkOffset());
+    TEST_ASSERT_EQUAL_STRING("", nextMessage(transfer, 100 + LOGS_TRANSFER_ACK_TIMEOUT_MILISECONDS).c_str());
+
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 101 + LOGS_TRANSFER_ACK_TIMEOUT_MILISECONDS).c_str());
+    TEST_ASSERT_EQUAL(6, chunkOffset());
+}
+
+void test_resumeFromOffset() {
+    LogsTransfer transfer(getFirstSequence, getNextSequence, readRecord);
+    addRecords(100);
+
+    // Records below 36 are already overwritten in the ring
+    TEST_ASSERT_EQUAL(36, transfer.start(0, 0));
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 0).c_str());
+    TEST_ASSERT_EQUAL(36, chunkOffset());
+    TEST_ASSERT_EQUAL(36, message[0]["data"]["records"][0][2].as<int>());
+
+    // Client reconnected and continues where it stopped
+    TEST_ASSERT_EQUAL(90, transfer.start(90, 1000));
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 1000).c_str());
+    TEST_ASSERT_EQUAL(0, message[0]["data"]["seq"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(90, chunkOffset());
+
+    // Offset from the future
+    TEST_ASSERT_EQUAL(100, transfer.start(500, 2000));
+}
+
+void test_finishesWithSummaryAfterEverythingIsAcknowledged() {
+    LogsTransfer transfer(getFirstSequence, getNextSequence, readRecord);
+    addRecords(10);
+
+    transfer.start(0, 0);
+
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 0).c_str());
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 0).c_str());
+    TEST_ASSERT_EQUAL(4, message[0]["data"]["count"].as<uint32_t>());
+
+    // Records added during transfer are not part of it
+    addRecords(5);
+    TEST_ASSERT_EQUAL_STRING("", nextMessage(transfer, 0).c_str());
+
+    transfer.acknowledge(10, 500);
+
+    TEST_ASSERT_EQUAL_STRING("LOGS_TRANSFER_FINISHED", nextMessage(transfer, 500).c_str());
+    TEST_ASSERT_EQUAL(10, message[0]["data"]["records"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(500, message[0]["data"]["durationMiliseconds"].as<uint32_t>());
+    TEST_ASSERT_TRUE(message[0]["data"]["bytes"].as<uint32_t>() > 0);
+
+    TEST_ASSERT_FALSE(transfer.isTransferActive());
+    TEST_ASSERT_EQUAL_STRING("", nextMessage(transfer, 600).c_str());
+}
+
+void test_overwrittenRecordsAreSkippedButCounted() {
+    LogsTransfer transfer(getFirstSequence, getNextSequence, readRecord);
+    addRecords(HISTORY_SIZE);
+
+    transfer.start(0, 0);
+
+    // First 3 records overwritten before their chunk was built
+    addRecords(3);
+
+    TEST_ASSERT_EQUAL_STRING("LOGS_CHUNK", nextMessage(transfer, 0).c_str());
+    TEST_ASSERT_EQUAL(0, chunkOffset());
+    TEST_ASSERT_EQUAL(LOGS_TRANSFER_RECORDS_PER_CHUNK, message[0]["data"]["count"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(LOGS_TRANSFER_RECORDS_PER_CHUNK - 3, message[0]["data"]["records"].size());
+    TEST_ASSERT_EQUAL(3, message[0]["data"]["records"][0][2].as<int>());
+}
+
+void test_cancelStopsTransfer() {
+    LogsTransfer transfer(getFirstSequence, getNextSequence, readRecord);
+    addRecords(20);
+
+    transfer.start(0, 0);
+    transfer.cancel();
+
+    TEST_ASSERT_FALSE(transfer.isTransferActive());
+    TEST_ASSERT_EQUAL_STRING("", nextMessage(transfer, 0).c_str());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_windowWaitsForAcknowledgment);
+    RUN_TEST(test_acknowledgmentTimeoutResendsFromLastAcknowledged);
+    RUN_TEST(test_resumeFromOffset);
+    RUN_TEST(test_finishesWithSummaryAfterEverythingIsAcknowledged);
+    RUN_TEST(test_overwrittenRecordsAreSkippedButCounted);
+    RUN_TEST(test_cancelStopsTransfer);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
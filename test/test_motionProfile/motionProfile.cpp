@@ -0,0 +1,102 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <motionProfile.h>
+
+const float MAX_VELOCITY = 50; // Degrees per second
+const float MAX_ACCELERATION = 100; // Degrees per second squared
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_longMoveIsTrapezoid() {
+    MotionProfile profile;
+
+    // Full ramps cover 25 degrees: 0.5 s ramp up, 1.5 s cruise, 0.5 s ramp down
+    profile.plan(0, 100, MAX_VELOCITY, MAX_ACCELERATION, MotionProfileTrapezoidal);
+
+    TEST_ASSERT_EQUAL(2500, profile.getDurationMiliseconds());
+    TEST_ASSERT_EQUAL_FLOAT(100, profile.getTargetPosition());
+
+    TEST_ASSERT_EQUAL_FLOAT(0, profile.positionAt(0));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 12.5, profile.positionAt(500));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 50, profile.positionAt(1250));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 87.5, profile.positionAt(2000));
+    TEST_ASSERT_EQUAL_FLOAT(100, profile.positionAt(2500));
+    TEST_ASSERT_EQUAL_FLOAT(100, profile.positionAt(5000));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 25, profile.velocityAt(250));
+    TEST_ASSERT_EQUAL_FLOAT(MAX_VELOCITY, profile.velocityAt(1000));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 25, profile.velocityAt(2250));
+    TEST_ASSERT_EQUAL_FLOAT(0, profile.velocityAt(2500));
+}
+
+void test_shortMoveIsTriangle() {
+    MotionProfile profile;
+
+    // 10 degrees is less than full ramps, max velocity is never reached
+    profile.plan(100, 90, MAX_VELOCITY, MAX_ACCELERATION, MotionProfileTrapezoidal);
+
+    float peakVelocity = sqrtf(10 * MAX_ACCELERATION);
+    unsigned long rampMiliseconds = peakVelocity / MAX_ACCELERATION * 1000;
+
+    TEST_ASSERT_EQUAL(633, profile.getDurationMiliseconds());
+    TEST_ASSERT_EQUAL_FLOAT(90, profile.getTargetPosition());
+
+    // No cruise phase, decelerates right after half of the distance
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 95, profile.positionAt(rampMiliseconds));
+    TEST_ASSERT_FLOAT_WITHIN(0.1, peakVelocity, profile.velocityAt(rampMiliseconds));
+    TEST_ASSERT_LESS_THAN(profile.velocityAt(rampMiliseconds), profile.velocityAt(rampMiliseconds + 50));
+    TEST_ASSERT_LESS_THAN(MAX_VELOCITY, profile.velocityAt(rampMiliseconds));
+
+    TEST_ASSERT_EQUAL_FLOAT(90, profile.positionAt(profile.getDurationMiliseconds()));
+}
+
+void test_zeroDistance() {
+    MotionProfile profile;
+
+    profile.plan(30, 30, MAX_VELOCITY, MAX_ACCELERATION, MotionProfileSCurve);
+
+    TEST_ASSERT_EQUAL(0, profile.getDurationMiliseconds());
+    TEST_ASSERT_EQUAL_FLOAT(30, profile.getTargetPosition());
+    TEST_ASSERT_EQUAL_FLOAT(30, profile.positionAt(0));
+    TEST_ASSERT_EQUAL_FLOAT(30, profile.positionAt(1000));
+    TEST_ASSERT_EQUAL_FLOAT(0, profile.velocityAt(0));
+}
+
+void test_sCurveLimitsPeakAcceleration() {
+    MotionProfile profile;
+
+    profile.plan(0, 100, MAX_VELOCITY, MAX_ACCELERATION, MotionProfileSCurve);
+
+    // Average acceleration is half of the peak, ramps take twice as long as trapezoidal ones
+    TEST_ASSERT_EQUAL(3000, profile.getDurationMiliseconds());
+
+    float previousPosition = profile.positionAt(0);
+    float previousVelocity = profile.velocityAt(0);
+
+    for (unsigned long miliseconds = 10; miliseconds <= profile.getDurationMiliseconds(); miliseconds += 10) {
+        float position = profile.positionAt(miliseconds);
+        float velocity = profile.velocityAt(miliseconds);
+
+        TEST_ASSERT_TRUE(position >= previousPosition);
+        TEST_ASSERT_FLOAT_WITHIN(MAX_ACCELERATION * 0.01 + 0.01, previousVelocity, velocity);
+
+        previousPosition = position;
+        previousVelocity = velocity;
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(100, previousPosition);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_longMoveIsTrapezoid);
+    RUN_TEST(test_shortMoveIsTriangle);
+    RUN_TEST(test_zeroDistance);
+    RUN_TEST(test_sCurveLimitsPeakAcceleration);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+
+#include <periodicalTasksQueue.h>
+#include <allocationTracker.h>
+
+using namespace fakeit;
+
+const unsigned long ONE_WEEK_MILISECONDS = 7UL * 24 * 60 * 60 * 1000;
+const unsigned long SIMULATION_STEP_MILISECONDS = 20; // Same as UI tick
+
+// Fake time is passed explicitly, ArduinoFake records every millis() call on heap
+unsigned long simulatedMillis = 0;
+uint32_t fastTaskExecutions = 0;
+uint32_t slowTaskExecutions = 0;
+uint32_t executionOrder[3];
+uint8_t executionsCount = 0;
+
+void fastTask() {
+    fastTaskExecutions++;
+    addPeriodicalTask(fastTask, simulatedMillis + 500);
+}
+
+void slowTask() {
+    slowTaskExecutions++;
+    addPeriodicalTask(slowTask, simulatedMillis + 5 * 60 * 1000);
+}
+
+void firstTask() {
+    executionOrder[executionsCount++] = 1;
+}
+
+void secondTask() {
+    executionOrder[executionsCount++] = 2;
+}
+
+void thirdTask() {
+    executionOrder[executionsCount++] = 3;
+}
+
+void emptyTask() {}
+
+void setUp() {
+    ArduinoFakeReset();
+
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(const char*))).AlwaysReturn(0);
+
+    clearPeriodicalTasksQueue();
+
+    simulatedMillis = 0;
+    fastTaskExecutions = 0;
+    slowTaskExecutions = 0;
+    executionsCount = 0;
+}
+
+void tearDown() {
+    clearPeriodicalTasksQueue();
+}
+
+void test_tasksRunInExecutionTimeOrder() {
+    addPeriodicalTask(thirdTask, 300);
+    addPeriodicalTask(firstTask, 100);
+    addPeriodicalTask(secondTask, 200);
+
+    TEST_ASSERT_EQUAL(100, getMilisecondsUntilNextPeriodicalTask(0));
+
+    checkPeriodicalTasksQueue(50);
+    TEST_ASSERT_EQUAL(0, executionsCount);
+
+    checkPeriodicalTasksQueue(1000);
+    checkPeriodicalTasksQueue(1000);
+    checkPeriodicalTasksQueue(1000);
+
+    TEST_ASSERT_EQUAL(3, executionsCount);
+    TEST_ASSERT_EQUAL(1, executionOrder[0]);
+    TEST_ASSERT_EQUAL(2, executionOrder[1]);
+    TEST_ASSERT_EQUAL(3, executionOrder[2]);
+    TEST_ASSERT_EQUAL(PERIODICAL_TASKS_NO_DEADLINE, getMilisecondsUntilNextPeriodicalTask(1000));
+}
+
+void test_fullQueueDropsTask() {
+    for (uint16_t i = 0; i < PERIODICAL_TASKS_QUEUE_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(addPeriodicalTask(emptyTask, i));
+    }
+
+    TEST_ASSERT_FALSE(addPeriodicalTask(emptyTask, 0));
+}
+
+void test_rescheduledTaskReusesSlotOfFullQueue() {
+    for (uint16_t i = 0; i < PERIODICAL_TASKS_QUEUE_CAPACITY - 1; i++) {
+        addPeriodicalTask(emptyTask, 1000000);
+    }
+
+    addPeriodicalTask(fastTask, 0);
+    checkPeriodicalTasksQueue(0);
+
+    TEST_ASSERT_EQUAL(1, fastTaskExecutions);
+    TEST_ASSERT_EQUAL(500, getMilisecondsUntilNextPeriodicalTask(0));
+}
+
+/**
+ * Covers only the queue itself (tasks are no-ops), firmware steady state still allocates in:
+ * - BackendApp::fetchWeatherForecast / fetchAirPollution (HTTPClient, String response, default JsonDocument, vector<WeatherItem>)
+ * - BluetoothWrapper::handleCommand (vector<String> responses, String commands)
+ */
+void test_queueDoesNotAllocateOverSimulatedWeek() {
+    addPeriodicalTask(fastTask, 0);
+    addPeriodicalTask(slowTask, 0);
+
+    resetAllocationTracking();
+
+    while (simulatedMillis < ONE_WEEK_MILISECONDS) {
+        checkPeriodicalTasksQueue(simulatedMillis);
+        simulatedMillis += SIMULATION_STEP_MILISECONDS;
+    }
+
+    TEST_ASSERT_EQUAL(ONE_WEEK_MILISECONDS / 500, fastTaskExecutions);
+    TEST_ASSERT_EQUAL(ONE_WEEK_MILISECONDS / (5 * 60 * 1000), slowTaskExecutions);
+
+#ifdef ALLOCATION_TRACKING
+    AllocationTotals totals = getAllocationTotals();
+
+    TEST_ASSERT_EQUAL(0, totals.allocationsCount);
+    TEST_ASSERT_EQUAL(0, totals.bytesInFlight);
+#endif
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tasksRunInExecutionTimeOrder);
+    RUN_TEST(test_fullQueueDropsTask);
+    RUN_TEST(test_rescheduledTaskReusesSlotOfFullQueue);
+    RUN_TEST(test_queueDoesNotAllocateOverSimulatedWeek);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file
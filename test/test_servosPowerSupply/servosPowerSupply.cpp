@@ -0,0 +1,167 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoFake.h>
+
+#include <servosPowerSupply.h>
+
+using namespace fakeit;
+
+const byte FAKE_POWER_SUPPLY_GPIO = 5;
+
+unsigned long fakeMillis = 0;
+int fakeGpioState = -1;
+int fakeGpioWritesCount = 0;
+
+void setUp() {
+    ArduinoFakeReset();
+
+    fakeMillis = 0;
+    fakeGpioState = -1;
+    fakeGpioWritesCount = 0;
+
+    When(Method(ArduinoFake(), millis)).AlwaysDo([]() -> unsigned long { return fakeMillis; });
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalWrite)).AlwaysDo([](uint8_t pin, uint8_t value) {
+        fakeGpioState = value;
+        fakeGpioWritesCount++;
+    });
+
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(unsigned int, int))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(const char*))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(double, int))).AlwaysReturn(0);
+}
+
+void tearDown() {}
+
+void test_initializeKeepsPowerOff() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+
+    TEST_ASSERT_EQUAL(HIGH, fakeGpioState);
+    TEST_ASSERT_FALSE(servosPowerSupply.isPoweredOn());
+}
+
+void test_beginMoveReturnsSettleTime() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+
+    fakeMillis = 1000;
+
+    TEST_ASSERT_EQUAL(SERVO_POWER_SUPPLY_SETTLE_DELAY, servosPowerSupply.beginMove());
+    TEST_ASSERT_EQUAL(LOW, fakeGpioState);
+
+    // Re-planned move while power is already settled
+    fakeMillis = 1000 + SERVO_POWER_SUPPLY_SETTLE_DELAY + 50;
+
+    TEST_ASSERT_EQUAL(0, servosPowerSupply.beginMove());
+}
+
+void test_powerIsSwitchedOncePerMove() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+    int writesAfterInitialize = fakeGpioWritesCount;
+
+    servosPowerSupply.beginMove();
+
+    // Every servo pulse during move
+    for (int i = 0; i < 50; i++) {
+        fakeMillis += 20;
+        servosPowerSupply.turnOn();
+        servosPowerSupply.turnOffDelayed();
+    }
+
+    // Hold timer can't drop power in the middle of move
+    servosPowerSupply.handleHoldTimeout();
+    TEST_ASSERT_TRUE(servosPowerSupply.isPoweredOn());
+
+    servosPowerSupply.endMove();
+    TEST_ASSERT_TRUE(servosPowerSupply.isPoweredOn());
+
+    servosPowerSupply.handleHoldTimeout();
+    TEST_ASSERT_FALSE(servosPowerSupply.isPoweredOn());
+    TEST_ASSERT_EQUAL(HIGH, fakeGpioState);
+    TEST_ASSERT_EQUAL(writesAfterInitialize + 2, fakeGpioWritesCount);
+}
+
+void test_statisticsPerMove() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+
+    fakeMillis = 10000;
+    servosPowerSupply.beginMove();
+    fakeMillis = 12000;
+    servosPowerSupply.endMove();
+
+    ServosPowerStatistics statistics = servosPowerSupply.getStatistics();
+    TEST_ASSERT_EQUAL(1, statistics.movesCount);
+    TEST_ASSERT_EQUAL(2000, statistics.lastMoveOnTimeMiliseconds);
+    TEST_ASSERT_TRUE(statistics.lastMoveEnergyJoules > 0);
+
+    // Hold time counts into total on time
+    fakeMillis = 12000 + SERVO_POWER_SUPPLY_DELAY;
+    servosPowerSupply.handleHoldTimeout();
+
+    statistics = servosPowerSupply.getStatistics();
+    TEST_ASSERT_EQUAL(2000 + SERVO_POWER_SUPPLY_DELAY, statistics.totalOnTimeMiliseconds);
+    TEST_ASSERT_TRUE(statistics.totalEnergyJoules > statistics.lastMoveEnergyJoules);
+}
+
+void test_timeSincePowerOff() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+
+    fakeMillis = 10000;
+    servosPowerSupply.beginMove();
+
+    TEST_ASSERT_EQUAL(0, servosPowerSupply.getMilisecondsSincePowerOff());
+
+    servosPowerSupply.endMove();
+    fakeMillis = 15000;
+    servosPowerSupply.handleHoldTimeout();
+    fakeMillis = 18000;
+
+    TEST_ASSERT_EQUAL(3000, servosPowerSupply.getMilisecondsSincePowerOff());
+}
+
+void test_holdTimeoutDuringNextMoveKeepsPower() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+
+    servosPowerSupply.beginMove();
+    fakeMillis = 1000;
+    servosPowerSupply.endMove();
+
+    // Hold timer fires while the next planned move is already starting on the other core
+    fakeMillis = 1000 + SERVO_POWER_SUPPLY_DELAY;
+    TEST_ASSERT_EQUAL(0, servosPowerSupply.beginMove());
+    servosPowerSupply.handleHoldTimeout();
+
+    TEST_ASSERT_TRUE(servosPowerSupply.isPoweredOn());
+    TEST_ASSERT_EQUAL(LOW, fakeGpioState);
+}
+
+void test_deepSleepTurnsPowerOff() {
+    ServosPowerSupply servosPowerSupply(FAKE_POWER_SUPPLY_GPIO);
+    servosPowerSupply.initialize();
+
+    servosPowerSupply.turnOn();
+    servosPowerSupply.holdOffDuringDeepSleep();
+
+    TEST_ASSERT_FALSE(servosPowerSupply.isPoweredOn());
+    TEST_ASSERT_EQUAL(HIGH, fakeGpioState);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_initializeKeepsPowerOff);
+    RUN_TEST(test_beginMoveReturnsSettleTime);
+    RUN_TEST(test_powerIsSwitchedOncePerMove);
+    RUN_TEST(test_statisticsPerMove);
+    RUN_TEST(test_timeSincePowerOff);
+    RUN_TEST(test_holdTimeoutDuringNextMoveKeepsPower);
+    RUN_TEST(test_deepSleepTurnsPowerOff);
+
+    return UNITY_END();
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+
+#include <signalFilters.h>
+
+const uint8_t TRACE_LENGTH = 60;
+
+// Potentiometer held still, decimated ADC values with three spikes
+const uint16_t POTENTIOMETER_STILL_TRACE[TRACE_LENGTH] = {
+    1845, 1834, 1850, 1866, 1828, 1829, 1859, 1831, 1848, 1862, 1828, 1538,
+    1830, 1852, 1851, 1829, 1840, 1830, 1860, 1852, 1828, 1861, 1832, 1839,
+    1865, 1865, 1862, 1828, 1861, 2187, 1839, 1827, 1860, 1833, 1843, 1851,
+    1834, 1859, 1832, 1861, 1844, 1860, 1868, 1836, 1831, 1862, 1861, 1375,
+    1831, 1860, 1870, 1829, 1861, 1828, 1864, 1838, 1856, 1868, 1859, 1852
+};
+
+// Potentiometer turned from ~1000 to ~3000 at sample 20
+const uint16_t POTENTIOMETER_MOVE_TRACE[TRACE_LENGTH] = {
+    1024, 995, 1004, 1012, 1004, 998, 994, 990, 1025, 986, 1019, 1024,
+    990, 980, 1011, 994, 1008, 1006, 996, 1021, 3003, 2993, 3013, 2979,
+    2982, 3007, 3001, 2985, 3023, 2996, 2984, 3006, 3001, 2977, 3017, 2979,
+    3023, 3010, 3011, 3025, 2995, 2996, 3019, 2997, 3013, 3006, 3012, 3004,
+    2979, 2980, 2992, 3005, 3019, 3017, 2979, 2978, 3021, 3019, 2994, 3016
+};
+const uint8_t POTENTIOMETER_MOVE_SAMPLE = 20;
+
+// Resting battery at ~3.92 V, two glitches (servos start, ADC spike)
+const float BATTERY_VOLTAGE_TRACE[TRACE_LENGTH] = {
+    3.893, 3.906, 3.89, 3.931, 3.934, 3.908, 3.937, 3.913, 3.902, 3.905, 3.923, 3.936,
+    3.919, 3.9, 3.94, 3.908, 3.93, 3.71, 3.918, 3.931, 3.897, 3.931, 3.904, 3.864,
+    3.912, 3.902, 3.921, 3.928, 3.937, 3.944, 3.958, 3.923, 3.927, 3.935, 3.935, 3.94,
+    3.906, 3.909, 3.948, 3.948, 4.05, 3.911, 3.919, 3.898, 3.954, 3.884, 3.909, 3.897,
+    3.904, 3.932, 3.9, 3.922, 3.941, 3.974, 3.911, 3.924, 3.913, 3.915, 3.897, 3.91
+};
+const float BATTERY_VOLTAGE = 3.92;
+
+// Room warming up by 0.01 C per sample (10 s interval)
+const float TEMPERATURE_TRACE[TRACE_LENGTH] = {
+    21.13, 20.97, 21.08, 21.06, 20.94, 21.15, 21.19, 21.03, 21.03, 21.1, 20.82, 21.13,
+    21.03, 21.14, 21.24, 21.28, 21.15, 21.06, 21.14, 21.08, 21.27, 21.45, 21.12, 21.35,
+    21.38, 21.16, 21.22, 21.41, 21.44, 21.39, 21.08, 21.28, 21.28, 21.39, 21.23, 21.32,
+    21.27, 21.27, 21.42, 21.23, 21.42, 21.48, 21.27, 21.54, 21.48, 21.56, 21.42, 21.17,
+    21.51, 21.38, 21.55, 21.64, 21.42, 21.68, 21.52, 21.46, 21.6, 21.56, 21.67, 21.66
+};
+
+typedef FilterPipeline<uint16_t, MedianFilter<uint16_t, 3>, EmaFilter<uint16_t>, HysteresisFilter<uint16_t>> PotentiometerFilter;
+
+PotentiometerFilter createPotentiometerFilter() {
+    return PotentiometerFilter(MedianFilter<uint16_t, 3>(), EmaFilter<uint16_t>(0.3), HysteresisFilter<uint16_t>(40, 0, 4095));
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_emaConvergesToStep() {
+    EmaFilter<float> filter(0.5);
+
+    TEST_ASSERT_EQUAL_FLOAT(10, filter.update(10)); // First sample seeds
+    TEST_ASSERT_EQUAL_FLOAT(15, filter.update(20));
+    TEST_ASSERT_EQUAL_FLOAT(17.5, filter.update(20));
+
+    filter.reset();
+
+    TEST_ASSERT_EQUAL_FLOAT(0, filter.update(0));
+}
+
+void test_medianRemovesSingleSpike() {
+    MedianFilter<uint16_t, 3> filter;
+
+    TEST_ASSERT_EQUAL(100, filter.update(100));
+    TEST_ASSERT_EQUAL(102, filter.update(102)); // Upper median until window is full
+    TEST_ASSERT_EQUAL(102, filter.update(4000));
+    TEST_ASSERT_EQUAL(102, filter.update(101));
+    TEST_ASSERT_EQUAL(101, filter.update(99));
+}
+
+void test_hysteresisHoldsWithinBand() {
+    HysteresisFilter<uint16_t> filter(10);
+
+    TEST_ASSERT_EQUAL(500, filter.update(500));
+    TEST_ASSERT_EQUAL(500, filter.update(510));
+    TEST_ASSERT_EQUAL(500, filter.update(490)); // Unsigned values below output
+    TEST_ASSERT_EQUAL(511, filter.update(511));
+    TEST_ASSERT_EQUAL(480, filter.update(480));
+}
+
+void test_hysteresisSnapsToRails() {
+    HysteresisFilter<uint16_t> filter(10, 0, 4095);
+
+    TEST_ASSERT_EQUAL(4000, filter.update(4000));
+    TEST_ASSERT_EQUAL(4000, filter.update(4009));
+    TEST_ASSERT_EQUAL(4095, filter.update(4090));
+    TEST_ASSERT_EQUAL(4095, filter.update(4086)); // Leaves the rail only as far as threshold
+    TEST_ASSERT_EQUAL(4084, filter.update(4084));
+    TEST_ASSERT_EQUAL(0, filter.update(5));
+}
+
+void test_potentiometerSweepReachesBothEnds() {
+    PotentiometerFilter filter = createPotentiometerFilter();
+    uint16_t output = 0;
+
+    for (uint16_t value = 2000; value < 4095; value += 35) {
+        filter.update(value);
+    }
+
+    for (uint8_t i = 0; i < 20; i++) {
+        output = filter.update(4095);
+    }
+
+    TEST_ASSERT_EQUAL(4095, output);
+    TEST_ASSERT_EQUAL(100, output * 100 / 4095); // Same as translateAnalogTo100Range
+
+    for (int16_t value = 4095; value > 0; value -= 35) {
+        filter.update(value);
+    }
+
+    for (uint8_t i = 0; i < 20; i++) {
+        output = filter.update(0);
+    }
+
+    TEST_ASSERT_EQUAL(0, output);
+}
+
+void test_potentiometerStillIsStable() {
+    PotentiometerFilter filter = createPotentiometerFilter();
+
+    uint16_t firstOutput = filter.update(POTENTIOMETER_STILL_TRACE[0]);
+    uint8_t changesCount = 0;
+    uint16_t previousOutput = firstOutput;
+
+    for (uint8_t i = 1; i < TRACE_LENGTH; i++) {
+        uint16_t output = filter.update(POTENTIOMETER_STILL_TRACE[i]);
+
+        if (output != previousOutput) {
+            changesCount++;
+        }
+
+        previousOutput = output;
+    }
+
+    TEST_ASSERT_EQUAL(0, changesCount);
+    TEST_ASSERT_UINT16_WITHIN(30, 1848, firstOutput);
+}
+
+void test_potentiometerFollowsMove() {
+    PotentiometerFilter filter = createPotentiometerFilter();
+    uint8_t settledSample = 0;
+
+    for (uint8_t i = 0; i < TRACE_LENGTH; i++) {
+        uint16_t output = filter.update(POTENTIOMETER_MOVE_TRACE[i]);
+
+        if (settledSample == 0 && abs(output - 3000) <= 60) {
+            settledSample = i;
+        }
+    }
+
+    char message[48];
+    sprintf(message, "Settled after %d samples", settledSample - POTENTIOMETER_MOVE_SAMPLE);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_GREATER_THAN(POTENTIOMETER_MOVE_SAMPLE, settledSample);
+    TEST_ASSERT_LESS_OR_EQUAL(POTENTIOMETER_MOVE_SAMPLE + 12, settledSample);
+}
+
+void test_batteryVoltageIgnoresGlitches() {
+    FilterPipeline<float, MedianFilter<float, 3>, KalmanFilter<float>> filter(MedianFilter<float, 3>(), KalmanFilter<float>(0.00001, 0.0004));
+
+    float maxRawError = 0;
+    float maxFilteredError = 0;
+
+    for (uint8_t i = 0; i < TRACE_LENGTH; i++) {
+        float output = filter.update(BATTERY_VOLTAGE_TRACE[i]);
+
+        maxRawError = std::max(maxRawError, fabsf(BATTERY_VOLTAGE_TRACE[i] - BATTERY_VOLTAGE));
+
+        // Skipping convergence from first sample
+        if (i >= 10) {
+            maxFilteredError = std::max(maxFilteredError, fabsf(output - BATTERY_VOLTAGE));
+        }
+    }
+
+    char message[64];
+    sprintf(message, "Max error raw: %.3f V, filtered: %.3f V", maxRawError, maxFilteredError);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_THAN(0.02, maxFilteredError);
+    TEST_ASSERT_GREATER_THAN(0.2, maxRawError);
+}
+
+void test_temperatureKalmanReducesNoise() {
+    KalmanFilter<float> filter(0.001, 0.01);
+
+    float rawSquaredError = 0;
+    float filteredSquaredError = 0;
+
+    for (uint8_t i = 0; i < TRACE_LENGTH; i++) {
+        float expected = 21.0 + 0.01 * i;
+        float output = filter.update(TEMPERATURE_TRACE[i]);
+
+        rawSquaredError += powf(TEMPERATURE_TRACE[i] - expected, 2);
+        filteredSquaredError += powf(output - expected, 2);
+    }
+
+    float rawRms = sqrtf(rawSquaredError / TRACE_LENGTH);
+    float filteredRms = sqrtf(filteredSquaredError / TRACE_LENGTH);
+
+    char message[64];
+    sprintf(message, "RMS error raw: %.3f C, filtered: %.3f C", rawRms, filteredRms);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_THAN(rawRms * 0.75, filteredRms);
+    TEST_ASSERT_LESS_THAN(0.01, filter.getErrorCovariance());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_emaConvergesToStep);
+    RUN_TEST(test_medianRemovesSingleSpike);
+    RUN_TEST(test_hysteresisHoldsWithinBand);
+    RUN_TEST(test_hysteresisSnapsToRails);
+    RUN_TEST(test_potentiometerSweepReachesBothEnds);
+    RUN_TEST(test_potentiometerStillIsStable);
+    RUN_TEST(test_potentiometerFollowsMove);
+    RUN_TEST(test_batteryVoltageIgnoresGlitches);
+    RUN_TEST(test_temperatureKalmanReducesNoise);
+    UNITY_END();
+
+    return 0;
+}
\ No newline at end of file